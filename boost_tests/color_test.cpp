@@ -18,6 +18,7 @@
 
 #include <boost/test/unit_test.hpp>
 #include <string>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <set>
@@ -571,3 +572,85 @@ BOOST_AUTO_TEST_CASE(TokenRingAll2, * utf::timeout(2)) {
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(ParallelUnfolding, * utf::timeout(100)) {
+    // the parallel unfolder must produce the same net, down to names and indices
+    auto unfolded = [](const std::string& model, bool partition, bool cfp, uint32_t threads) {
+        shared_string_set sset;
+        ColoredPetriNetBuilder cpnBuilder(sset);
+        auto f = loadFile(model.c_str());
+        cpnBuilder.parse_model(f);
+        auto [builder, trans_names, place_names] = unfold(cpnBuilder, partition, partition, cfp, std::cerr,
+            10, 100, 10, 10, false, false, threads);
+        std::vector<std::pair<std::string, uint32_t>> places, transitions;
+        for (auto& [name, id] : builder.getPlaceNames()) places.emplace_back(*name, id);
+        for (auto& [name, id] : builder.getTransitionNames()) transitions.emplace_back(*name, id);
+        std::sort(places.begin(), places.end());
+        std::sort(transitions.begin(), transitions.end());
+        std::vector<MarkVal> marking(builder.initMarking(), builder.initMarking() + builder.numberOfPlaces());
+        std::unique_ptr<PetriNet> pn{builder.makePetriNet(false)};
+        std::vector<uint32_t> arcs;
+        for (uint32_t t = 0; t < pn->numberOfTransitions(); ++t) {
+            for (auto [it, end] = pn->preset(t); it != end; ++it) {
+                arcs.insert(arcs.end(), {t, it->place, it->tokens, it->inhibitor});
+            }
+            for (auto [it, end] = pn->postset(t); it != end; ++it) {
+                arcs.insert(arcs.end(), {t, it->place, it->tokens});
+            }
+        }
+        return std::make_tuple(places, transitions, marking, arcs);
+    };
+
+    for (auto model : {"/models/Peterson-COL-2/model.pnml", "/models/PhilosophersDyn-COL-03/model.pnml"}) {
+        for (auto partition : {false, true}) {
+            for (auto cfp : {false, true}) {
+                std::cerr << "\t" << model << std::boolalpha << " partition=" << partition << " cfp=" << cfp << std::endl;
+                auto sequential = unfolded(model, partition, cfp, 1);
+                auto parallel = unfolded(model, partition, cfp, 4);
+                BOOST_REQUIRE(std::get<0>(sequential) == std::get<0>(parallel));
+                BOOST_REQUIRE(std::get<1>(sequential) == std::get<1>(parallel));
+                BOOST_REQUIRE(std::get<2>(sequential) == std::get<2>(parallel));
+                BOOST_REQUIRE(std::get<3>(sequential) == std::get<3>(parallel));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(StreamedUnfolding, * utf::timeout(100)) {
+    // unfolding straight into the compact net must write the same net as the builder
+    auto read = [](const std::string& path) {
+        std::ifstream in(path);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    };
+    const std::string built = (std::filesystem::temp_directory_path() / "unfolded_built.pnml").string();
+    const std::string streamed = (std::filesystem::temp_directory_path() / "unfolded_streamed.pnml").string();
+
+    for (auto model : {"/models/Peterson-COL-2/model.pnml", "/models/PhilosophersDyn-COL-03/model.pnml"}) {
+        for (auto partition : {false, true}) {
+            for (uint32_t threads : {1, 4}) {
+                std::cerr << "\t" << model << std::boolalpha << " partition=" << partition << " threads=" << threads << std::endl;
+                {
+                    shared_string_set sset;
+                    ColoredPetriNetBuilder cpnBuilder(sset);
+                    auto f = loadFile(model);
+                    cpnBuilder.parse_model(f);
+                    auto [builder, trans_names, place_names] = unfold(cpnBuilder, partition, partition, true, std::cerr,
+                        10, 100, 10, 10, false, false, threads);
+                    builder.sort();
+                    outputNet(builder, built);
+                }
+                {
+                    shared_string_set sset;
+                    ColoredPetriNetBuilder cpnBuilder(sset);
+                    auto f = loadFile(model);
+                    cpnBuilder.parse_model(f);
+                    outputUnfoldedNet(cpnBuilder, partition, partition, true, std::cerr,
+                        10, 100, 10, 10, false, threads, streamed);
+                }
+                BOOST_REQUIRE(read(built) == read(streamed));
+            }
+        }
+    }
+}
@@ -85,6 +85,53 @@ BOOST_AUTO_TEST_CASE(AngiogenesisPT01LTLCardinality, * utf::timeout(300)) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01LTLCardinalityParallel, * utf::timeout(300)) {
+
+    const std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    const std::vector<Reachability::ResultPrinter::Result> expected{
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::Satisfied,
+        ResultPrinter::Satisfied,
+        ResultPrinter::Satisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied,
+        ResultPrinter::NotSatisfied};
+
+    auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/LTLCardinality.xml", qnums, TemporalLogic::LTL);
+
+    for (auto i : qnums) {
+        for (bool trace :{false, true}) {
+            for(auto alg : { LTL::Algorithm::NDFS, LTL::Algorithm::Tarjan})
+            {
+                for(auto por : { LTL::LTLPartialOrder::None, LTL::LTLPartialOrder::Automaton})
+                {
+                    if(alg == LTL::Algorithm::NDFS && por != LTL::LTLPartialOrder::None)
+                        continue;
+                    for(uint32_t threads : {2, 4})
+                    {
+                        std::cerr << "Q[" << i << "] trace=" << std::boolalpha << trace
+                            << " por=" << to_underlying(por) << " alg=" << to_underlying(alg) << " threads=" << threads << std::endl;
+                        LTL::LTLSearch search(*pn, conditions[i], LTL::BuchiOptimization::Low, LTL::APCompression::None);
+                        auto r = search.solve(trace, 0, alg, por, Strategy::HEUR, LTL::LTLHeuristic::Automaton, true, 0, threads);
+                        auto result = r ? ResultPrinter::Satisfied : ResultPrinter::NotSatisfied;
+                        BOOST_REQUIRE_EQUAL(expected[i], result);
+                    }
+                }
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(AngiogenesisPT01LTLFireability, * utf::timeout(300)) {
 
     const std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
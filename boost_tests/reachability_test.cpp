@@ -20,8 +20,19 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <deque>
+#include <algorithm>
+#include <random>
+#include <thread>
 
 #include "utils.h"
+#include "PetriEngine/Stubborn/ReachabilityStubbornSet.h"
+#include "PetriEngine/PQL/CompiledCondition.h"
+#include "PetriEngine/PQL/Evaluation.h"
+#include "PetriEngine/ArcKernels.h"
+#include "PetriEngine/Portfolio.h"
+#include "PetriEngine/Structures/BucketQueue.h"
+#include "PetriEngine/Structures/ConcurrentStateSet.h"
 
 using namespace PetriEngine;
 using namespace PetriEngine::Colored;
@@ -114,3 +125,545 @@ BOOST_AUTO_TEST_CASE(AngiogenesisPT01ReachabilityFireability, * utf::timeout(60)
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01ReachabilityCardinalityParallel, * utf::timeout(60)) {
+
+    std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    std::vector<Reachability::ResultPrinter::Result> expected{
+        Reachability::ResultPrinter::Satisfied,
+        Reachability::ResultPrinter::Satisfied,
+        Reachability::ResultPrinter::Satisfied,
+        Reachability::ResultPrinter::NotSatisfied,
+        Reachability::ResultPrinter::NotSatisfied,
+        Reachability::ResultPrinter::NotSatisfied,
+        Reachability::ResultPrinter::NotSatisfied,
+        Reachability::ResultPrinter::Satisfied,
+        Reachability::ResultPrinter::NotSatisfied,
+        Reachability::ResultPrinter::Satisfied,
+        Reachability::ResultPrinter::NotSatisfied,
+        Reachability::ResultPrinter::NotSatisfied,
+        Reachability::ResultPrinter::Satisfied,
+        Reachability::ResultPrinter::NotSatisfied,
+        Reachability::ResultPrinter::NotSatisfied,
+        Reachability::ResultPrinter::NotSatisfied};
+
+    auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", qnums);
+
+    ResultHandler handler;
+
+    for (auto i : qnums) {
+        for (auto search :{Strategy::BFS, Strategy::DFS, Strategy::HEUR, Strategy::RDFS}) {
+            for (uint32_t threads :{2, 4}) {
+                auto c2 = prepareForReachability(conditions[i]);
+                ReachabilitySearch strategy(*pn, handler, 0, false, threads);
+                std::vector<Condition_ptr> vec{c2};
+                std::vector<Reachability::ResultPrinter::Result> results{Reachability::ResultPrinter::Unknown};
+                strategy.reachable(vec, results, search, false, false, StatisticsLevel::None, false, 0);
+                BOOST_REQUIRE_EQUAL(expected[i], results[0]);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01RandomWalkParallel, * utf::timeout(60)) {
+
+    std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    std::set<size_t> satisfied{0, 1, 2, 7, 9, 12};
+
+    auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", qnums);
+
+    ResultHandler handler;
+
+    // a walk only terminates when it finds a witness, so only run the queries which have one
+    for (auto i : qnums) {
+        auto c2 = prepareForReachability(conditions[i]);
+        if (c2->isInvariant() == (satisfied.count(i) > 0))
+            continue;
+        for (uint32_t threads :{2, 4}) {
+            ReachabilitySearch strategy(*pn, handler, 0, false, threads);
+            std::vector<Condition_ptr> vec{c2};
+            std::vector<Reachability::ResultPrinter::Result> results{Reachability::ResultPrinter::Unknown};
+            strategy.reachable(vec, results, Strategy::RandomWalk, false, false, StatisticsLevel::None, false, 0, 1000, 100);
+            BOOST_REQUIRE_EQUAL(satisfied.count(i) ? Reachability::ResultPrinter::Satisfied
+                                                   : Reachability::ResultPrinter::NotSatisfied, results[0]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(BucketQueueMatchesHeap) {
+    struct weighted_t {
+        uint32_t weight;
+        size_t item;
+        bool operator<(const weighted_t& y) const {
+            if (weight == y.weight) return item < y.item;
+            return weight > y.weight;
+        }
+    };
+
+    std::default_random_engine rng(42);
+    Structures::BucketQueue<size_t> queue;
+    std::priority_queue<weighted_t> heap;
+    size_t id = 0;
+    for (size_t step = 0; step < 100000 || !heap.empty(); ++step) {
+        if (step < 100000 && (heap.empty() || rng() % 3 != 0)) {
+            // some weights are beyond the buckets
+            uint32_t weight = rng() % 10 == 0 ? Structures::BucketQueue<size_t>::MAX_BUCKETS + rng() % 100 : rng() % 100;
+            queue.push(weight, id);
+            heap.push({weight, id++});
+        } else {
+            auto [weight, item] = queue.pop();
+            BOOST_REQUIRE_EQUAL(heap.top().weight, weight);
+            BOOST_REQUIRE_EQUAL(heap.top().item, item);
+            heap.pop();
+        }
+        BOOST_REQUIRE_EQUAL(heap.size(), queue.size());
+    }
+    BOOST_REQUIRE(queue.empty());
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01Portfolio, * utf::timeout(60)) {
+
+    std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    std::set<size_t> satisfied{0, 1, 2, 7, 9, 12};
+
+    auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", qnums);
+
+    ResultHandler handler;
+    std::vector<Condition_ptr> queries;
+    for (auto i : qnums)
+        queries.push_back(prepareForReachability(conditions[i]));
+
+    // the random walk never gives up on the unreachable properties, so this also checks that it is stopped
+    options_t options;
+    options.printstatistics = StatisticsLevel::None;
+    options.portfolio = {PortfolioEngine::HEUR, PortfolioEngine::RDFS, PortfolioEngine::RandomWalk,
+                         PortfolioEngine::TAR, PortfolioEngine::LP};
+    std::vector<Reachability::ResultPrinter::Result> results(queries.size(), Reachability::ResultPrinter::Unknown);
+    Portfolio portfolio(*pn, handler, options, nullptr);
+    BOOST_REQUIRE(portfolio.solve(queries, results));
+    for (auto i : qnums)
+        BOOST_REQUIRE_EQUAL(satisfied.count(i) ? Reachability::ResultPrinter::Satisfied
+                                               : Reachability::ResultPrinter::NotSatisfied, results[i]);
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01ReachabilityCardinalityCached, * utf::timeout(60)) {
+
+    std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    std::vector<Reachability::ResultPrinter::Result> expected{
+        Reachability::ResultPrinter::Satisfied,
+        Reachability::ResultPrinter::Satisfied,
+        Reachability::ResultPrinter::Satisfied,
+        Reachability::ResultPrinter::NotSatisfied,
+        Reachability::ResultPrinter::NotSatisfied,
+        Reachability::ResultPrinter::NotSatisfied,
+        Reachability::ResultPrinter::NotSatisfied,
+        Reachability::ResultPrinter::Satisfied,
+        Reachability::ResultPrinter::NotSatisfied,
+        Reachability::ResultPrinter::Satisfied,
+        Reachability::ResultPrinter::NotSatisfied,
+        Reachability::ResultPrinter::NotSatisfied,
+        Reachability::ResultPrinter::Satisfied,
+        Reachability::ResultPrinter::NotSatisfied,
+        Reachability::ResultPrinter::NotSatisfied,
+        Reachability::ResultPrinter::NotSatisfied};
+
+    auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", qnums);
+
+    ResultHandler handler;
+    StateSpaceCache cache(*pn, 0);
+
+    for (auto i : qnums) {
+        for (bool stub :{true, false}) {
+            auto c2 = prepareForReachability(conditions[i]);
+            ReachabilitySearch strategy(*pn, handler, 0);
+            strategy.setStateSpaceCache(&cache);
+            std::vector<Condition_ptr> vec{c2};
+            std::vector<Reachability::ResultPrinter::Result> results{Reachability::ResultPrinter::Unknown};
+            strategy.reachable(vec, results, Strategy::HEUR, stub, false, StatisticsLevel::None, false, 0);
+            BOOST_REQUIRE_EQUAL(expected[i], results[0]);
+            BOOST_REQUIRE(cache.complete());
+        }
+    }
+
+    // every stored edge is an enabled transition of its source
+    Structures::State state, next;
+    state.setMarking(pn->makeInitialMarking());
+    next.setMarking(pn->makeInitialMarking());
+    for (size_t id = 0; id < cache.size(); ++id) {
+        cache.decode(state, id);
+        auto succs = cache.successors(id);
+        auto fired = cache.transitions(id);
+        for (auto it = succs.first; it != succs.second; ++it, ++fired) {
+            BOOST_REQUIRE(pn->fireable(state.marking(), *fired));
+            cache.decode(next, *it);
+            BOOST_REQUIRE_EQUAL(*it, cache.lookup(next).second);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01ReachabilityCardinalityLossy, * utf::timeout(60)) {
+
+    std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    std::set<size_t> satisfied{0, 1, 2, 7, 9, 12};
+
+    auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", qnums);
+
+    ResultHandler handler;
+
+    // reachable markings are still found, but an exhausted search proves nothing
+    for (auto i : qnums) {
+        for (auto storage :{StateStorage::HashCompaction, StateStorage::Bitstate}) {
+            auto c2 = prepareForReachability(conditions[i]);
+            ReachabilitySearch strategy(*pn, handler, 0);
+            strategy.setStateStorage(storage, 20);
+            std::vector<Condition_ptr> vec{c2};
+            std::vector<Reachability::ResultPrinter::Result> results{Reachability::ResultPrinter::Unknown};
+            strategy.reachable(vec, results, Strategy::BFS, false, false, StatisticsLevel::None, false, 0);
+            BOOST_REQUIRE_EQUAL(satisfied.count(i) ? Reachability::ResultPrinter::Satisfied
+                                                   : Reachability::ResultPrinter::Unknown, results[0]);
+        }
+    }
+
+    // without collisions the lossy set sees exactly the markings of the exact one,
+    // whichever order the waiting markings are decoded in
+    for (bool dfs : {false, true}) {
+        Structures::StateSet exact(*pn, 0);
+        Structures::LossyStateSet lossy(*pn, 0, 0);
+        SuccessorGenerator generator(*pn);
+        Structures::State state, working;
+        state.setMarking(pn->makeInitialMarking());
+        working.setMarking(pn->makeInitialMarking());
+        BOOST_REQUIRE(exact.add(state).first);
+        std::deque<size_t> waiting{lossy.add(state).second};
+        while (!waiting.empty()) {
+            lossy.decode(state, dfs ? waiting.back() : waiting.front());
+            if (dfs) waiting.pop_back();
+            else waiting.pop_front();
+            BOOST_REQUIRE(exact.lookup(state).first);
+            generator.prepare(&state);
+            while (generator.next(working)) {
+                auto res = lossy.add(working);
+                BOOST_REQUIRE_EQUAL(exact.add(working).first, res.first);
+                if (res.first) waiting.push_back(res.second);
+            }
+        }
+        BOOST_REQUIRE_EQUAL(exact.size(), lossy.size());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01ReachabilityCardinalityDisk, * utf::timeout(60)) {
+
+    std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    std::set<size_t> satisfied{0, 1, 2, 7, 9, 12};
+
+    auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", qnums);
+
+    ResultHandler handler;
+
+    // a small buffer makes every layer spill several runs
+    for (auto i : qnums) {
+        for (bool stub :{true, false}) {
+            auto c2 = prepareForReachability(conditions[i]);
+            ReachabilitySearch strategy(*pn, handler, 0);
+            strategy.setStateStorage(StateStorage::Disk);
+            strategy.setDiskStorage("", 256);
+            std::vector<Condition_ptr> vec{c2};
+            std::vector<Reachability::ResultPrinter::Result> results{Reachability::ResultPrinter::Unknown};
+            strategy.reachable(vec, results, Strategy::HEUR, stub, false, StatisticsLevel::None, false, 0);
+            BOOST_REQUIRE_EQUAL(satisfied.count(i) ? Reachability::ResultPrinter::Satisfied
+                                                   : Reachability::ResultPrinter::NotSatisfied, results[0]);
+        }
+    }
+
+    // the layers together hold exactly the reachable markings; a one byte
+    // buffer writes a run per marking, so the runs are merged in several passes
+    for (size_t buffer : {256, 1}) {
+        Structures::StateSet exact(*pn, 0);
+        Structures::DiskStateSet disk(*pn, 0, "", buffer);
+        SuccessorGenerator generator(*pn);
+        Structures::State state, working;
+        state.setMarking(pn->makeInitialMarking());
+        working.setMarking(pn->makeInitialMarking());
+        exact.add(state);
+        disk.add(state);
+        for (auto fresh = disk.nextLayer(); fresh != 0; fresh = disk.nextLayer()) {
+            while (disk.next(state)) {
+                generator.prepare(&state);
+                while (generator.next(working)) {
+                    exact.add(working);
+                    disk.add(working);
+                }
+            }
+        }
+        BOOST_REQUIRE_EQUAL(exact.size(), disk.size());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01ConcurrentStateSet, * utf::timeout(60)) {
+
+    std::set<size_t> qnums{0};
+    auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", qnums);
+
+    // collect the reachable markings sequentially
+    std::vector<std::vector<MarkVal>> markings;
+    {
+        Structures::StateSet states(*pn, 0);
+        SuccessorGenerator generator(*pn);
+        Structures::State state, working;
+        state.setMarking(pn->makeInitialMarking());
+        working.setMarking(pn->makeInitialMarking());
+        std::deque<size_t> waiting{states.add(state).second};
+        while (!waiting.empty()) {
+            states.decode(state, waiting.front());
+            waiting.pop_front();
+            markings.emplace_back(state.marking(), state.marking() + pn->numberOfPlaces());
+            generator.prepare(&state);
+            while (generator.next(working)) {
+                auto res = states.add(working);
+                if (res.first) waiting.push_back(res.second);
+            }
+        }
+    }
+    BOOST_REQUIRE_GT(markings.size(), 1);
+
+    // every thread inserts all but a quarter of the markings in its own order,
+    // so each marking is raced for by three threads
+    constexpr uint32_t threads = 4;
+    Structures::ConcurrentStateSet states(*pn, 0, threads);
+    std::vector<std::vector<std::pair<size_t, size_t>>> inserted(threads);
+    std::vector<size_t> fresh(threads, 0);
+    std::vector<std::thread> workers;
+    for (uint32_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::vector<size_t> order;
+            for (size_t i = 0; i < markings.size(); ++i)
+                if (i % threads != t) order.push_back(i);
+            std::shuffle(order.begin(), order.end(), std::default_random_engine(t));
+            Structures::State state, decoded;
+            state.setMarking(pn->makeInitialMarking());
+            decoded.setMarking(pn->makeInitialMarking());
+            for (auto i : order) {
+                state.copy(markings[i].data(), markings[i].size());
+                auto res = states.add(state);
+                if (res.first) ++fresh[t];
+                inserted[t].emplace_back(i, res.second);
+                states.decode(decoded, res.second);
+                // stopping early leaves the thread short, which the size checks below catch
+                if (!std::equal(markings[i].begin(), markings[i].end(), decoded.marking()))
+                    return;
+            }
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+
+    BOOST_REQUIRE_EQUAL(markings.size(), states.size());
+    size_t total = 0;
+    for (auto f : fresh) total += f;
+    BOOST_REQUIRE_EQUAL(markings.size(), total);
+
+    // every id decodes to the marking it was returned for, and all threads agree on it
+    std::vector<size_t> ids(markings.size(), std::numeric_limits<size_t>::max());
+    Structures::State decoded;
+    decoded.setMarking(pn->makeInitialMarking());
+    for (uint32_t t = 0; t < threads; ++t) {
+        BOOST_REQUIRE_EQUAL(markings.size() - (markings.size() + threads - 1 - t) / threads, inserted[t].size());
+        for (auto [i, id] : inserted[t]) {
+            if (ids[i] == std::numeric_limits<size_t>::max())
+                ids[i] = id;
+            BOOST_REQUIRE_EQUAL(ids[i], id);
+            states.decode(decoded, id);
+            BOOST_REQUIRE(std::equal(markings[i].begin(), markings[i].end(), decoded.marking()));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01IncrementalSuccessors, * utf::timeout(60)) {
+
+    std::set<size_t> qnums{0};
+    auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", qnums);
+
+    // the incremental generator must fire the same transitions in the same order
+    // as the place-wise scan, in both search orders
+    for (bool dfs : {true, false}) {
+        SuccessorGenerator plain(*pn);
+        SuccessorGenerator incremental(*pn);
+        incremental.setIncremental(true);
+        Structures::StateSet states(*pn, 0);
+        Structures::State state, working;
+        state.setMarking(pn->makeInitialMarking());
+        working.setMarking(pn->makeInitialMarking());
+        std::deque<size_t> waiting{states.add(state).second};
+        while (!waiting.empty()) {
+            auto id = dfs ? waiting.back() : waiting.front();
+            if (dfs) waiting.pop_back();
+            else waiting.pop_front();
+            states.decode(state, id);
+            plain.prepare(&state);
+            incremental.expanding(id);
+            incremental.prepare(&state);
+            std::vector<uint32_t> expected, fired;
+            while (plain.next(working)) {
+                expected.push_back(plain.fired());
+            }
+            while (incremental.next(working)) {
+                fired.push_back(incremental.fired());
+                auto res = states.add(working);
+                if (res.first) {
+                    incremental.stored(res.second);
+                    waiting.push_back(res.second);
+                }
+            }
+            BOOST_REQUIRE(expected == fired);
+        }
+        BOOST_REQUIRE_GT(states.size(), 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01SparseStubbornReset, * utf::timeout(60)) {
+
+    std::set<size_t> qnums{0};
+    auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", qnums);
+    std::vector<PQL::Condition_ptr> queries{prepareForReachability(conditions[0])};
+
+    // a stubborn set reused across states must agree with one computed from scratch
+    ReachabilityStubbornSet reused(*pn, queries);
+    Structures::StateSet states(*pn, 0);
+    Structures::State state, working;
+    state.setMarking(pn->makeInitialMarking());
+    working.setMarking(pn->makeInitialMarking());
+    SuccessorGenerator generator(*pn);
+    std::deque<size_t> waiting{states.add(state).second};
+    while (!waiting.empty()) {
+        auto id = waiting.back();
+        waiting.pop_back();
+        states.decode(state, id);
+        ReachabilityStubbornSet fresh(*pn, queries);
+        BOOST_REQUIRE_EQUAL(fresh.prepare(&state), reused.prepare(&state));
+        BOOST_REQUIRE(std::equal(fresh.stubborn(), fresh.stubborn() + pn->numberOfTransitions(), reused.stubborn()));
+        BOOST_REQUIRE(std::equal(fresh.enabled(), fresh.enabled() + pn->numberOfTransitions(), reused.enabled()));
+        generator.prepare(&state);
+        while (generator.next(working)) {
+            auto res = states.add(working);
+            if (res.first) waiting.push_back(res.second);
+        }
+    }
+    BOOST_REQUIRE_GT(states.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01CompiledQueries, * utf::timeout(60)) {
+
+    std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", qnums);
+
+    std::vector<PQL::Condition_ptr> queries;
+    std::vector<PQL::CompiledCondition> compiled;
+    for (auto& c : conditions) {
+        queries.push_back(prepareForReachability(c));
+        compiled.emplace_back(queries.back(), pn.get());
+        BOOST_REQUIRE(compiled.back().compiled());
+    }
+
+    // the compiled queries must agree with the tree on every reachable marking
+    Structures::StateSet states(*pn, 0);
+    Structures::State state, working;
+    state.setMarking(pn->makeInitialMarking());
+    working.setMarking(pn->makeInitialMarking());
+    SuccessorGenerator generator(*pn);
+    std::deque<size_t> waiting{states.add(state).second};
+    while (!waiting.empty()) {
+        auto id = waiting.front();
+        waiting.pop_front();
+        states.decode(state, id);
+        for (size_t i = 0; i < queries.size(); ++i) {
+            EvaluationContext ec(state.marking(), pn.get());
+            BOOST_REQUIRE_EQUAL(PQL::evaluate(queries[i].get(), ec), compiled[i].evaluate(state.marking()));
+            for (bool negated : {false, true}) {
+                PQL::DistanceContext tree(pn.get(), state.marking());
+                PQL::DistanceContext flat(pn.get(), state.marking(), &compiled[i]);
+                if (negated) {
+                    tree.negate();
+                    flat.negate();
+                }
+                BOOST_REQUIRE_EQUAL(queries[i]->distance(tree), flat.distance(queries[i].get()));
+            }
+        }
+        generator.prepare(&state);
+        while (generator.next(working)) {
+            auto res = states.add(working);
+            if (res.first) waiting.push_back(res.second);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AngiogenesisPT01IncrementalDistance, * utf::timeout(60)) {
+
+    std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    auto [pn, conditions, qstrings] = load_pn("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", qnums);
+
+    std::vector<PQL::Condition_ptr> queries;
+    std::vector<PQL::CompiledCondition> compiled;
+    for (auto& c : conditions) {
+        queries.push_back(prepareForReachability(c));
+        compiled.emplace_back(queries.back(), pn.get());
+        compiled.back().prepareIncremental();
+        BOOST_REQUIRE(compiled.back().incremental());
+    }
+
+    // the distance updated from the parent must be the one computed from scratch
+    Structures::StateSet states(*pn, 0);
+    Structures::State state, working;
+    state.setMarking(pn->makeInitialMarking());
+    working.setMarking(pn->makeInitialMarking());
+    SuccessorGenerator generator(*pn);
+    std::vector<PQL::DistanceCache> caches(queries.size());
+    std::deque<size_t> waiting{states.add(state).second};
+    while (!waiting.empty()) {
+        auto id = waiting.front();
+        waiting.pop_front();
+        states.decode(state, id);
+        for (size_t i = 0; i < queries.size(); ++i)
+            compiled[i].cache(state.marking(), caches[i]);
+        generator.prepare(&state);
+        while (generator.next(working)) {
+            for (size_t i = 0; i < queries.size(); ++i) {
+                PQL::DistanceContext full(pn.get(), working.marking(), &compiled[i]);
+                PQL::DistanceContext incremental(pn.get(), working.marking(), &compiled[i]);
+                incremental.setParent(&caches[i], generator.fired());
+                BOOST_REQUIRE_EQUAL(full.distance(queries[i].get()), incremental.distance(queries[i].get()));
+            }
+            auto res = states.add(working);
+            if (res.first) waiting.push_back(res.second);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(WidePresetKernel) {
+    // the dispatched kernel must agree with a plain loop, also around the unsigned range
+    std::mt19937 rng(42);
+    for (size_t it = 0; it < 10000; ++it) {
+        uint32_t n = rng() % 40;
+        std::vector<uint32_t> marking(64), places(n), tokens(n);
+        for (auto& m : marking)
+            m = (rng() % 4 == 0 ? 0xF0000000u : 0) + rng() % 5;
+        for (uint32_t i = 0; i < n; ++i) {
+            places[i] = rng() % marking.size();
+            tokens[i] = (rng() % 4 == 0 ? 0xF0000000u : 0) + rng() % 4;
+        }
+        bool expected = true;
+        for (uint32_t i = 0; i < n; ++i)
+            expected = expected && marking[places[i]] >= tokens[i];
+        BOOST_REQUIRE_EQUAL(expected, ArcKernels::covers(marking.data(), places.data(), tokens.data(), n));
+    }
+}
@@ -124,6 +124,39 @@ BOOST_AUTO_TEST_CASE(ruleD3, * utf::timeout(60)) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(ruleD3Parallel, * utf::timeout(60)) {
+
+    const std::set<size_t> qnums{0};
+    const std::vector<Reachability::ResultPrinter::Result> expected{
+        Reachability::ResultPrinter::NotSatisfied};
+    for(size_t rmode : {0,1})
+    {
+        std::vector<Reachability::ResultPrinter::Result> results{
+            Reachability::ResultPrinter::Unknown};
+
+        auto [conditions, builder, qstrings, trans_names, place_names] = load_builder("/models/DiscoveryGPU-PT-15a/model.pnml",
+            "/models/DiscoveryGPU-PT-15a/ruleDerr.xml", qnums);
+        std::vector<uint32_t> reds;
+        std::unique_ptr<PetriNet> net{builder.makePetriNet(false)};
+        contextAnalysis(false, trans_names, place_names, builder, net.get(), conditions);
+        builder.reduce(conditions, results, rmode, false, net.get(), 10, reds);
+        net.reset(builder.makePetriNet(false));
+        contextAnalysis(false, trans_names, place_names, builder, net.get(), conditions);
+
+        for (size_t i = 0; i < conditions.size(); ++i) {
+            AsCTL v;
+            Visitor::visit(v, conditions[i]);
+            auto p = PetriEngine::PQL::pushNegation(v._ctl_query);
+            for (auto strategy : {Strategy::DFS, Strategy::BFS}) {
+                CTLResult cres(conditions[i].get());
+                bool res = CTLSingleSolve(p.get(), net.get(), CTL::CZero, strategy, false, cres, nullptr, 4);
+                auto result = res ? ResultPrinter::Satisfied : ResultPrinter::NotSatisfied;
+                BOOST_REQUIRE_EQUAL(expected[i], result);
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(ruleGFail, * utf::timeout(60)) {
 
     const std::set<size_t> qnums{0};
@@ -155,4 +188,28 @@ BOOST_AUTO_TEST_CASE(ruleGFail, * utf::timeout(60)) {
             ++i;
         }
     }
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(incrementalRulesReachFixpoint, * utf::timeout(60)) {
+    // rules A, B and G only re-examine what changed since their last sweep,
+    // a second reduction starting from scratch must not find anything they missed
+    const std::set<size_t> qnums{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    std::vector<Reachability::ResultPrinter::Result> results(qnums.size(), Reachability::ResultPrinter::Unknown);
+
+    auto [conditions, builder, qstrings, trans_names, place_names] = load_builder("/models/Angiogenesis-PT-01/model.pnml",
+        "/models/Angiogenesis-PT-01/ReachabilityCardinality.xml", qnums);
+    std::unique_ptr<PetriNet> net{builder.makePetriNet(false)};
+    contextAnalysis(false, trans_names, place_names, builder, net.get(), conditions);
+    std::vector<uint32_t> reds{0, 1, 6};
+    builder.reduce(conditions, results, 3, false, net.get(), 10, reds);
+    auto places = builder.getReducer()->numberOfUnskippedPlaces();
+    auto transitions = builder.getReducer()->numberOfUnskippedTransitions();
+    BOOST_REQUIRE_GT(builder.getReducer()->removedTransitions(), 0);
+
+    net.reset(builder.makePetriNet(false));
+    contextAnalysis(false, trans_names, place_names, builder, net.get(), conditions);
+    reds = {0, 1, 6};
+    builder.reduce(conditions, results, 3, false, net.get(), 10, reds);
+    BOOST_REQUIRE_EQUAL(places, builder.getReducer()->numberOfUnskippedPlaces());
+    BOOST_REQUIRE_EQUAL(transitions, builder.getReducer()->numberOfUnskippedTransitions());
+}
@@ -4,6 +4,9 @@
 #include "CTL/DependencyGraph/BasicDependencyGraph.h"
 #include "CTL/SearchStrategy/SearchStrategy.h"
 #include "PetriEngine/Reachability/ReachabilitySearch.h"
+#include "utils/MemoryBudget.h"
+
+#include <atomic>
 
 namespace Algorithm {
 
@@ -17,7 +20,25 @@ public:
     size_t processedNegationEdges() const { return _processedNegationEdges; }
     size_t exploredConfigurations() const { return _exploredConfigurations; }
     size_t numberOfEdges() const { return _numberOfEdges; }
+
+    // search() gives up once the flag is raised or the memory budget is exhausted, its answer is then meaningless
+    void setStopFlag(const std::atomic<bool>* stop) { _stop = stop; }
+    // true if the last search gave up because it saw the memory budget exhausted
+    bool outOfMemory() const { return _outOfMemory.load(); }
 protected:
+    bool stopped() const {
+        if (_stop != nullptr && _stop->load(std::memory_order_relaxed))
+            return true;
+        // recorded here, as another query may lower the process-wide flag before this one reports
+        if (MemoryBudget::exhausted()) {
+            _outOfMemory = true;
+            return true;
+        }
+        return false;
+    }
+
+    const std::atomic<bool>* _stop = nullptr;
+    mutable std::atomic<bool> _outOfMemory{false};
     std::shared_ptr<SearchStrategy::SearchStrategy> strategy;
     //total number of processed edges
     size_t _processedEdges = 0;
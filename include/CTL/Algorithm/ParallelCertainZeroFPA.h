@@ -0,0 +1,96 @@
+#ifndef PARALLELCERTAINZEROFPA_H
+#define PARALLELCERTAINZEROFPA_H
+
+#include "FixedPointAlgorithm.h"
+#include "CTL/DependencyGraph/Edge.h"
+#include "CTL/DependencyGraph/Configuration.h"
+#include "PetriEngine/Structures/WorkStealingQueue.h"
+
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace Algorithm {
+
+/**
+ * Multi-threaded version of the certain-zero algorithm.
+ *
+ * All workers share the configurations and edges of the dependency graph,
+ * which must be built for at least as many workers (see BasicDependencyGraph::workers).
+ * Each worker keeps its own waiting edges and hands some of them over to idle workers.
+ * Configurations and edges are protected by striped locks; a worker never holds more
+ * than one of them, and only while inspecting or updating the object itself.
+ *
+ * Negation edges are postponed until no worker has anything left to do, at which point
+ * the deepest of them are released in the same way as the sequential algorithm does.
+ * Edges are never recycled during the search.
+ */
+class ParallelCertainZeroFPA : public FixedPointAlgorithm
+{
+public:
+    ParallelCertainZeroFPA(Strategy type, uint32_t threads);
+    virtual ~ParallelCertainZeroFPA()
+    {
+    }
+    virtual bool search(DependencyGraph::BasicDependencyGraph &t_graph) override;
+private:
+    static constexpr size_t LOCKS = 4096;
+
+    struct worker_t {
+        uint32_t id;
+        std::vector<DependencyGraph::Edge*> dependencies;
+        std::deque<DependencyGraph::Edge*> waiting;
+        std::default_random_engine rng;
+        bool idle = false;
+        size_t processedEdges = 0;
+        size_t processedNegationEdges = 0;
+        size_t exploredConfigurations = 0;
+        size_t numberOfEdges = 0;
+    };
+
+    void work(worker_t& w);
+    DependencyGraph::Edge* pop(worker_t& w);
+    void releaseNegations(worker_t& w);
+    void checkEdge(worker_t& w, DependencyGraph::Edge* e);
+    void explore(worker_t& w, DependencyGraph::Configuration* c);
+    void finalAssign(worker_t& w, DependencyGraph::Configuration* c, DependencyGraph::Assignment a);
+    void removeSuccessor(worker_t& w, DependencyGraph::Configuration* c);
+    bool addDependency(worker_t& w, DependencyGraph::Configuration* c, DependencyGraph::Edge* e);
+    void pushDependency(worker_t& w, DependencyGraph::Edge* e);
+
+    std::mutex& lock(const DependencyGraph::Configuration* c)
+    {
+        return _conf_locks[(reinterpret_cast<uintptr_t>(c) >> 4) % LOCKS];
+    }
+    std::mutex& lock(const DependencyGraph::Edge* e)
+    {
+        return _edge_locks[(reinterpret_cast<uintptr_t>(e) >> 4) % LOCKS];
+    }
+
+    const Strategy _type;
+    const uint32_t _threads;
+    DependencyGraph::BasicDependencyGraph *graph = nullptr;
+    DependencyGraph::Configuration* vertex = nullptr;
+
+    std::vector<worker_t> _workers;
+    std::vector<PetriEngine::Structures::WorkStealingQueue<DependencyGraph::Edge*>> _shared;
+    // edges waiting in some queue or being checked
+    std::atomic<int64_t> _pending{0};
+    std::atomic<uint32_t> _idle{0};
+    std::atomic<bool> _finished{false};
+
+    // guards _negations and the release of them
+    std::mutex _negation_lock;
+    std::vector<DependencyGraph::Edge*> _negations;
+
+    std::mutex _error_lock;
+    std::exception_ptr _error = nullptr;
+
+    std::mutex _conf_locks[LOCKS];
+    std::mutex _edge_locks[LOCKS];
+};
+}
+#endif // PARALLELCERTAINZEROFPA_H
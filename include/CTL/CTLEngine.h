@@ -7,14 +7,18 @@
 
 #include "Algorithm/AlgorithmTypes.h"
 #include "../PetriEngine/PQL/PQL.h"
+#include "../PetriEngine/Reachability/StateSpaceCache.h"
 
 #include "CTLResult.h"
 
+#include <atomic>
 #include <set>
 
 bool CTLSingleSolve(PetriEngine::PQL::Condition* query, PetriEngine::PetriNet* net,
                     CTL::CTLAlgorithmType algorithmtype,
-                    Strategy strategytype, bool partial_order, CTLResult& result);
+                    Strategy strategytype, bool partial_order, CTLResult& result,
+                    const std::atomic<bool>* stop = nullptr, uint32_t threads = 1,
+                    PetriEngine::Reachability::StateSpaceCache* cache = nullptr);
 
 ReturnValue CTLMain(PetriEngine::PetriNet* net,
                     CTL::CTLAlgorithmType algorithmtype,
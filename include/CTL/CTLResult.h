@@ -27,6 +27,8 @@ struct CTLResult {
     size_t exploredConfigurations = 0;
     size_t numberOfEdges = 0;
     size_t maxTokens = 0;
+    // set when a search for the query gave up because the memory budget was exhausted
+    bool outOfMemory = false;
 #ifdef VERIFYPNDIST
     size_t numberOfRoundsComputingDistance = 0;
     size_t numberOfTokensReceived = 0;
@@ -5,6 +5,8 @@
 #include <vector>
 #include <cstdint>
 
+#include "ListArena.h"
+
 namespace DependencyGraph {
 
 class Configuration;
@@ -13,10 +15,25 @@ class Edge;
 class BasicDependencyGraph {
 
 public:
+    explicit BasicDependencyGraph(uint32_t workers = 1)
+    : _targets(workers), _dependencies(workers) {}
+    virtual ~BasicDependencyGraph() {}
+
+    // the cells of Edge::targets and Configuration::dependency_set, per worker as for successors
+    ListArena<Configuration*>& targets() { return _targets; }
+    ListArena<Edge*>& dependencies() { return _dependencies; }
+
     virtual std::vector<Edge*> successors(Configuration *c) =0;
+    // graphs built for several workers may be expanded concurrently, one call per worker at a time
+    virtual std::vector<Edge*> successors(Configuration *c, uint32_t worker) { return successors(c); }
+    virtual uint32_t workers() const { return 1; }
     virtual Configuration *initialConfiguration() =0;
     virtual void release(Edge* e) = 0;
     virtual void cleanUp() =0;
+
+private:
+    ListArena<Configuration*> _targets;
+    ListArena<Edge*> _dependencies;
 };
 
 }
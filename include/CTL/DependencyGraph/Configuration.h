@@ -3,31 +3,36 @@
 
 #include "Edge.h"
 
+#include <atomic>
 #include <string>
 #include <cstdio>
 #include <iostream>
 #include <vector>
-#include <forward_list>
 #include <cstdint>
 
 namespace DependencyGraph {
 
 class Edge;
+using DependencyArena = ListArena<Edge*>;
 
 class Configuration
 {
 public:
-    std::forward_list<Edge*> dependency_set;   
+    // sorted by address; the cells are owned by the graph, see BasicDependencyGraph::dependencies
+    DependencyArena::list_t dependency_set;
     uint32_t nsuccs = 0;
 private:
-    uint32_t distance = 0;
-    void setDistance(uint32_t value) { distance = value; }
+    // atomic as the parallel certain-zero algorithm reads these without holding the lock of the configuration
+    std::atomic<uint32_t> distance{0};
+    void setDistance(uint32_t value) { distance.store(value, std::memory_order_relaxed); }
 public:
-    int8_t assignment = UNKNOWN;
+    std::atomic<int8_t> assignment{UNKNOWN};
     Configuration() {}
-    uint32_t getDistance() const { return distance; }
+    uint32_t getDistance() const { return distance.load(std::memory_order_relaxed); }
     bool isDone() const { return assignment == ONE || assignment == CZERO; }
-    void addDependency(Edge* e);
+    void addDependency(Edge* e, DependencyArena& arena, uint32_t worker = 0);
+    // as addDependency, but leaves the reference count of the edge alone
+    bool insertDependency(Edge* e, DependencyArena& arena, uint32_t worker = 0);
     void setOwner(uint32_t) { }
     uint32_t getOwner() { return 0; }
     
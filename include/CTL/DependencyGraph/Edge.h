@@ -6,9 +6,10 @@
 #include <string>
 #include <algorithm>
 #include <cassert>
-#include <forward_list>
 #include <cstdint>
 
+#include "ListArena.h"
+
 namespace DependencyGraph {
 
 class Configuration;
@@ -16,26 +17,28 @@ enum Assignment {
     ONE = 1, UNKNOWN = 0, ZERO = -1, CZERO = -2
 };
 
+using TargetArena = ListArena<Configuration*>;
+
 class Edge {
-    typedef std::forward_list<Configuration*> container;
 public:
     Edge(){}
     Edge(Configuration &t_source) : source(&t_source) {}
 
-    bool addTarget(Configuration* conf)
+    bool addTarget(Configuration* conf, TargetArena& arena, uint32_t worker = 0)
     {
         if(handled) return true;
         assert(conf);
         if(conf == source)
         {
             handled = true;
-            targets.clear();
+            arena.clear(targets, worker);
         }
-        else targets.push_front(conf);
+        else arena.push_front(targets, conf, worker);
         return handled;
     }
 
-    container targets;
+    // the cells are owned by the graph, see BasicDependencyGraph::targets
+    TargetArena::list_t targets;
     Configuration* source;
     uint8_t status = 0;
     bool processed = false;
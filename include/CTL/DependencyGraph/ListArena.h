@@ -0,0 +1,198 @@
+#ifndef LISTARENA_H
+#define LISTARENA_H
+
+#include "utils/errors.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace DependencyGraph {
+
+/**
+ * Storage for many small singly linked lists of T, such as the targets of
+ * the edges of a dependency graph.
+ *
+ * A list is only the 32-bit index of its first cell, and each cell holds a
+ * value and the index of the next cell. Cells are carved out of large blocks
+ * owned by the arena, so they cost no allocation of their own, and are all
+ * released with the arena. Released cells are reused by the worker that
+ * released them.
+ *
+ * Each worker allocates from its own free cells, so workers may modify
+ * distinct lists concurrently; a single list must be guarded by its user.
+ */
+template<typename T>
+class ListArena {
+    struct cell_t {
+        T value;
+        uint32_t next;
+    };
+
+    static constexpr uint32_t NIL = 0;
+    static constexpr uint32_t BLOCK_BITS = 16;
+    static constexpr uint32_t BLOCK_SIZE = 1u << BLOCK_BITS;
+    static constexpr uint32_t BLOCKS = 1u << (32 - BLOCK_BITS);
+    // fresh cells handed to a worker at a time
+    static constexpr uint32_t BATCH = 1024;
+
+public:
+    /** a list of the arena, zero-initialised memory is the empty list */
+    struct list_t {
+        uint32_t _head = NIL;
+        bool empty() const { return _head == NIL; }
+    };
+
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+
+        T& operator*() const {
+            // _link is the next field of the current cell
+            return reinterpret_cast<cell_t*>(reinterpret_cast<char*>(_link) - offsetof(cell_t, next))->value;
+        }
+
+        iterator& operator++() {
+            _link = *_link == NIL ? nullptr : &_arena->cell(*_link).next;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto it = *this;
+            ++(*this);
+            return it;
+        }
+
+        bool operator==(const iterator& other) const { return _link == other._link; }
+        bool operator!=(const iterator& other) const { return _link != other._link; }
+
+    private:
+        friend class ListArena;
+        iterator(ListArena* arena, uint32_t* link) : _arena(arena), _link(link) {}
+
+        ListArena* _arena = nullptr;
+        // the link to the cell after this one; the head of the list before the first cell
+        uint32_t* _link = nullptr;
+    };
+
+    struct range_t {
+        iterator _begin, _end;
+        iterator begin() const { return _begin; }
+        iterator end() const { return _end; }
+    };
+
+    explicit ListArena(size_t workers)
+    : _workers(std::max<size_t>(workers, 1)), _blocks(new std::atomic<cell_t*>[BLOCKS]) {
+        for (uint32_t i = 0; i < BLOCKS; ++i)
+            _blocks[i] = nullptr;
+    }
+
+    ~ListArena() {
+        for (uint32_t i = 0; i < BLOCKS && _blocks[i] != nullptr; ++i)
+            delete[] _blocks[i].load();
+    }
+
+    ListArena(const ListArena&) = delete;
+    ListArena& operator=(const ListArena&) = delete;
+
+    iterator before_begin(list_t& list) { return iterator(this, &list._head); }
+    iterator begin(list_t& list) { return ++before_begin(list); }
+    iterator end() { return iterator(this, nullptr); }
+
+    /** the values of list, for range-based for loops */
+    range_t items(list_t& list) { return range_t{begin(list), end()}; }
+
+    T& front(const list_t& list) {
+        assert(!list.empty());
+        return cell(list._head).value;
+    }
+
+    iterator insert_after(iterator pos, T value, uint32_t worker = 0) {
+        assert(pos._link != nullptr);
+        auto id = allocate(worker);
+        auto& c = cell(id);
+        c.value = value;
+        c.next = *pos._link;
+        *pos._link = id;
+        return iterator(this, &c.next);
+    }
+
+    /** remove the value after pos, and return the iterator to the one after that */
+    iterator erase_after(iterator pos, uint32_t worker = 0) {
+        assert(pos._link != nullptr && *pos._link != NIL);
+        auto id = *pos._link;
+        *pos._link = cell(id).next;
+        release(id, worker);
+        return ++pos;
+    }
+
+    void push_front(list_t& list, T value, uint32_t worker = 0) {
+        insert_after(before_begin(list), value, worker);
+    }
+
+    void clear(list_t& list, uint32_t worker = 0) {
+        while (!list.empty())
+            erase_after(before_begin(list), worker);
+    }
+
+private:
+    struct alignas(64) worker_t {
+        uint32_t free = NIL;
+        // the fresh cells [next, end) reserved by this worker
+        uint32_t next = NIL;
+        uint32_t end = NIL;
+    };
+
+    cell_t& cell(uint32_t id) {
+        return _blocks[id >> BLOCK_BITS].load(std::memory_order_relaxed)[id & (BLOCK_SIZE - 1)];
+    }
+
+    uint32_t allocate(uint32_t worker) {
+        auto& w = _workers[worker];
+        if (w.free != NIL) {
+            auto id = w.free;
+            w.free = cell(id).next;
+            return id;
+        }
+        if (w.next == w.end) {
+            std::lock_guard<std::mutex> guard(_lock);
+            if (uint64_t{_fresh} + BATCH >= (uint64_t{1} << 32))
+                throw base_error("The dependency graph needs more than 2^32 list cells");
+            w.next = _fresh;
+            w.end = _fresh + BATCH;
+            _fresh += BATCH;
+            // BATCH divides BLOCK_SIZE, so the reserved cells lie in one block
+            auto block = w.next >> BLOCK_BITS;
+            if (_blocks[block].load(std::memory_order_relaxed) == nullptr)
+                _blocks[block] = new cell_t[BLOCK_SIZE];
+        }
+        return w.next++;
+    }
+
+    void release(uint32_t id, uint32_t worker) {
+        auto& w = _workers[worker];
+        cell(id).next = w.free;
+        w.free = id;
+    }
+
+    std::vector<worker_t> _workers;
+    std::unique_ptr<std::atomic<cell_t*>[]> _blocks;
+    std::mutex _lock;
+    // the first batch is never handed out, as index zero is the end of every list
+    uint32_t _fresh = BATCH;
+};
+
+}
+#endif // LISTARENA_H
@@ -2,6 +2,8 @@
 #define ONTHEFLYDG_H
 
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <stack>
 #include <ptrie/ptrie_map.h>
 
@@ -14,6 +16,7 @@
 #include "PetriEngine/Structures/AlignedEncoder.h"
 #include "PetriEngine/Structures/linked_bucket.h"
 #include "PetriEngine/ReducingSuccessorGenerator.h"
+#include "PetriEngine/Reachability/StateSpaceCache.h"
 
 namespace PetriNets {
 class OnTheFlyDG : public DependencyGraph::BasicDependencyGraph
@@ -22,17 +25,42 @@ public:
     using Condition = PetriEngine::PQL::Condition;
     using Condition_ptr = PetriEngine::PQL::Condition_ptr;
     using Marking = PetriEngine::Structures::State;
-    OnTheFlyDG(PetriEngine::PetriNet *t_net, bool partial_order);
+    /**
+     * With more than one thread, successors(c, worker) may be called concurrently
+     * for distinct workers. Partial order reduction is then disabled, as the
+     * stubborn set computation is not thread-safe.
+     */
+    OnTheFlyDG(PetriEngine::PetriNet *t_net, bool partial_order, uint32_t threads = 1);
 
     virtual ~OnTheFlyDG();
 
     //Dependency graph interface
-    virtual std::vector<DependencyGraph::Edge*> successors(DependencyGraph::Configuration *c) override;
+    virtual std::vector<DependencyGraph::Edge*> successors(DependencyGraph::Configuration *c) override
+    {
+        return successors(c, 0);
+    }
+    virtual std::vector<DependencyGraph::Edge*> successors(DependencyGraph::Configuration *c, uint32_t worker) override;
+    virtual uint32_t workers() const override
+    {
+        return _workers.size();
+    }
     virtual DependencyGraph::Configuration *initialConfiguration() override;
     virtual void cleanUp() override;
     void setQuery(Condition* query);
 
-    virtual void release(DependencyGraph::Edge* e) override;
+    /**
+     * Follow the edges of a complete state space of the net (without a k-bound)
+     * instead of firing transitions, where no stubborn set is computed.
+     */
+    void setStateSpaceCache(PetriEngine::Reachability::StateSpaceCache* cache)
+    {
+        _cache = cache;
+    }
+
+    virtual void release(DependencyGraph::Edge* e) override
+    {
+        release(e, 0);
+    }
 
     size_t owner(Marking& marking, Condition* cond);
     size_t owner(Marking& marking, const Condition_ptr& cond)
@@ -48,13 +76,21 @@ public:
     Condition::Result initialEval();
 
 protected:
+    // the state of each thread expanding configurations
+    struct worker_t {
+        worker_t(uint32_t places) : encoder(places, 0) {}
+        AlignedEncoder encoder;
+        Marking working_marking;
+        Marking query_marking;
+        std::stack<DependencyGraph::Edge*> recycle;
+    };
 
     //initialized from constructor
-    AlignedEncoder encoder;
     PetriEngine::PetriNet *net = nullptr;
     PetriConfig* initial_config;
-    Marking working_marking;
-    Marking query_marking;
+    std::vector<std::unique_ptr<worker_t>> _workers;
+    // guards the trie and the counters when there is more than one worker
+    std::mutex _lock;
     uint32_t n_transitions = 0;
     uint32_t n_places = 0;
     size_t _markingCount = 0;
@@ -68,46 +104,53 @@ protected:
     {
         return fastEval(query.get(), unfolded);
     }
-    void nextStates(Marking& t_marking, Condition*,
+    void nextStates(worker_t& w, Condition*,
     std::function<void ()> pre,
     std::function<bool (Marking&)> foreach,
     std::function<void ()> post);
     template<typename T>
-    void dowork(T& gen, bool& first,
+    void dowork(worker_t& w, T& gen, bool& first,
     std::function<void ()>& pre,
     std::function<bool (Marking&)>& foreach)
     {
-        gen.prepare(&query_marking);
+        gen.prepare(&w.query_marking);
 
-        while(gen.next(working_marking)){
+        while(gen.next(w.working_marking)){
             if(first) pre();
             first = false;
-            if(!foreach(working_marking))
+            if(!foreach(w.working_marking))
             {
                 gen.reset();
                 break;
             }
         }
     }
-    PetriConfig *createConfiguration(size_t marking, size_t own, Condition* query);
-    PetriConfig *createConfiguration(size_t marking, size_t own, const Condition_ptr& query)
+    PetriConfig *createConfiguration(size_t marking, size_t own, Condition* query, uint32_t worker);
+    PetriConfig *createConfiguration(size_t marking, size_t own, const Condition_ptr& query, uint32_t worker)
     {
-        return createConfiguration(marking, own, query.get());
+        return createConfiguration(marking, own, query.get(), worker);
     }
-    size_t createMarking(Marking &marking);
+    size_t createMarking(Marking &marking, uint32_t worker);
     void markingStats(const uint32_t* marking, size_t& sum, bool& allsame, uint32_t& val, uint32_t& active, uint32_t& last);
 
-    DependencyGraph::Edge* newEdge(DependencyGraph::Configuration &t_source, uint32_t weight);
+    DependencyGraph::Edge* newEdge(DependencyGraph::Configuration &t_source, uint32_t weight, uint32_t worker);
+    void release(DependencyGraph::Edge* e, uint32_t worker);
 
-    std::stack<DependencyGraph::Edge*> recycle;
-    ptrie::map<ptrie::uchar, std::vector<PetriConfig*> > trie;
+    // the handle of the latest configuration of each marking, zero if there is none
+    ptrie::map<ptrie::uchar, uint32_t> trie;
     linked_bucket_t<DependencyGraph::Edge,1024*10>* edge_alloc = nullptr;
 
     // Problem  with linked bucket and complex constructor
     linked_bucket_t<char[sizeof(PetriConfig)], 1024*1024>* conf_alloc = nullptr;
+    // a handle is the index in conf_alloc plus one
+    PetriConfig* configuration(uint32_t handle)
+    {
+        return reinterpret_cast<PetriConfig*>((*conf_alloc)[handle - 1]);
+    }
 
     PetriEngine::ReducingSuccessorGenerator _redgen;
     bool _partial_order = false;
+    PetriEngine::Reachability::StateSpaceCache* _cache = nullptr;
 
 };
 
@@ -16,11 +16,13 @@ public:
         DependencyGraph::Configuration(), marking(0), query(NULL) 
     {}
     
-    PetriConfig(size_t t_marking, Condition *t_query) :
+    PetriConfig(uint32_t t_marking, Condition *t_query) :
         DependencyGraph::Configuration(), marking(t_marking), query(t_query) {
     }
 
-    size_t marking;
+    uint32_t marking;
+    // handle of the next configuration of the same marking, see OnTheFlyDG::createConfiguration
+    uint32_t sibling = 0;
     Condition *query;
 
 };
@@ -9,6 +9,7 @@
 #define RDFSSEARCH_H
 
 #include <deque>
+#include <random>
 #include "CTL/DependencyGraph/Edge.h"
 #include "SearchStrategy.h"
 
@@ -26,6 +27,7 @@ protected:
     DependencyGraph::Edge* popFromW();
     std::vector<DependencyGraph::Edge*> W;
     size_t last_parent = 0;
+    std::default_random_engine rng;
 };
 
 }   // end SearchStrategy
@@ -7,26 +7,6 @@
 
 namespace SearchStrategy {
 
-struct Message {
-    uint32_t sender;
-    uint32_t distance;
-    enum Type {HALT = 0, REQUEST = 1, ANSWER_ONE = 2, ANSWER_ZERO = 3} type;
-    DependencyGraph::Configuration *configuration;
-
-    Message() {}
-    Message(size_t sender, uint32_t distance, Type type, DependencyGraph::Configuration *configuration) :
-           sender(sender), distance(distance), type(type), configuration(configuration) {}
-
-    std::string ToString() {
-        std::stringstream ss;
-        ss << "Message from " << sender << ": ";
-        ss << (type == HALT ? "Halt" : type == REQUEST ? "Request" : type == ANSWER_ONE ? "Answer 1" : "Answer 0");
-        ss << configuration << "\n";
-        return ss.str();
-    }
-};
-
-
 class SearchStrategy
 {
 public:
@@ -44,6 +24,8 @@ public:
     bool trivialNegation();
     virtual void flush() {};
 //#endif
+    // where the targets of the edges are stored, set before the first edge is pushed
+    void setTargets(DependencyGraph::TargetArena* targets) { _targets = targets; }
 protected:
     virtual size_t Wsize() const = 0;
     virtual void pushToW(DependencyGraph::Edge* edge) = 0;
@@ -51,6 +33,7 @@ protected:
 
     std::vector<DependencyGraph::Edge*> N;
     std::vector<DependencyGraph::Edge*> D;
+    DependencyGraph::TargetArena* _targets = nullptr;
 };
 
 }
@@ -31,6 +31,8 @@
 
 #include <iomanip>
 #include <algorithm>
+#include <atomic>
+#include <vector>
 
 namespace LTL {
 
@@ -56,6 +58,23 @@ namespace LTL {
 
         virtual void set_partial_order(LTLPartialOrder) {}
 
+        /**
+         * Lets another thread abort the search; check() returns early once any of the flags
+         * is raised and its answer is then meaningless.
+         */
+        virtual void add_stop_flag(const std::atomic<bool>* stop) {
+            _stop.push_back(stop);
+        }
+
+        // like a stop flag, but out_of_memory() tells whether the search gave up because of it
+        virtual void set_memory_flag(const std::atomic<bool>* exhausted) {
+            _memory = exhausted;
+        }
+
+        virtual bool out_of_memory() const {
+            return _out_of_memory;
+        }
+
         virtual bool check() = 0;
 
         virtual ~ModelChecker() = default;
@@ -96,11 +115,22 @@ namespace LTL {
 
 
     protected:
+        bool stopped() const {
+            for (auto* stop : _stop)
+                if (stop->load(std::memory_order_relaxed))
+                    return true;
+            if (_memory != nullptr && _memory->load(std::memory_order_relaxed)) {
+                _out_of_memory = true;
+                return true;
+            }
+            return false;
+        }
+
         size_t _explored = 0;
         size_t _expanded = 0;
 
         virtual void print_stats(std::ostream &os, size_t discovered, size_t max_tokens) const {
-            std::cout << "STATS:\n"
+            os << "STATS:\n"
                     << "\tdiscovered states: " << discovered << std::endl
                     << "\texplored states:   " << _explored << std::endl
                     << "\texpanded states:   " << _expanded << std::endl
@@ -117,6 +147,9 @@ namespace LTL {
         size_t _loop = std::numeric_limits<size_t>::max();
         std::vector<std::vector<uint32_t>> _trace;
         bool _violation = false;
+        std::vector<const std::atomic<bool>*> _stop;
+        const std::atomic<bool>* _memory = nullptr;
+        mutable bool _out_of_memory = false;
     };
 }
 
@@ -0,0 +1,74 @@
+/* Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VERIFYPN_SWARMMODELCHECKER_H
+#define VERIFYPN_SWARMMODELCHECKER_H
+
+#include "LTL/Algorithm/ModelChecker.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace LTL {
+
+    /**
+     * Runs a number of independently configured model checkers on their own thread and
+     * reports the answer of the first one to terminate, aborting the rest. The checkers
+     * should differ in their search order (e.g. seeds of a random heuristic) for this to pay off.
+     * <p>
+     *   Gerard J. Holzmann, Rajeev Joshi and Alex Groce,<br>
+     *   Swarm Verification Techniques,<br>
+     *   https://doi.org/10.1109/TSE.2010.110
+     * </p>
+     *
+     * Only the first checker may use spot/BDDs during the search (e.g. for partial order
+     * reduction), the remaining ones must stick to the compiled guards of the automaton.
+     */
+    class SwarmModelChecker : public ModelChecker {
+    public:
+        SwarmModelChecker(const PetriEngine::PetriNet& net, const PetriEngine::PQL::Condition_ptr &query,
+                          const Structures::BuchiAutomaton &buchi,
+                          std::vector<std::unique_ptr<ModelChecker>>&& checkers);
+
+        bool check() override;
+
+        void add_stop_flag(const std::atomic<bool>* stop) override;
+
+        void set_memory_flag(const std::atomic<bool>* exhausted) override;
+
+        bool out_of_memory() const override;
+
+        void print_stats(std::ostream &os) const override;
+
+        size_t max_tokens() const override;
+
+        size_t get_discovered() const override;
+
+        size_t get_markings() const override;
+
+        size_t get_configurations() const override;
+
+        LTLPartialOrder used_partial_order() const override;
+
+    private:
+        std::vector<std::unique_ptr<ModelChecker>> _checkers;
+        std::atomic<bool> _done{false};
+        size_t _winner = 0;
+    };
+}
+
+#endif //VERIFYPN_SWARMMODELCHECKER_H
@@ -28,7 +28,10 @@
 
 #include <ptrie/ptrie.h>
 
+#include <algorithm>
 #include <limits>
+#include <mutex>
+#include <vector>
 
 namespace LTL {
 
@@ -47,17 +50,20 @@ namespace LTL {
     public:
         TarjanModelChecker(const PetriEngine::PetriNet& net, const PetriEngine::PQL::Condition_ptr &cond,
                            const Structures::BuchiAutomaton &buchi,
-                           uint32_t kbound, uint32_t hyper_traces)
-                : ModelChecker(net, cond, buchi), _k_bound(kbound), _hyper_traces(hyper_traces)
+                           uint32_t kbound, uint32_t hyper_traces, size_t hash_size = DEFAULT_HASH_SIZE)
+                : ModelChecker(net, cond, buchi), _k_bound(kbound), _hyper_traces(hyper_traces),
+                  _chash(std::max<size_t>(hash_size, 1), std::numeric_limits<idx_t>::max())
         {
             if (buchi.buchi().num_states() > 1048576) {
                 throw base_error("Cannot handle Büchi automata larger than 2^20 states");
             }
             if(_hyper_traces > 1)
                 throw base_error("Hyper-LTL not supported for Tarjans algorithm (yet).");
-            _chash.fill(std::numeric_limits<idx_t>::max());
         }
 
+        // entries of the hash table of the search stack (128 MB); members of a swarm share this budget
+        static constexpr size_t DEFAULT_HASH_SIZE = 16777216;
+
         bool check() override;
 
         void print_stats(std::ostream &os) const override;
@@ -80,24 +86,24 @@ namespace LTL {
         template<typename SuccGen>
         bool select_trace_compute(SuccGen& successorGenerator);
 
+        template<typename SuccGen>
+        bool compute_unlocked(std::unique_lock<std::mutex>& lock, SuccGen& successorGenerator);
+
         template<bool TRACE, typename SuccGen>
         bool compute(SuccGen& successorGenerator);
 
         using State = LTL::Structures::ProductState;
         using idx_t = size_t;
-        // 64 MB hash table
-        static constexpr idx_t _hash_sz = 16777216;
 
         ptrie::set<idx_t,17,32,8> _store;
 
         // rudimentary hash table of state IDs. chash[hash(state)] is the top index in cstack
         // corresponding to state. Collisions are resolved using linked list via CEntry::next.
-        std::array<idx_t, _hash_sz> _chash;
-        static_assert(sizeof(_chash) == (1U << 27U));
+        std::vector<idx_t> _chash;
 
-        static inline idx_t hash(idx_t buchi_state, idx_t marking_id)
+        inline idx_t hash(idx_t buchi_state, idx_t marking_id) const
         {
-            return (buchi_state xor marking_id) % _hash_sz;
+            return (buchi_state xor marking_id) % _chash.size();
         }
 
         struct plain_centry_t {
@@ -47,13 +47,24 @@ namespace LTL {
         APCompression _compression;
         std::unique_ptr<ModelChecker> _checker;
         std::unique_ptr<Heuristic> _heuristic;
+        std::vector<std::unique_ptr<Heuristic>> _swarm_heuristics;
         bool _result;
+        const std::atomic<bool>* _stop = nullptr;
 
     public:
         LTLSearch(const PetriEngine::PetriNet& net,
                 const PetriEngine::PQL::Condition_ptr &query, const BuchiOptimization optimization = BuchiOptimization::High,
                 const APCompression compression = APCompression::Full);
 
+        ~LTLSearch();
+
+        /**
+         * Makes solve() give up once the flag is raised; its answer is then meaningless.
+         */
+        void set_stop_flag(const std::atomic<bool>* stop) {
+            _stop = stop;
+        }
+
         bool solve(
                 const bool trace,
                 const uint64_t k_bound = 0,
@@ -62,7 +73,8 @@ namespace LTL {
                 const Strategy search_strategy = Strategy::HEUR,
                 const LTLHeuristic heuristics = LTLHeuristic::Automaton,
                 const bool utilize_weak = true,
-                const uint64_t seed = 0);
+                const uint64_t seed = 0,
+                const uint32_t threads = 1);
         void print_buchi(std::ostream& out, const BuchiOutType type = BuchiOutType::Dot);
         void print_stats(std::ostream& out);
 
@@ -78,6 +90,11 @@ namespace LTL {
             return _checker->max_tokens();
         }
 
+        // true if the search gave up because the memory budget was exhausted
+        bool out_of_memory() const {
+            return _checker && _checker->out_of_memory();
+        }
+
         size_t configurations() const {
             return _checker->get_configurations();
         }
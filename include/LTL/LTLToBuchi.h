@@ -23,6 +23,7 @@
 #include "LTLOptions.h"
 
 #include <iostream>
+#include <mutex>
 #include <string>
 
 #include <spot/tl/formula.hh>
@@ -43,6 +44,12 @@ namespace LTL {
         class BuchiAutomaton;
     }
 
+    /**
+     * Spot and the BDD library keep global state which is not thread-safe. Threads creating,
+     * using or destroying spot formulae, automata or BDDs concurrently must hold this lock.
+     */
+    std::mutex& spot_mutex();
+
     Structures::BuchiAutomaton make_buchi_automaton(
             const PetriEngine::PQL::Condition_ptr &query,
             BuchiOptimization optimization, APCompression compression);
@@ -28,16 +28,76 @@
 #include <spot/twaalgos/neverclaim.hh>
 
 #include <unordered_map>
+#include <vector>
 
 namespace LTL { namespace Structures {
     class BuchiAutomaton {
+    public:
+        /**
+         * Edges and guards of the automaton flattened into plain arrays.
+         * Guards are stored as decision diagrams over the atomic propositions, where
+         * node 0 is false and node 1 is true; this lets successor generation run without
+         * touching spot or the BDD library, neither of which are thread-safe.
+         */
+        struct guard_node_t {
+            PetriEngine::PQL::Condition* _expression;
+            uint32_t _low;
+            uint32_t _high;
+        };
+
+        struct edge_t {
+            uint32_t _dest;
+            uint32_t _guard;
+        };
+
+        static constexpr uint32_t FALSE_GUARD = 0;
+        static constexpr uint32_t TRUE_GUARD = 1;
+
     private:
         spot::twa_graph_ptr _buchi = nullptr;
         std::unordered_map<int, AtomicProposition> _ap_info;
+        std::vector<guard_node_t> _guard_nodes;
+        std::vector<edge_t> _edges;
+        std::vector<uint32_t> _edge_offset;
+        std::vector<bool> _accepting;
+
+        uint32_t compile_guard(const bdd& cond, std::unordered_map<int, uint32_t>& compiled)
+        {
+            if (cond == bddfalse)
+                return FALSE_GUARD;
+            if (cond == bddtrue)
+                return TRUE_GUARD;
+            auto it = compiled.find(cond.id());
+            if (it != compiled.end())
+                return it->second;
+            auto low = compile_guard(bdd_low(cond), compiled);
+            auto high = compile_guard(bdd_high(cond), compiled);
+            _guard_nodes.push_back(guard_node_t{_ap_info.at(bdd_var(cond))._expression.get(), low, high});
+            auto id = static_cast<uint32_t>(_guard_nodes.size() - 1);
+            compiled[cond.id()] = id;
+            return id;
+        }
+
+        void compile()
+        {
+            std::unordered_map<int, uint32_t> compiled;
+            _guard_nodes = {guard_node_t{nullptr, FALSE_GUARD, FALSE_GUARD}, guard_node_t{nullptr, TRUE_GUARD, TRUE_GUARD}};
+            const auto nstates = _buchi->num_states();
+            _edge_offset.resize(nstates + 1);
+            _accepting.resize(nstates);
+            for (unsigned state = 0; state < nstates; ++state) {
+                _edge_offset[state] = _edges.size();
+                _accepting[state] = _buchi->state_is_accepting(state);
+                for (auto& e : _buchi->out(state))
+                    _edges.push_back(edge_t{e.dst, compile_guard(e.cond, compiled)});
+            }
+            _edge_offset[nstates] = _edges.size();
+        }
 
     public:
         BuchiAutomaton(spot::twa_graph_ptr buchi, std::unordered_map<int, AtomicProposition> apInfo)
                 : _buchi(std::move(buchi)), _ap_info(std::move(apInfo)) {
+            compile();
         }
 
         BuchiAutomaton() {};
@@ -60,6 +120,18 @@ namespace LTL { namespace Structures {
             return _ap_info;
         }
 
+        [[nodiscard]] bool is_accepting(size_t state) const {
+            return _accepting[state];
+        }
+
+        [[nodiscard]] const edge_t* edges_begin(size_t state) const {
+            return _edges.data() + _edge_offset[state];
+        }
+
+        [[nodiscard]] const edge_t* edges_end(size_t state) const {
+            return _edges.data() + _edge_offset[state + 1];
+        }
+
         void output_buchi(std::ostream& os, BuchiOutType type)
         {
             switch (type) {
@@ -77,9 +149,12 @@ namespace LTL { namespace Structures {
 
         /**
          * Evaluate binary decision diagram (BDD) representation of transition guard in given state.
+         * Takes the spot lock for the walk only, so concurrent searches are not serialised.
          */
-        bool guard_valid(PetriEngine::PQL::EvaluationContext &ctx, bdd bdd) const
+        bool guard_valid(PetriEngine::PQL::EvaluationContext &ctx, const bdd& guard) const
         {
+            std::lock_guard<std::mutex> lock(spot_mutex());
+            bdd bdd = guard;
             // IDs 0 and 1 are false and true atoms, respectively
             // More details in buddy manual ( http://buddy.sourceforge.net/manual/main.html )
             while (bdd.id() > 1) {
@@ -102,6 +177,31 @@ namespace LTL { namespace Structures {
             }
             return bdd == bddtrue;
         }
+
+        /**
+         * Evaluate a compiled guard (see edge_t) in given state.
+         */
+        bool guard_valid(PetriEngine::PQL::EvaluationContext &ctx, uint32_t guard) const
+        {
+            while (guard > TRUE_GUARD) {
+                auto& node = _guard_nodes[guard];
+                using PetriEngine::PQL::Condition;
+                Condition::Result res = PetriEngine::PQL::evaluate(node._expression, ctx);
+                switch (res) {
+                    case Condition::RUNKNOWN:
+                        assert(false);
+                        throw base_error("Unexpected unknown answer from evaluating query!");
+                        break;
+                    case Condition::RFALSE:
+                        guard = node._low;
+                        break;
+                    case Condition::RTRUE:
+                        guard = node._high;
+                        break;
+                }
+            }
+            return guard == TRUE_GUARD;
+        }
     };
 } }
 
@@ -45,7 +45,7 @@ namespace LTL { namespace Structures {
 
         [[nodiscard]] bool is_accepting() const {
             assert(_aut);
-            return _aut->buchi().state_is_accepting(get_buchi_state());
+            return _aut->is_accepting(get_buchi_state());
         }
 
     private:
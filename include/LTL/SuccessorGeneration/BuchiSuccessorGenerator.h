@@ -31,29 +31,30 @@
 #include <memory>
 
 namespace LTL {
+    /**
+     * Iterates the edges of the Büchi automaton. Uses the flattened edge table of the
+     * automaton, so it never touches spot once constructed and may be used concurrently
+     * with other instances.
+     */
     class BuchiSuccessorGenerator {
     public:
         explicit BuchiSuccessorGenerator(Structures::BuchiAutomaton automaton)
                 : _aut(std::move(automaton)), _self_loops(_aut.buchi().num_states(), InvariantSelfLoop::UNKNOWN)
         {
-            _deleter = SuccIterDeleter{&_aut};
         }
 
         void prepare(size_t state)
         {
-            auto curstate = _aut.buchi().state_from_number(state);
-            _succ = _succ_iter{_aut.buchi().succ_iter(curstate), SuccIterDeleter{&_aut}};
-            _succ->first();
+            _succ = _aut.edges_begin(state);
+            _end = _aut.edges_end(state);
         }
 
-        bool next(size_t &state, bdd &cond)
+        bool next(size_t &state, uint32_t &cond)
         {
-            if (!_succ->done()) {
-                auto dst = _succ->dst();
-                state = _aut.buchi().state_number(dst);
-                cond = _succ->cond();
-                _succ->next();
-                dst->destroy();
+            if (_succ != _end) {
+                state = _succ->_dest;
+                cond = _succ->_guard;
+                ++_succ;
                 return true;
             }
             return false;
@@ -61,7 +62,7 @@ namespace LTL {
 
         [[nodiscard]] bool is_accepting(size_t state) const
         {
-            return _aut.buchi().state_is_accepting(state);
+            return _aut.is_accepting(state);
         }
 
         [[nodiscard]] size_t initial_state_number() const
@@ -72,12 +73,8 @@ namespace LTL {
         bool has_invariant_self_loop(size_t state) {
             if (_self_loops[state] != InvariantSelfLoop::UNKNOWN)
                 return _self_loops[state] == InvariantSelfLoop::TRUE;
-            auto it = std::unique_ptr<spot::twa_succ_iterator>{
-                    _aut.buchi().succ_iter(_aut.buchi().state_from_number(state))};
-            for (it->first(); !it->done(); it->next()) {
-                auto dest_id = _aut.buchi().state_number(it->dst());
-                bdd cond = it->cond();
-                if (state == dest_id && cond == bddtrue) {
+            for (auto it = _aut.edges_begin(state); it != _aut.edges_end(state); ++it) {
+                if (state == it->_dest && it->_guard == Structures::BuchiAutomaton::TRUE_GUARD) {
                     _self_loops[state] = InvariantSelfLoop::TRUE;
                     return true;
                 }
@@ -92,23 +89,13 @@ namespace LTL {
 
 
     private:
-        struct SuccIterDeleter {
-            Structures::BuchiAutomaton *_aut;
-
-            void operator()(spot::twa_succ_iterator *iter) const
-            {
-                _aut->buchi().release_iter(iter);
-            }
-        };
-
         enum class InvariantSelfLoop {
             TRUE, FALSE, UNKNOWN
         };
         Structures::BuchiAutomaton _aut;
         std::vector<InvariantSelfLoop> _self_loops;
-        SuccIterDeleter _deleter{};
-        using _succ_iter = std::unique_ptr<spot::twa_succ_iterator, SuccIterDeleter>;
-        _succ_iter _succ = nullptr;
+        const Structures::BuchiAutomaton::edge_t* _succ = nullptr;
+        const Structures::BuchiAutomaton::edge_t* _end = nullptr;
     };
 }
 #endif //VERIFYPN_BUCHISUCCESSORGENERATOR_H
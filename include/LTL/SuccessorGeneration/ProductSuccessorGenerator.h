@@ -195,20 +195,26 @@ namespace LTL {
         const PetriEngine::PetriNet& _net;
         BuchiSuccessorGenerator _buchi_succ_gen;
 
-        bdd _cond;
+        uint32_t _cond;
         size_t _buchi_parent;
         bool _fresh_marking = true;
         std::vector<guard_info_t> _stateToGuards;
         /**
          * Evaluate binary decision diagram (BDD) representation of transition guard in given state.
          */
-        bool guard_valid(const PetriEngine::Structures::State &state, bdd bdd)
+        bool guard_valid(const PetriEngine::Structures::State &state, const bdd& bdd)
         {
             PetriEngine::PQL::EvaluationContext ctx{state.marking(), &_net};
             auto res = _buchi_succ_gen.automaton().guard_valid(ctx, bdd);
             return res;
         }
 
+        bool guard_valid(const PetriEngine::Structures::State &state, uint32_t guard)
+        {
+            PetriEngine::PQL::EvaluationContext ctx{state.marking(), &_net};
+            return _buchi_succ_gen.automaton().guard_valid(ctx, guard);
+        }
+
 
     private:
 
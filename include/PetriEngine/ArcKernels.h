@@ -0,0 +1,49 @@
+/* Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ARCKERNELS_H
+#define ARCKERNELS_H
+
+#include <cstdint>
+
+namespace PetriEngine {
+    /**
+     * Kernels over the structure-of-arrays arcs of PetriNet.
+     * Wide arc lists are handled by an AVX2 gather-and-compare when the CPU supports it,
+     * selected once at start-up; short lists and other CPUs use a plain loop.
+     */
+    namespace ArcKernels {
+        /** arc lists shorter than this are not worth a vector kernel */
+        constexpr uint32_t WIDE = 8;
+
+        bool coversWide(const uint32_t* marking, const uint32_t* places, const uint32_t* tokens, uint32_t n);
+
+        /** @return true if marking[places[i]] >= tokens[i] for all i < n */
+        inline bool covers(const uint32_t* marking, const uint32_t* places, const uint32_t* tokens, uint32_t n)
+        {
+            if (n >= WIDE)
+                return coversWide(marking, places, tokens, n);
+            for (uint32_t i = 0; i < n; ++i)
+                if (marking[places[i]] < tokens[i])
+                    return false;
+            return true;
+        }
+
+        /** true if coversWide uses AVX2 on this machine */
+        bool vectorised();
+    }
+}
+
+#endif // ARCKERNELS_H
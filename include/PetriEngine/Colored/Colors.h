@@ -27,6 +27,7 @@
 #include <utility>
 #include <vector>
 #include <unordered_map>
+#include <mutex>
 #include <iostream>
 #include <cassert>
 
@@ -193,7 +194,9 @@ namespace PetriEngine {
         class ProductType : public ColorType {
         private:
             std::vector<const ColorType*> _constituents;
+            // filled lazily, the lock lets concurrent unfolders share the type
             mutable std::unordered_map<size_t,Color> _cache;
+            mutable std::mutex _cache_lock;
 
         public:
             ProductType(const std::string& name = "Undefined") : ColorType(name) {}
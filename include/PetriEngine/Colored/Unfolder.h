@@ -32,25 +32,64 @@
 #include "PartitionBuilder.h"
 #include "SymmetryVisitor.h"
 #include "ForwardFixedPoint.h"
+#include "PetriEngine/PetriNet.h"
 #include "PetriEngine/PetriNetBuilder.h"
 #include "VariableSymmetry.h"
 
+#include <exception>
+
 
 namespace PetriEngine {
     class ColoredPetriNetBuilder;
     namespace Colored {
         class Unfolder {
         private:
+            // Transitions are unfolded in two steps: the bindings and arc weights are computed
+            // without touching the PT net (and may thus run on several threads), and are then
+            // added to it in the order of the colored transitions, which names the places.
+            // The unfolded bindings are handed to a sink, see BuilderSink in Unfolder.cpp.
+            struct UnfoldedArc {
+                uint32_t place;
+                uint32_t id;
+                const Colored::Color* color;
+                uint32_t weight;
+                bool input;
+                // the arc to the sum place of an inhibited place, color and id are unused
+                bool shadow;
+            };
+
+            struct UnfoldedTransition {
+                // the arcs of each binding, in the order the unfolded transitions are named
+                std::vector<std::vector<UnfoldedArc>> bindings;
+                bool fixpoint = false;
+                std::exception_ptr error;
+            };
+
+            class BuilderSink;
+            class NetSink;
+
             const ColoredPetriNetBuilder& _builder;
             void getArcIntervals(const Colored::Transition& transition, bool &transitionActivated, uint32_t max_intervals, uint32_t transitionId);
 
             void unfoldPlace(PetriNetBuilder& ptBuilder, const Colored::Place* place, const PetriEngine::Colored::Color *color, uint32_t unfoldPlace, uint32_t id);
-            void unfoldTransition(PetriNetBuilder& builder, uint32_t transitionId);
+            // the initial tokens of the unfolded place of the given color
+            size_t unfoldedTokens(const Colored::Place* place, const PetriEngine::Colored::Color *color, uint32_t placeId) const;
+            // calls f on each binding of the transition, in the order the unfolded transitions are named
+            template<typename F>
+            bool forEachBinding(uint32_t transitionId, F&& f) const;
+            void unfoldTransition(uint32_t transitionId, UnfoldedTransition& unfolded) const;
+            // hands the bindings of every transition to the sink, in the order of the colored transitions
+            template<typename Sink>
+            void unfoldTransitions(Sink& sink, uint32_t threads);
+            template<typename Sink>
+            void unfoldParallel(Sink& sink, uint32_t threads);
             void handleOrphanPlace(PetriNetBuilder& ptBuilder, const Colored::Place& place, const shared_name_index_map& unfoldedPlaceMap);
             void createPartionVarmaps();
             void unfoldInhibitorArc(PetriNetBuilder& ptBuilder, const shared_const_string &oldname, const shared_const_string &newname);
             std::string arc_to_string(const Colored::Arc& arc) const;
-            void unfoldArc(PetriNetBuilder& ptBuilder, const Colored::Arc& arc, const Colored::BindingMap& binding, const shared_const_string& name);
+            void unfoldArcs(const Colored::Transition& transition, const Colored::BindingMap& binding, std::vector<UnfoldedArc>& arcs) const;
+            void unfoldArc(const Colored::Arc& arc, const Colored::BindingMap& binding, std::vector<UnfoldedArc>& arcs) const;
+            void addArc(PetriNetBuilder& ptBuilder, const UnfoldedArc& arc, const shared_const_string& tName);
             double _time = 0;
             shared_place_color_map _ptplacenames;
             shared_name_name_map _pttransitionnames;
@@ -61,8 +100,6 @@ namespace PetriEngine {
             const ForwardFixedPoint& _fixed_point;
             
             bool _print_bindings;
-            std::unordered_map<std::string, Colored::BindingMap> _transitionBinding;
-            void storeBinding(const shared_const_string& name, const Colored::BindingMap& binding);
             
         public:
             Unfolder(const ColoredPetriNetBuilder& b, const PartitionBuilder& partition, const VariableSymmetry& symmetry, const ForwardFixedPoint& fixed_point, bool print_bindings)
@@ -72,7 +109,20 @@ namespace PetriEngine {
               _fixed_point(fixed_point),
               _print_bindings(print_bindings) {}
 
-            PetriNetBuilder unfold();
+            /**
+             * Unfolds the colored net. With more than one thread the bindings of the
+             * transitions are computed concurrently, the resulting net is the same.
+             */
+            PetriNetBuilder unfold(uint32_t threads = 1);
+
+            /**
+             * Unfolds the colored net straight into the compact PT net, without a PT builder
+             * and the string-keyed maps it keeps. Names are generated when the net is asked
+             * for them. The net is laid out as makePetriNet(false) lays out the sorted builder
+             * returned by unfold(), but place_names() and transition_names() are not filled,
+             * so queries cannot be unfolded against it. The net must be colored.
+             */
+            std::unique_ptr<PetriNet> unfoldNet(uint32_t threads = 1);
 
             size_t number_of_arcs() const { return _nptarcs; }
 
@@ -90,7 +140,12 @@ namespace PetriEngine {
 
             PetriNetBuilder strip_colors();
 
-        
+
+            /**
+             * Prints the binding of every unfolded transition. The bindings are not kept
+             * during unfolding but enumerated again, so the partition, symmetries and
+             * fixed point given to the constructor must still be alive.
+             */
             void printBinding();
 
 
@@ -43,6 +43,8 @@ namespace PetriEngine::ExplicitColored {
         [[nodiscard]] const SearchStatistics& GetSearchStatistics() const;
         std::optional<uint64_t> getCounterExampleId() const;
         std::optional<std::vector<InternalTraceStep>> getTraceTo(uint64_t counterExampleId) const;
+        // true if check() gave up as the memory budget was exhausted, its answer is then meaningless
+        [[nodiscard]] bool outOfMemory() const { return _outOfMemory; }
     private:
         std::shared_ptr<ExplicitQueryProposition> _gammaQuery;
         std::optional<uint64_t> _counterExampleId;
@@ -52,6 +54,7 @@ namespace PetriEngine::ExplicitColored {
         const size_t _seed;
         bool _fullStatespace = true;
         bool _createTrace;
+        bool _outOfMemory = false;
         StateMap _stateMap;
         SearchStatistics _searchStatistics;
         template <typename SuccessorGeneratorState>
@@ -7,8 +7,12 @@
 #include "Visitors/ConditionCopyVisitor.h"
 
 #include "ColoredResultPrinter.h"
+#include "ColorIgnorantPetriNetBuilder.h"
+#include "ExplicitColoredPetriNetBuilder.h"
 #include "Algorithms/ExplicitWorklist.h"
 
+#include <memory>
+
 namespace PetriEngine::ExplicitColored {
     class ExplicitColoredModelChecker {
     public:
@@ -22,25 +26,34 @@ namespace PetriEngine::ExplicitColored {
             : _stringSet(stringSet), _fullStatisticOut(fullStatisticOut)
             {}
 
-        Result checkQuery(
+        /**
+         * Reads the model and applies the colored reductions once, preserving all the given queries.
+         * The nets used by the LP pre-check and by the explicit search are built from the reduced
+         * model when first needed and are shared by all following calls to checkQuery.
+         */
+        void loadModel(
             const std::string& modelPath,
+            const std::vector<PQL::Condition_ptr>& queries,
+            options_t& options
+        );
+
+        /** Checks a query on the loaded model, the query must be among those given to loadModel */
+        Result checkQuery(
             const PQL::Condition_ptr& query,
             options_t& options,
             IColoredResultPrinter* resultPrinter
-        ) const;
+        );
     private:
         Result checkColorIgnorantLP(
-            const std::string& pnmlModel,
             const PQL::Condition_ptr& query,
             options_t& options
-        ) const;
+        );
 
         std::pair<Result, std::optional<std::vector<TraceStep>>> explicitColorCheck(
-            const std::string& pnmlModel,
             const PQL::Condition_ptr& query,
             options_t& options,
             SearchStatistics* searchStatistics
-        ) const;
+        );
 
         Result checkFireabilityColorIgnorantLP(
             const PQL::EvaluationContext& context,
@@ -62,7 +75,7 @@ namespace PetriEngine::ExplicitColored {
         void _reduce(
             const std::string& pnmlModel,
             std::stringstream& out,
-            const PQL::Condition_ptr& query,
+            const std::vector<PQL::Condition_ptr>& queries,
             options_t& options
         ) const;
 
@@ -82,6 +95,14 @@ namespace PetriEngine::ExplicitColored {
 
         shared_string_set& _stringSet;
         std::ostream& _fullStatisticOut;
+
+        // the reduced model, in PNML
+        std::string _pnmlModel;
+        // built from _pnmlModel on first use
+        std::unique_ptr<ColorIgnorantPetriNetBuilder> _ignorantBuilder;
+        std::unique_ptr<ExplicitColoredPetriNetBuilder> _explicitBuilder;
+        std::unique_ptr<ColoredPetriNet> _explicitNet;
+        ColoredPetriNetBuilderStatus _explicitStatus = ColoredPetriNetBuilderStatus::OK;
     };
 }
 #endif //EXPLICITCOLOREDMODELCHECKER_H
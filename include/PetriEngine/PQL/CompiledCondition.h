@@ -0,0 +1,130 @@
+/* Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VERIFYPN_COMPILEDCONDITION_H
+#define VERIFYPN_COMPILEDCONDITION_H
+
+#include "Expressions.h"
+#include "Contexts.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace PetriEngine { namespace PQL {
+
+    /** The distances of the atoms of a compiled query in one marking, see CompiledCondition::cache */
+    struct DistanceCache {
+        std::vector<uint32_t> _atoms;
+        // the values of the parent overwritten while the distance of a successor is computed
+        std::vector<uint32_t> _saved;
+    };
+
+    /**
+     * A prepared reachability query lowered to flat arrays, so that evaluate and distance
+     * can be computed on every explored marking without virtual calls over the expression tree.
+     *
+     * The boolean structure is kept as nodes in prefix order, each knowing where its subtree
+     * ends, and arithmetic is compiled to postfix code for a small value stack.
+     * Queries with constructs the compiler does not know (e.g. upper bounds or path
+     * quantifiers other than EF and AG) are evaluated on the tree instead, with the same results.
+     */
+    class CompiledCondition {
+    public:
+        CompiledCondition(const Condition_ptr& query, const PetriNet* net);
+
+        /** false if the query is evaluated on the tree */
+        bool compiled() const { return !_nodes.empty(); }
+
+        /** same as PQL::evaluate on the query */
+        Condition::Result evaluate(const MarkVal* marking) const;
+
+        /** same as Condition::distance on the query */
+        uint32_t distance(DistanceContext& context) const;
+
+        /**
+         * Index the atoms of the query by the transitions changing the places they read,
+         * so that the distance of a successor can be updated from the atoms of its parent.
+         * Not thread-safe; call before the condition is shared between searches.
+         */
+        void prepareIncremental();
+
+        /** false if the distance of a successor is computed from scratch */
+        bool incremental() const { return !_affectedOffset.empty(); }
+
+        /** store the distance of every atom in marking, for the distances of its successors */
+        void cache(const MarkVal* marking, DistanceCache& cache) const;
+
+        /**
+         * Same as distance on context, when its marking is reached by firing transition
+         * in the marking cache was filled for. Only the atoms reading a place changed by
+         * the transition are recomputed; cache is left as it was.
+         */
+        uint32_t distance(DistanceContext& context, DistanceCache& cache, uint32_t transition) const;
+
+    private:
+        enum op_t : uint8_t {
+            TRUE_OP, FALSE_OP, AND_OP, OR_OP, NOT_OP, EF_OP, AG_OP,
+            LT_OP, LE_OP, EQ_OP, NE_OP, CONJUNCTION_OP, DEADLOCK_OP
+        };
+
+        struct node_t {
+            op_t _op;
+            // index of the first node after the subtree of this one
+            uint32_t _next = 0;
+            // code of the operands of a comparison: [_lhs, _rhs) and [_rhs, _end)
+            uint32_t _lhs = 0, _rhs = 0, _end = 0;
+            const CompareConjunction* _conjunction = nullptr;
+            // whether the node is under an odd number of negations, and its index among the atoms
+            bool _negated = false;
+            uint32_t _atom = 0;
+        };
+
+        enum code_t : uint8_t {
+            CONSTANT, LOAD, SUM, PRODUCT, ADD, MULTIPLY, SUBTRACT, NEGATE
+        };
+
+        struct instr_t {
+            code_t _code;
+            // LOAD: a place; SUM/PRODUCT: a range of _places; ADD/MULTIPLY/SUBTRACT: the number of operands
+            uint32_t _arg = 0, _count = 0;
+            // CONSTANT: the value; SUM/PRODUCT: the constant of the expression
+            int64_t _value = 0;
+        };
+
+        static constexpr uint32_t MAX_STACK = 32;
+
+        bool compile(const Condition* condition);
+        bool compileExpr(const Expr* expr, uint32_t depth);
+        Condition::Result evaluate(uint32_t node, const MarkVal* marking) const;
+        uint32_t distance(uint32_t node, DistanceContext& context) const;
+        void indexAtoms(uint32_t node, bool negated);
+        uint32_t atomDistance(const node_t& n, const MarkVal* marking, bool negated) const;
+        uint32_t combine(uint32_t node, const std::vector<uint32_t>& atoms) const;
+        int64_t value(uint32_t begin, uint32_t end, const MarkVal* marking) const;
+
+        Condition_ptr _query;
+        const PetriNet* _net;
+        std::vector<node_t> _nodes;
+        std::vector<instr_t> _code;
+        std::vector<uint32_t> _places;
+        // the atom nodes, and per transition the range [_affectedOffset[t], _affectedOffset[t + 1]) of _affected
+        std::vector<uint32_t> _atoms;
+        std::vector<uint32_t> _affectedOffset;
+        std::vector<uint32_t> _affected;
+    };
+} }
+
+#endif //VERIFYPN_COMPILEDCONDITION_H
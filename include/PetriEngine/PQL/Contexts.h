@@ -34,11 +34,16 @@
 #include <list>
 #include <map>
 #include <chrono>
+#include <functional>
+#include <memory>
+#include <algorithm>
 #include <glpk.h>
 
 namespace PetriEngine {
 
     namespace PQL {
+        class CompiledCondition;
+        struct DistanceCache;
 
         /** Context provided for context analysis */
         class AnalysisContext {
@@ -150,11 +155,20 @@ namespace PetriEngine {
         public:
 
             DistanceContext(const PetriNet* net,
-                    const MarkVal* marking)
-            : EvaluationContext(marking, net) {
+                    const MarkVal* marking, const CompiledCondition* compiled = nullptr)
+            : EvaluationContext(marking, net), _compiled(compiled) {
                 _negated = false;
             }
 
+            /** the distance of query, computed by its compiled form if the context was given one */
+            uint32_t distance(const Condition* query);
+
+            /** the marking was reached by firing transition in the marking of cache, see CompiledCondition::cache */
+            void setParent(DistanceCache* cache, uint32_t transition) {
+                _parent = cache;
+                _transition = transition;
+            }
+
 
             void negate() {
                 _negated = !_negated;
@@ -166,6 +180,9 @@ namespace PetriEngine {
 
         private:
             bool _negated;
+            const CompiledCondition* _compiled;
+            DistanceCache* _parent = nullptr;
+            uint32_t _transition = 0;
         };
 
         /** Context for condition to TAPAAL export */
@@ -180,28 +197,9 @@ namespace PetriEngine {
 
             SimplificationContext(const MarkVal* marking,
                     const PetriNet* net, uint32_t queryTimeout, uint32_t lpTimeout,
-                    Simplification::LPCache* cache, uint32_t potencyTimeout = 0)
-                    : _queryTimeout(queryTimeout), _lpTimeout(lpTimeout),
-                    _potencyTimeout(potencyTimeout) {
-                _negated = false;
-                _marking = marking;
-                _net = net;
-                _base_lp = buildBase();
-                _start = std::chrono::high_resolution_clock::now();
-                _cache = cache;
-                _markingOutOfBounds = false;
-                for(size_t i = 0; i < net->numberOfPlaces(); ++i) {
-                    if (marking[i] >  std::numeric_limits<int32_t>::max()) { //too many tokens exceeding int32_t limits, LP solver will give wrong results
-                        _markingOutOfBounds = true;
-                    }
-                }
-            }
+                    Simplification::LPCache* cache, uint32_t potencyTimeout = 0);
 
-            virtual ~SimplificationContext() {
-                if(_base_lp != nullptr)
-                    glp_delete_prob(_base_lp);
-                _base_lp = nullptr;
-            }
+            virtual ~SimplificationContext();
 
 
             const MarkVal* marking() const {
@@ -250,15 +248,42 @@ namespace PetriEngine {
                 return _cache;
             }
 
-            glp_prob* makeBaseLP() const;
+            /**
+             * The state equation of the net, kept as one GLPK problem for the lifetime of the context.
+             * Callers append their query rows, solve, and remove the rows again with releaseLP().
+             * The basis left behind by a solve is where the next solve starts.
+             * @return nullptr if the problem could not be built before the timeout.
+             */
+            glp_prob* acquireLP() const;
+
+            /** removes every row added to the problem since acquireLP() */
+            void releaseLP(glp_prob* lp) const;
+
+            /** number of LPs of one query that may be solved concurrently */
+            uint32_t lpThreads() const { return _lpThreads; }
+            void setLPThreads(uint32_t threads) { _lpThreads = std::max<uint32_t>(threads, 1); }
+
+            /**
+             * Runs job concurrently on n worker contexts, the first on the calling thread, and
+             * waits for all of them. A worker has its own state equation problem and no LPCache,
+             * and shares the timeouts of this context. The worker threads and their problems are
+             * kept for the lifetime of this context, that is for the whole query.
+             */
+            void runWorkers(size_t n, const std::function<void(const SimplificationContext&)>& job) const;
 
         private:
+            struct lp_pool_t;
+
             bool _negated;
             const MarkVal* _marking;
             bool _markingOutOfBounds;
             const PetriNet* _net;
             uint32_t _queryTimeout, _lpTimeout, _potencyTimeout;
             mutable glp_prob* _base_lp = nullptr;
+            mutable int _base_rows = 0;
+            uint32_t _lpThreads = 1;
+            mutable std::vector<std::unique_ptr<SimplificationContext>> _workers;
+            mutable std::unique_ptr<lp_pool_t> _pool;
             std::chrono::high_resolution_clock::time_point _start;
             Simplification::LPCache* _cache;
 
@@ -990,6 +990,12 @@ namespace PetriEngine {
             std::string sopTAPAAL() const override;
         };
 
+        // defined in Expressions.cpp, also used by CompiledCondition
+        template<> uint32_t delta<EqualCondition>(int v1, int v2, bool negated);
+        template<> uint32_t delta<NotEqualCondition>(int v1, int v2, bool negated);
+        template<> uint32_t delta<LessThanCondition>(int v1, int v2, bool negated);
+        template<> uint32_t delta<LessThanOrEqualCondition>(int v1, int v2, bool negated);
+
         /* Bool condition */
         class BooleanCondition : public Condition {
         public:
@@ -23,8 +23,10 @@
 #include <string>
 #include <vector>
 #include <climits>
+#include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <iostream>
 
 #include "utils/structures/shared_string.h"
@@ -42,6 +44,10 @@ namespace PetriEngine {
     class PetriNetBuilder;
     class SuccessorGenerator;
 
+    namespace Colored {
+        class Unfolder;
+    }
+
     struct TransPtr {
         uint32_t inputs;
         uint32_t outputs;
@@ -62,6 +68,9 @@ namespace PetriEngine {
     class PetriNet {
         PetriNet(uint32_t transitions, uint32_t invariants, uint32_t places);
     public:
+        /** Names the place or transition with the given index, for nets built without names */
+        using name_oracle_t = std::function<std::string(uint32_t)>;
+
         ~PetriNet();
 
         uint32_t initial(size_t id) const;
@@ -88,21 +97,27 @@ namespace PetriEngine {
 
         const std::vector<shared_const_string>& transitionNames() const
         {
+            nameAll();
             return _transitionnames;
         }
 
         const std::vector<shared_const_string>& placeNames() const
         {
+            nameAll();
             return _placenames;
         }
 
+        /** The name of a single transition, without naming all of them in a net built without names */
+        shared_const_string transitionName(uint32_t t) const;
+        shared_const_string placeName(uint32_t p) const;
+
         void print(MarkVal const * const val) const
         {
             for(size_t i = 0; i < _nplaces; ++i)
             {
                 if(val[i] != 0)
                 {
-                    std::cout << *_placenames[i] << "(" << i << ")" << " -> " << val[i] << ", ";
+                    std::cout << *placeName(i) << "(" << i << ")" << " -> " << val[i] << ", ";
                 }
             }
             std::cout << std::endl;
@@ -116,6 +131,12 @@ namespace PetriEngine {
             return _initialMarking;
         }
 
+        /**
+         * Builds, once, the index of the transitions whose enabledness may change when a
+         * transition fires. Returns false if the index would be too large to keep.
+         */
+        bool affectedIndex() const;
+
         bool has_inhibitor() const {
             for (Invariant i : _invariants) {
                 if (i.inhibitor)
@@ -125,6 +146,11 @@ namespace PetriEngine {
         }
 
     private:
+        void computeDirections();
+        void computeDependents();
+        void computeArcLayout();
+        // fills the name vectors from the oracles, once
+        void nameAll() const;
 
         /** Number of x variables
          * @remarks We could also get this from the _places vector, but I don't see any
@@ -135,11 +161,30 @@ namespace PetriEngine {
         std::vector<TransPtr> _transitions;
         std::vector<Invariant> _invariants;
         std::vector<uint32_t> _placeToPtrs;
+        // the transitions with an input or inhibitor arc from place p are
+        // _dependents[_dependentPtrs[p] .. _dependentPtrs[p + 1]), their enabledness depends on p
+        std::vector<uint32_t> _dependentPtrs;
+        std::vector<uint32_t> _dependents;
+        // the transitions depending on a place whose marking t changes are
+        // _affected[_affectedPtrs[t] .. _affectedPtrs[t + 1]), ascending; built by affectedIndex()
+        mutable std::vector<uint32_t> _affectedPtrs;
+        mutable std::vector<uint32_t> _affected;
+        mutable std::once_flag _affectedOnce;
+        // the arcs of transition t as separate place and weight arrays, built by computeArcLayout():
+        // inputs are [_prePtrs[t], _prePtrs[t + 1]) of _prePlaces/_preTokens,
+        // inhibitors and outputs are laid out the same way in _inhib* and _post*
+        std::vector<uint32_t> _prePtrs, _prePlaces, _preTokens;
+        std::vector<uint32_t> _inhibPtrs, _inhibPlaces, _inhibTokens;
+        std::vector<uint32_t> _postPtrs, _postPlaces, _postTokens;
         std::vector<bool> _controllable;
         MarkVal* _initialMarking;
 
-        std::vector<shared_const_string> _transitionnames;
-        std::vector<shared_const_string> _placenames;
+        // empty until nameAll() for nets given name oracles instead
+        mutable std::vector<shared_const_string> _transitionnames;
+        mutable std::vector<shared_const_string> _placenames;
+        name_oracle_t _transitionOracle;
+        name_oracle_t _placeOracle;
+        mutable std::once_flag _named;
 
         std::vector< std::tuple<double, double> > _placelocations;
         std::vector< std::tuple<double, double> > _transitionlocations;
@@ -150,6 +195,7 @@ namespace PetriEngine {
         friend class ReducingSuccessorGenerator;
         friend class STSolver;
         friend class StubbornSet;
+        friend class Colored::Unfolder;
     };
 
 } // PetriEngine
@@ -0,0 +1,75 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include "Reachability/ReachabilityResult.h"
+#include "options.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace PetriEngine {
+
+    /**
+     * Races several engines on the reachability queries of one net.
+     *
+     * Each engine runs in its own thread on all open queries. The first
+     * definitive answer to a query is given to the printer and later ones are
+     * dropped; once every query is answered the engines are stopped through
+     * their stop flags, and give up at their next poll.
+     *
+     * Stubborn sets and TAR annotate the query trees while they search, so at
+     * most one engine may use them: TAR if it is in the portfolio, otherwise the
+     * first explicit search. The other explicit searches do without stubborn sets.
+     */
+    class Portfolio {
+    public:
+        Portfolio(PetriNet& net, Reachability::AbstractHandler& printer, options_t& options, Reducer* reducer)
+        : _net(net), _printer(printer), _options(options), _reducer(reducer) {}
+
+        /**
+         * Run the engines of options.portfolio until every query has an answer,
+         * or every engine has given up.
+         * @return true if every query was answered
+         */
+        bool solve(std::vector<PQL::Condition_ptr>& queries,
+                   std::vector<Reachability::ResultPrinter::Result>& results,
+                   const std::vector<MarkVal>& initPotencies = std::vector<MarkVal>());
+
+    private:
+        class handler_t;
+
+        void run(PortfolioEngine engine, bool annotate, size_t seed,
+                 std::vector<PQL::Condition_ptr>& queries,
+                 std::vector<Reachability::ResultPrinter::Result> results,
+                 const std::vector<MarkVal>& initPotencies);
+
+        PetriNet& _net;
+        Reachability::AbstractHandler& _printer;
+        options_t& _options;
+        Reducer* _reducer;
+
+        // guards the printer and the shared results
+        std::mutex _lock;
+        std::vector<Reachability::ResultPrinter::Result>* _results = nullptr;
+        std::atomic<bool> _stop{false};
+    };
+}
+
+#endif /* PORTFOLIO_H */
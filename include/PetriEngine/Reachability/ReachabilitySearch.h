@@ -23,17 +23,29 @@
 #include "../Structures/State.h"
 #include "ReachabilityResult.h"
 #include "../PQL/PQL.h"
+#include "../PQL/CompiledCondition.h"
 #include "../PetriNet.h"
 #include "../Structures/StateSet.h"
+#include "../Structures/ConcurrentStateSet.h"
+#include "../Structures/LossyStateSet.h"
+#include "../Structures/DiskStateSet.h"
 #include "../Structures/Queue.h"
 #include "../Structures/PotencyQueue.h"
+#include "../Structures/WorkStealingQueue.h"
+#include "StateSpaceCache.h"
 #include "../SuccessorGenerator.h"
 #include "../ReducingSuccessorGenerator.h"
 #include "PetriEngine/Stubborn/ReachabilityStubbornSet.h"
 
 #include "PetriEngine/options.h"
+#include "utils/MemoryBudget.h"
 
+#include <atomic>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
 #include <vector>
 
 
@@ -45,15 +57,19 @@ namespace PetriEngine {
         class ReachabilitySearch {
         public:
 
-            ReachabilitySearch(PetriNet& net, AbstractHandler& callback, int kbound = 0, bool early = false)
-            : _net(net), _kbound(kbound), _callback(callback) {
+            ReachabilitySearch(PetriNet& net, AbstractHandler& callback, int kbound = 0, bool early = false, uint32_t threads = 1)
+            : _net(net), _kbound(kbound), _callback(callback), _threads(std::max<uint32_t>(threads, 1)) {
             }
 
             virtual ~ReachabilitySearch()
             {
             }
 
-            /** Perform reachability check using BFS with hasing */
+            /**
+             * Perform reachability check using BFS with hasing.
+             * If the memory budget runs out while states are stored exactly, the search is
+             * restarted for the open queries with hash compaction and without a trace.
+             */
             bool reachable(
                     std::vector<std::shared_ptr<PQL::Condition > >& queries,
                     std::vector<ResultPrinter::Result>& results,
@@ -67,7 +83,65 @@ namespace PetriEngine {
                     const int64_t incRandomWalk = 5000,
                     const std::vector<MarkVal>& initPotencies = std::vector<MarkVal>());
             size_t maxTokens() const;
+
+            /**
+             * Answer the queries from the given state space instead of searching.
+             * The cache is explored first if it is not already; it is ignored if it belongs
+             * to another net or k-bound, or when a trace is requested.
+             */
+            void setStateSpaceCache(StateSpaceCache* cache)
+            {
+                _cache = cache;
+            }
+
+            /**
+             * Store visited markings by hash only (see LossyStateSet), or on disk (see DiskStateSet).
+             * Used by the sequential search when no trace is requested. With hash storage, queries
+             * that are not found satisfied are left unknown; disk storage always searches breadth first.
+             */
+            void setStateStorage(StateStorage storage, uint32_t bitstateBits = 30)
+            {
+                _storage = storage;
+                _bitstateBits = bitstateBits;
+            }
+
+            /** where, and with how many bytes of buffer, disk storage keeps its files */
+            void setDiskStorage(const std::string& directory, size_t buffer)
+            {
+                _diskDirectory = directory;
+                _diskBuffer = buffer;
+            }
+
+            /** once the flag is raised the search gives up, leaving the open queries unknown */
+            void setStopFlag(const std::atomic<bool>* stop)
+            {
+                _stop = stop;
+            }
+
+            /** true if the last search gave up because the memory budget was exhausted */
+            bool outOfMemory() const
+            {
+                return _outOfMemory;
+            }
         protected:
+            bool stopped() const
+            {
+                return _stop != nullptr && _stop->load(std::memory_order_relaxed);
+            }
+
+            bool _reachable(
+                    std::vector<std::shared_ptr<PQL::Condition > >& queries,
+                    std::vector<ResultPrinter::Result>& results,
+                    Strategy strategy,
+                    bool usestubborn,
+                    bool statespacesearch,
+                    StatisticsLevel printstats,
+                    bool keep_trace,
+                    size_t seed,
+                    int64_t depthRandomWalk,
+                    const int64_t incRandomWalk,
+                    const std::vector<MarkVal>& initPotencies);
+
             struct searchstate_t {
                 size_t expandedStates = 0;
                 size_t exploredStates = 1;
@@ -76,6 +150,20 @@ namespace PetriEngine {
                 bool usequeries;
             };
 
+            /** State shared between the workers of tryReachParallel */
+            struct parallelstate_t {
+                std::mutex lock; // guards results and the callback
+                std::atomic<bool> stop{false};
+                // states pushed to some worker but not yet fully expanded
+                std::atomic<int64_t> pending{0};
+                std::atomic<uint32_t> idle{0};
+                std::atomic<size_t> epoch{0};
+                std::atomic<size_t> expandedStates{0};
+                std::atomic<size_t> exploredStates{1};
+                std::atomic<bool> outOfMemory{false};
+                std::exception_ptr error = nullptr;
+            };
+
             template<typename W = Structures::RandomWalkStateSet, typename G>
             bool tryReachRandomWalk(
                 std::vector<std::shared_ptr<PQL::Condition > >& queries,
@@ -87,6 +175,17 @@ namespace PetriEngine {
                 const int64_t incRandomWalk,
                 const std::vector<MarkVal>& initPotencies);
 
+            template<typename W = Structures::RandomWalkStateSet, typename G>
+            bool tryReachRandomWalkParallel(
+                std::vector<std::shared_ptr<PQL::Condition > >& queries,
+                std::vector<ResultPrinter::Result>& results,
+                bool usequeries,
+                StatisticsLevel,
+                size_t seed,
+                int64_t depthRandomWalk,
+                const int64_t incRandomWalk,
+                const std::vector<MarkVal>& initPotencies);
+
             template<typename Q, typename W = Structures::StateSet, typename G>
             bool tryReach(
                 std::vector<std::shared_ptr<PQL::Condition > >& queries,
@@ -96,6 +195,35 @@ namespace PetriEngine {
                 size_t seed,
                 const std::vector<MarkVal>& initPotencies);
 
+            template<typename Q, typename G>
+            bool tryReachParallel(
+                std::vector<std::shared_ptr<PQL::Condition > >& queries,
+                std::vector<ResultPrinter::Result>& results,
+                bool usequeries,
+                StatisticsLevel statisticsLevel,
+                size_t seed,
+                const std::vector<MarkVal>& initPotencies);
+
+            template<typename G>
+            bool tryReachDisk(
+                std::vector<std::shared_ptr<PQL::Condition > >& queries,
+                std::vector<ResultPrinter::Result>& results,
+                bool usequeries,
+                StatisticsLevel statisticsLevel);
+
+            bool tryReachCached(
+                std::vector<std::shared_ptr<PQL::Condition > >& queries,
+                std::vector<ResultPrinter::Result>& results,
+                bool usequeries,
+                StatisticsLevel statisticsLevel);
+
+            bool checkQueriesParallel(std::vector<std::shared_ptr<PQL::Condition > >&,
+                              std::vector<ResultPrinter::Result>& results,
+                              std::vector<ResultPrinter::Result>& local,
+                              size_t& epoch, size_t& heurquery,
+                              Structures::State&, size_t id, parallelstate_t&,
+                              Structures::ConcurrentStateSet&);
+
             void printStats(searchstate_t& s, Structures::StateSetInterface*, StatisticsLevel);
 
             virtual bool checkQueries(std::vector<std::shared_ptr<PQL::Condition > >&,
@@ -114,6 +242,19 @@ namespace PetriEngine {
             Structures::State _initial;
             AbstractHandler& _callback;
             size_t _max_tokens = 0;
+            uint32_t _threads;
+            StateSpaceCache* _cache = nullptr;
+            StateStorage _storage = StateStorage::Exact;
+            uint32_t _bitstateBits = 30;
+            std::string _diskDirectory;
+            size_t _diskBuffer = size_t{1} << 30;
+            // set when the last search gave up because the memory budget was exhausted
+            bool _outOfMemory = false;
+            // false while retrying without the trace that was asked for
+            bool _traceable = true;
+            const std::atomic<bool>* _stop = nullptr;
+            // the queries of the current search, compiled for evaluation and distance
+            std::vector<PQL::CompiledCondition> _compiled;
         };
 
         template <typename G>
@@ -121,6 +262,12 @@ namespace PetriEngine {
             return G{net, queries};
         }
         template <>
+        inline SuccessorGenerator _makeSucGen(PetriNet &net, std::vector<PQL::Condition_ptr> &queries) {
+            SuccessorGenerator generator{net, queries};
+            generator.setIncremental(true);
+            return generator;
+        }
+        template <>
         inline ReducingSuccessorGenerator _makeSucGen(PetriNet &net, std::vector<PQL::Condition_ptr> &queries) {
             auto stubset = std::make_shared<ReachabilityStubbornSet>(net, queries);
             stubset->setInterestingVisitor<InterestingTransitionVisitor>();
@@ -149,7 +296,14 @@ namespace PetriEngine {
             state.setMarking(_net.makeInitialMarking());
             working.setMarking(_net.makeInitialMarking());
 
-            W states(_net, _kbound); // stateset
+            // stateset
+            constexpr bool lossy = std::is_same_v<W, Structures::LossyStateSet>;
+            auto states = [&]() -> W {
+                if constexpr (lossy)
+                    return W(_net, _kbound, _storage == StateStorage::Bitstate ? _bitstateBits : 0);
+                else
+                    return W(_net, _kbound);
+            }();
 
             Q queue(seed); // Working queue
             if constexpr (std::is_base_of_v<Structures::PotencyQueue, Q>) {
@@ -158,6 +312,7 @@ namespace PetriEngine {
             }
 
             G generator = _makeSucGen<G>(_net, queries); // successor generator
+            PQL::DistanceCache parent; // the distances of the atoms of the expanded state
             auto r = states.add(state);
             // this can fail due to reductions; we push tokens around and violate K
             if(r.first){
@@ -176,22 +331,39 @@ namespace PetriEngine {
                 }
                 // add initial to queue
                 {
-                    PQL::DistanceContext dc(&_net, working.marking());
+                    PQL::DistanceContext dc(&_net, working.marking(), &_compiled[ss.heurquery]);
                     queue.push(r.second, &dc, queries[ss.heurquery].get());
                 }
 
                 // Search!
                 for(auto nid = queue.pop(); nid != Structures::Queue::EMPTY; nid = queue.pop()) {
+                    if (MemoryBudget::exhausted()) {
+                        _outOfMemory = true;
+                        break;
+                    }
+                    if (stopped())
+                        break;
                     states.decode(state, nid);
+                    generator.expanding(nid);
                     generator.prepare(&state);
+                    // the query the atoms of state are cached for, once it has a new successor
+                    size_t cached = queries.size();
 
                     while(generator.next(working)){
                         ss.enabledTransitionsCount[generator.fired()]++;
                         auto res = states.add(working);
                         // If we have not seen this state before
                         if (res.first) {
+                            generator.stored(res.second);
                             {
-                                PQL::DistanceContext dc(&_net, working.marking());
+                                PQL::DistanceContext dc(&_net, working.marking(), &_compiled[ss.heurquery]);
+                                if (_compiled[ss.heurquery].incremental()) {
+                                    if (cached != ss.heurquery) {
+                                        _compiled[ss.heurquery].cache(state.marking(), parent);
+                                        cached = ss.heurquery;
+                                    }
+                                    dc.setParent(&parent, generator.fired());
+                                }
                                 if constexpr (std::is_same_v<Q, Structures::RandomPotencyQueue>)
                                     queue.push(res.second, &dc, queries[ss.heurquery].get(), generator.fired());
                                 else
@@ -213,20 +385,453 @@ namespace PetriEngine {
             }
 
             // no more successors, print last results
+            // (unless states may have been skipped, in which case nothing is proven unreachable)
             for(size_t i= 0; i < queries.size(); ++i)
             {
-                if(results[i] == ResultPrinter::Unknown)
+                if(results[i] == ResultPrinter::Unknown && !lossy && !_outOfMemory && !stopped())
                 {
                     results[i] = doCallback(queries[i], i, ResultPrinter::NotSatisfied, ss, &states).first;
                 }
             }
 
             if(statisticsLevel != StatisticsLevel::None)
+            {
+                if(_outOfMemory)
+                    std::cout << "Search stopped, the memory budget of " << (MemoryBudget::limit() >> 20)
+                              << " MB was exhausted" << std::endl;
+                else if constexpr (lossy)
+                    std::cout << "Search inconclusive, " << (states.bitstate() ? "bitstate hashing" : "hash compaction")
+                              << " may have skipped states (" << states.memory() << " bytes of hashes)" << std::endl;
                 printStats(ss, &states, statisticsLevel);
+            }
             _max_tokens = states.maxTokens();
             return false;
         }
 
+        template<typename Q, typename G>
+        bool ReachabilitySearch::tryReachParallel(std::vector<std::shared_ptr<PQL::Condition> >& queries,
+                                        std::vector<ResultPrinter::Result>& results, bool usequeries,
+                                        StatisticsLevel statisticsLevel, size_t seed,
+                                        const std::vector<MarkVal>& initPotencies)
+        {
+            // how many states a busy worker hands over when some worker is idle
+            constexpr size_t share_batch = 32;
+            // how often worker-local counters are published
+            constexpr size_t flush_interval = 1024;
+
+            searchstate_t ss;
+            ss.enabledTransitionsCount.resize(_net.numberOfTransitions(), 0);
+            ss.expandedStates = 0;
+            ss.exploredStates = 1;
+            ss.heurquery = queries.size() >= 2 ? std::rand() % queries.size() : 0;
+            ss.usequeries = usequeries;
+
+            _initial.setMarking(_net.makeInitialMarking());
+            Structures::ConcurrentStateSet states(_net, _kbound, _threads);
+            std::vector<Structures::WorkStealingQueue<>> shared(_threads);
+            std::vector<std::vector<size_t>> fired(_threads);
+            parallelstate_t par;
+
+            {
+                Structures::State initial;
+                initial.setMarking(_net.makeInitialMarking());
+                auto r = states.add(initial);
+                // this can fail due to reductions; we push tokens around and violate K
+                if (r.first) {
+                    _satisfyingMarking = r.second;
+                    if (ss.usequeries && checkQueries(queries, results, initial, ss, &states)) {
+                        if(statisticsLevel != StatisticsLevel::None)
+                            printStats(ss, &states, statisticsLevel);
+                        _max_tokens = states.maxTokens();
+                        return true;
+                    }
+                    par.pending = 1;
+                    shared[0].push(r.second);
+                }
+            }
+
+            auto worker = [&](uint32_t wid) {
+                try {
+                    Structures::State state;
+                    Structures::State working;
+                    state.setMarking(_net.makeInitialMarking());
+                    working.setMarking(_net.makeInitialMarking());
+
+                    Q queue(seed + wid);
+                    if constexpr (std::is_base_of_v<Structures::PotencyQueue, Q>) {
+                        if (!initPotencies.empty())
+                            queue = Q(initPotencies, seed + wid);
+                    }
+                    G generator = _makeSucGen<G>(_net, queries);
+                    PQL::DistanceCache parent;
+                    std::default_random_engine rng(seed + wid);
+
+                    std::vector<ResultPrinter::Result> local;
+                    size_t epoch = 0;
+                    size_t heurquery = ss.heurquery;
+                    {
+                        std::lock_guard<std::mutex> guard(par.lock);
+                        local = results;
+                        epoch = par.epoch;
+                    }
+                    auto& firedCount = fired[wid];
+                    firedCount.resize(_net.numberOfTransitions(), 0);
+                    std::vector<size_t> stolen;
+                    size_t expanded = 0;
+                    size_t explored = 0;
+                    bool idle = false;
+
+                    while (!par.stop.load(std::memory_order_relaxed)) {
+                        if (MemoryBudget::exhausted()) {
+                            par.outOfMemory = true;
+                            par.stop = true;
+                            break;
+                        }
+                        if (stopped()) {
+                            par.stop = true;
+                            break;
+                        }
+                        size_t nid = Structures::Queue::EMPTY;
+                        if (!stolen.empty()) {
+                            nid = stolen.back();
+                            stolen.pop_back();
+                        }
+                        if (nid == Structures::Queue::EMPTY) nid = queue.pop();
+                        if (nid == Structures::Queue::EMPTY) nid = shared[wid].pop();
+                        if (nid == Structures::Queue::EMPTY) {
+                            // try to steal from the other workers, starting at a random victim
+                            size_t offset = rng();
+                            for (size_t i = 1; i < _threads && stolen.empty(); ++i) {
+                                shared[(wid + offset + i) % _threads].steal(stolen, share_batch);
+                            }
+                            if (!stolen.empty()) continue;
+                            if (!idle) {
+                                idle = true;
+                                ++par.idle;
+                            }
+                            if (par.pending.load() == 0)
+                                break;
+                            std::this_thread::yield();
+                            continue;
+                        }
+                        if (idle) {
+                            idle = false;
+                            --par.idle;
+                        }
+
+                        states.decode(state, nid);
+                        generator.prepare(&state);
+                        size_t cached = queries.size();
+                        int64_t produced = 0;
+                        while (generator.next(working)) {
+                            ++firedCount[generator.fired()];
+                            auto res = states.add(working);
+                            if (!res.first)
+                                continue;
+                            {
+                                PQL::DistanceContext dc(&_net, working.marking(), &_compiled[heurquery]);
+                                if (_compiled[heurquery].incremental()) {
+                                    if (cached != heurquery) {
+                                        _compiled[heurquery].cache(state.marking(), parent);
+                                        cached = heurquery;
+                                    }
+                                    dc.setParent(&parent, generator.fired());
+                                }
+                                if constexpr (std::is_same_v<Q, Structures::RandomPotencyQueue>)
+                                    queue.push(res.second, &dc, queries[heurquery].get(), generator.fired());
+                                else
+                                    queue.push(res.second, &dc, queries[heurquery].get());
+                            }
+                            ++produced;
+                            ++explored;
+                            if (ss.usequeries &&
+                                checkQueriesParallel(queries, results, local, epoch, heurquery, working, res.second, par, states)) {
+                                par.stop = true;
+                                break;
+                            }
+                        }
+                        // children are accounted for before the parent is retired
+                        par.pending.fetch_add(produced - 1);
+                        ++expanded;
+
+                        if (par.idle.load(std::memory_order_relaxed) > 0 && shared[wid].empty()) {
+                            for (size_t i = 0; i < share_batch; ++i) {
+                                auto id = queue.pop();
+                                if (id == Structures::Queue::EMPTY) break;
+                                shared[wid].push(id);
+                            }
+                        }
+                        if (expanded == flush_interval) {
+                            par.expandedStates += expanded;
+                            par.exploredStates += explored;
+                            expanded = explored = 0;
+                        }
+                    }
+                    par.expandedStates += expanded;
+                    par.exploredStates += explored;
+                } catch (...) {
+                    std::lock_guard<std::mutex> guard(par.lock);
+                    if (!par.error)
+                        par.error = std::current_exception();
+                    par.stop = true;
+                }
+            };
+
+            if (par.pending > 0) {
+                std::vector<std::thread> workers;
+                for (uint32_t wid = 1; wid < _threads; ++wid)
+                    workers.emplace_back(worker, wid);
+                worker(0);
+                for (auto& t : workers)
+                    t.join();
+            }
+
+            if (par.error)
+                std::rethrow_exception(par.error);
+            states.collect();
+
+            ss.expandedStates = par.expandedStates;
+            ss.exploredStates = par.exploredStates;
+            for (auto& f : fired)
+                for (size_t t = 0; t < f.size(); ++t)
+                    ss.enabledTransitionsCount[t] += f[t];
+
+            if (!par.stop) {
+                // no more successors, print last results
+                for(size_t i= 0; i < queries.size(); ++i)
+                {
+                    if(results[i] == ResultPrinter::Unknown)
+                    {
+                        results[i] = doCallback(queries[i], i, ResultPrinter::NotSatisfied, ss, &states).first;
+                    }
+                }
+            }
+
+            _outOfMemory = par.outOfMemory;
+            if(statisticsLevel != StatisticsLevel::None)
+            {
+                if(_outOfMemory)
+                    std::cout << "Search stopped, the memory budget of " << (MemoryBudget::limit() >> 20)
+                              << " MB was exhausted" << std::endl;
+                printStats(ss, &states, statisticsLevel);
+            }
+            _max_tokens = states.maxTokens();
+            return par.stop && !_outOfMemory && !stopped();
+        }
+
+        template<typename G>
+        bool ReachabilitySearch::tryReachDisk(std::vector<std::shared_ptr<PQL::Condition> >& queries,
+                                              std::vector<ResultPrinter::Result>& results, bool usequeries,
+                                              StatisticsLevel statisticsLevel)
+        {
+            searchstate_t ss;
+            ss.enabledTransitionsCount.resize(_net.numberOfTransitions(), 0);
+            ss.expandedStates = 0;
+            ss.exploredStates = 1;
+            ss.heurquery = queries.size() >= 2 ? std::rand() % queries.size() : 0;
+            ss.usequeries = usequeries;
+
+            Structures::State state;
+            Structures::State working;
+            _initial.setMarking(_net.makeInitialMarking());
+            state.setMarking(_net.makeInitialMarking());
+            working.setMarking(_net.makeInitialMarking());
+
+            Structures::DiskStateSet states(_net, _kbound, _diskDirectory, _diskBuffer);
+            G generator = _makeSucGen<G>(_net, queries);
+
+            // this can fail due to reductions; we push tokens around and violate K
+            if(states.add(state))
+            {
+                // the queries are checked on the markings of a layer as they are expanded
+                for(states.nextLayer(); ; )
+                {
+                    while(!stopped() && states.next(state))
+                    {
+                        if(checkQueries(queries, results, state, ss, &states))
+                        {
+                            if(statisticsLevel != StatisticsLevel::None)
+                                printStats(ss, &states, statisticsLevel);
+                            _max_tokens = states.maxTokens();
+                            return true;
+                        }
+                        generator.prepare(&state);
+                        while(generator.next(working))
+                        {
+                            ss.enabledTransitionsCount[generator.fired()]++;
+                            states.add(working);
+                        }
+                        ss.expandedStates++;
+                    }
+                    if(stopped())
+                        break;
+                    auto fresh = states.nextLayer();
+                    if(fresh == 0)
+                        break;
+                    ss.exploredStates += fresh;
+                }
+            }
+
+            // no more successors, print last results
+            for(size_t i= 0; i < queries.size(); ++i)
+            {
+                if(results[i] == ResultPrinter::Unknown && !stopped())
+                {
+                    results[i] = doCallback(queries[i], i, ResultPrinter::NotSatisfied, ss, &states).first;
+                }
+            }
+
+            if(statisticsLevel != StatisticsLevel::None)
+                printStats(ss, &states, statisticsLevel);
+            _max_tokens = states.maxTokens();
+            return false;
+        }
+
+        template<typename W, typename G>
+        bool ReachabilitySearch::tryReachRandomWalkParallel(std::vector<std::shared_ptr<PQL::Condition> >& queries,
+                                                            std::vector<ResultPrinter::Result>& results, bool usequeries,
+                                                            StatisticsLevel statisticsLevel, size_t seed,
+                                                            int64_t depthRandomWalk, const int64_t incRandomWalk,
+                                                            const std::vector<MarkVal>& initPotencies)
+        {
+            constexpr bool traced = std::is_same_v<W, Structures::TracableRandomWalkStateSet>;
+            size_t heurquery = queries.size() >= 2 ? std::rand() % queries.size() : 0;
+            const PQL::Condition *query = queries[heurquery].get();
+            _initial.setMarking(_net.makeInitialMarking());
+
+            // one state set per walker, each with its own seed
+            std::vector<std::unique_ptr<W>> walkers;
+            for (uint32_t wid = 0; wid < _threads; ++wid)
+                walkers.emplace_back(std::make_unique<W>(_net, _kbound, query, initPotencies, seed + wid));
+            std::vector<std::atomic<uint32_t>> potencies(_net.numberOfTransitions());
+            for (size_t t = 0; t < potencies.size(); ++t)
+                potencies[t] = walkers[0]->potencies()[t];
+
+            std::vector<searchstate_t> states(_threads);
+            for (auto& ss : states) {
+                ss.enabledTransitionsCount.resize(_net.numberOfTransitions(), 0);
+                ss.heurquery = heurquery;
+                ss.usequeries = usequeries;
+            }
+
+            // Check initial marking
+            if (usequeries && checkQueries(queries, results, _initial, states[0], walkers[0].get())) {
+                if (statisticsLevel != StatisticsLevel::None)
+                    printStats(states[0], walkers[0].get(), statisticsLevel);
+                _max_tokens = walkers[0]->maxTokens();
+                return true;
+            }
+            if constexpr (traced) {
+                // Not to be 0 in case of a printTrace call
+                _satisfyingMarking = 1;
+            }
+
+            parallelstate_t par;
+            auto walker = [&](uint32_t wid) {
+                try {
+                    auto& states_ = *walkers[wid];
+                    auto& ss = states[wid];
+                    G generator = _makeSucGen<G>(_net, queries);
+                    Structures::State candidate;
+                    Structures::State currentStepState;
+                    candidate.setMarking(_net.makeInitialMarking());
+                    currentStepState.setMarking(_net.makeInitialMarking());
+
+                    std::vector<ResultPrinter::Result> local;
+                    size_t epoch = 0;
+                    {
+                        std::lock_guard<std::mutex> guard(par.lock);
+                        local = results;
+                    }
+                    // only take the lock when the candidate answers an open query
+                    auto satisfies = [&](const Structures::State& state) {
+                        if (par.epoch.load() != epoch) {
+                            std::lock_guard<std::mutex> guard(par.lock);
+                            local = results;
+                            epoch = par.epoch;
+                        }
+                        for (size_t i = 0; i < queries.size(); ++i)
+                            if (local[i] == ResultPrinter::Unknown &&
+                                _compiled[i].evaluate(state.marking()) == PQL::Condition::RTRUE)
+                                return true;
+                        return false;
+                    };
+
+                    int64_t depth = depthRandomWalk;
+                    const int64_t maxDepthValue = std::numeric_limits<int64_t>::max() - incRandomWalk;
+                    while (!par.stop.load(std::memory_order_relaxed) && !stopped()) {
+                        states_.exchangePotencies(potencies);
+                        states_.newWalk();
+
+                        for (int64_t stepCounter = 0; stepCounter < depth && !par.stop.load(std::memory_order_relaxed) && !stopped(); ++stepCounter) {
+                            if (!states_.nextStep(currentStepState.marking()))
+                                break;
+                            generator.prepare(&currentStepState);
+                            if constexpr (traced)
+                                states_.addStepTrace();
+
+                            while (generator.next(candidate)) {
+                                ss.enabledTransitionsCount[generator.fired()]++;
+                                ss.exploredStates++;
+
+                                if constexpr (traced) {
+                                    states_.savePreviousTransition();
+                                    states_.setHistory(static_cast<size_t>(generator.fired()));
+                                }
+
+                                if (usequeries && satisfies(candidate)) {
+                                    std::lock_guard<std::mutex> guard(par.lock);
+                                    if (!par.stop && checkQueries(queries, results, candidate, ss, &states_)) {
+                                        par.stop = true;
+                                        break;
+                                    }
+                                    ++par.epoch;
+                                }
+                                bool chosen = states_.computeCandidate(candidate.marking(), query, generator.fired());
+                                if constexpr (traced) {
+                                    if (!chosen)
+                                        states_.setHistory(states_.getPreviousTransition());
+                                }
+                            }
+                            ss.expandedStates++;
+                        }
+                        if (depth < maxDepthValue)
+                            depth += incRandomWalk;
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> guard(par.lock);
+                    if (!par.error)
+                        par.error = std::current_exception();
+                    par.stop = true;
+                }
+            };
+
+            std::vector<std::thread> threads;
+            for (uint32_t wid = 1; wid < _threads; ++wid)
+                threads.emplace_back(walker, wid);
+            walker(0);
+            for (auto& t : threads)
+                t.join();
+            if (par.error)
+                std::rethrow_exception(par.error);
+
+            searchstate_t total;
+            total.enabledTransitionsCount.resize(_net.numberOfTransitions(), 0);
+            total.exploredStates = 1;
+            _max_tokens = 0;
+            for (uint32_t wid = 0; wid < _threads; ++wid) {
+                total.expandedStates += states[wid].expandedStates;
+                total.exploredStates += states[wid].exploredStates - 1;
+                for (size_t t = 0; t < total.enabledTransitionsCount.size(); ++t)
+                    total.enabledTransitionsCount[t] += states[wid].enabledTransitionsCount[t];
+                _max_tokens = std::max<size_t>(_max_tokens, walkers[wid]->maxTokens());
+            }
+            // the place bounds are those seen by the first walker
+            if (statisticsLevel != StatisticsLevel::None)
+                printStats(total, walkers[0].get(), statisticsLevel);
+            return !stopped();
+        }
+
         template<typename W, typename G>
         bool ReachabilitySearch::tryReachRandomWalk(std::vector<std::shared_ptr<PQL::Condition> >& queries,
                                                     std::vector<ResultPrinter::Result>& results, bool usequeries,
@@ -271,12 +876,12 @@ namespace PetriEngine {
             }
 
             const int64_t maxDepthValue = std::numeric_limits<int64_t>::max() - incRandomWalk;
-            while(true) {
+            while(!stopped()) {
                 // Start a new random walk
                 states.newWalk();
 
                 // Search! Each turn is a random step
-                for(int stepCounter = 0; stepCounter < depthRandomWalk; ++stepCounter) {
+                for(int stepCounter = 0; stepCounter < depthRandomWalk && !stopped(); ++stepCounter) {
                     // The currentStepMarking is the nextMarking computed in the previous step
                     if (!states.nextStep(currentStepState.marking())) {
                         // No candidate found at the previous step, do a new walk
@@ -330,7 +935,7 @@ namespace PetriEngine {
             // no more successors, print last results
             for(size_t i= 0; i < queries.size(); ++i)
             {
-                if(results[i] == ResultPrinter::Unknown)
+                if(results[i] == ResultPrinter::Unknown && !stopped())
                 {
                     results[i] = doCallback(queries[i], i, ResultPrinter::NotSatisfied, ss, &states).first;
                 }
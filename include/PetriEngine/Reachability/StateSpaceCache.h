@@ -0,0 +1,107 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef STATESPACECACHE_H
+#define STATESPACECACHE_H
+
+#include "../PetriNet.h"
+#include "../Structures/State.h"
+#include "../Structures/StateSet.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace PetriEngine {
+    namespace Reachability {
+
+        /**
+         * The full state space of a net, explored once and shared by all the
+         * queries solved on that net afterwards.
+         *
+         * The markings are kept in a state set and the successor relation is kept in
+         * compressed rows indexed by marking id, so reachability queries can be answered
+         * by a scan of the markings and CTL can follow the stored edges instead of
+         * firing transitions again.
+         *
+         * The cache is built lazily by the first query asking for it (see build());
+         * afterwards it is read-only. Decoding and lookup share the encoder of the state
+         * set and are serialised by a lock, so the cache may be used by concurrent queries.
+         *
+         * Markings exceeding the k-bound are left out, exactly as in ReachabilitySearch.
+         */
+        class StateSpaceCache {
+        public:
+            StateSpaceCache(const PetriNet& net, uint32_t kbound)
+            : _net(net), _kbound(kbound), _states(net, kbound) {}
+
+            /**
+             * Explores the state space, unless it already was.
+             * Blocks while another thread is exploring.
+             * @return false if the exploration was stopped before it was complete.
+             */
+            bool build(const std::atomic<bool>* stop = nullptr);
+
+            /** true if the cache stores the state space of net under kbound */
+            bool covers(const PetriNet& net, uint32_t kbound) const
+            {
+                return &net == &_net && kbound == _kbound;
+            }
+
+            bool complete() const { return _complete; }
+
+            size_t size() const { return _offsets.empty() ? 0 : _offsets.size() - 1; }
+
+            size_t edges() const { return _targets.size(); }
+
+            /** the marking ids are assigned in breadth-first order, the initial marking is 0 */
+            void decode(Structures::State& state, size_t id);
+
+            /** @return the id of marking, if it is stored */
+            std::pair<bool, size_t> lookup(Structures::State& state);
+
+            /** the targets of the edges leaving marking id */
+            std::pair<const size_t*, const size_t*> successors(size_t id) const
+            {
+                return {_targets.data() + _offsets[id], _targets.data() + _offsets[id + 1]};
+            }
+
+            /** the transitions labelling the edges leaving marking id, in the order of successors(id) */
+            const uint32_t* transitions(size_t id) const
+            {
+                return _transitions.data() + _offsets[id];
+            }
+
+            Structures::StateSetInterface& states() { return _states; }
+
+        private:
+            const PetriNet& _net;
+            const uint32_t _kbound;
+            Structures::StateSet _states;
+            // edges of marking i are [_offsets[i], _offsets[i + 1])
+            std::vector<size_t> _offsets;
+            std::vector<size_t> _targets;
+            std::vector<uint32_t> _transitions;
+            std::atomic<bool> _complete{false};
+            std::mutex _build_lock;
+            std::mutex _lock;
+        };
+    }
+}
+
+#endif // STATESPACECACHE_H
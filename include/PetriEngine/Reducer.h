@@ -88,6 +88,39 @@ namespace PetriEngine {
         size_t weight;
    };
 
+    /**
+     * The places (or transitions) a reduction rule has to examine on its next sweep,
+     * because their neighbourhood changed since the rule last looked at them.
+     * Initially, and after reset(), every id is queued.
+     */
+    class ReductionWorklist {
+    public:
+        void reset()
+        {
+            _all = true;
+            _ids.clear();
+            _queued.clear();
+        }
+
+        void push(uint32_t id)
+        {
+            if(_all) return;
+            if(id >= _queued.size())
+                _queued.resize(id + 1, false);
+            if(_queued[id]) return;
+            _queued[id] = true;
+            _ids.push_back(id);
+        }
+
+        /** Empties the worklist, returning the queued ids below n in increasing order */
+        std::vector<uint32_t> take(uint32_t n);
+
+    private:
+        std::vector<uint32_t> _ids;
+        std::vector<bool> _queued;
+        bool _all = true;
+    };
+
     class Reducer {
     public:
         Reducer(PetriNetBuilder*);
@@ -187,6 +220,15 @@ namespace PetriEngine {
         void skipInArc(uint32_t, uint32_t);
         void skipOutArc(uint32_t, uint32_t);
 
+        // Queue what the incremental rules (A, B, EP, F and G) have to re-examine after the net changed.
+        // A and B look one step beyond the candidate, so changing an arc queues the surroundings of both ends.
+        void queuePlace(uint32_t place);
+        void queueTransition(uint32_t transition);
+        void touchArc(uint32_t place, uint32_t transition);
+        void touchPlace(uint32_t place);
+        void touchTransition(uint32_t transition);
+        void touchAll();
+
         shared_const_string newTransName();
 
         bool consistent();
@@ -208,6 +250,7 @@ namespace PetriEngine {
         std::vector<uint8_t> _tflags;
         std::vector<uint8_t> _pflags;
         std::vector<uint32_t> _lower;
+        ReductionWorklist _workA, _workB, _workEP, _workF, _workG;
         size_t _tnameid = 0;
     };
 }
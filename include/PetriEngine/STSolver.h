@@ -4,6 +4,7 @@
 #include "Reachability/ReachabilityResult.h"
 #include "TAR/AntiChain.h"
 
+#include <atomic>
 #include <memory>
 #include <chrono>
 
@@ -24,10 +25,12 @@ namespace PetriEngine {
     };
         
     public:
-        STSolver(Reachability::ResultPrinter& printer, const PetriNet& net, PQL::Condition * query, uint32_t depth);
+        STSolver(Reachability::AbstractHandler& printer, const PetriNet& net, PQL::Condition * query, uint32_t depth, size_t index = 0);
         virtual ~STSolver();
         bool solve(uint32_t timeout);
         Reachability::ResultPrinter::Result printResult();
+        /** once the flag is raised, solve gives up as if it had timed out */
+        void setStopFlag(const std::atomic<bool>* stop) { _stop = stop; }
         
     private:    
         size_t computeTrap(std::vector<size_t>& siphon, const std::set<size_t>& pre, const std::set<size_t>& post, size_t marked_count);
@@ -37,8 +40,9 @@ namespace PetriEngine {
         void constructPrePost();
         void extend(size_t place, std::set<size_t>& pre, std::set<size_t>& post);
         bool _siphonPropperty = false;
-        Reachability::ResultPrinter& printer;
+        Reachability::AbstractHandler& printer;
         PQL::Condition * _query;
+        size_t _index;
         std::unique_ptr<place_t[]> _places;
         std::unique_ptr<uint32_t[]> _transitions;
         std::vector<size_t> _diff;
@@ -49,6 +53,7 @@ namespace PetriEngine {
         uint32_t _analysisTime;
         std::chrono::high_resolution_clock::time_point _start;
         AntiChain<size_t, size_t> _antichain;
+        const std::atomic<bool>* _stop = nullptr;
     };
 }
 #endif /* STSOLVER_H */
@@ -9,6 +9,7 @@
 #define LPFACTORY_H
 
 #include <vector>
+#include <unordered_map>
 #include <unordered_set>
 #include <memory>
 #include "MurmurHash2.h"
@@ -19,7 +20,7 @@
 namespace PetriEngine {
     namespace Simplification {
         class LinearProgram;
-
+        struct equation_t;
 
         class LPCache {
         public:
@@ -42,9 +43,33 @@ namespace PetriEngine {
             }
 
 
+            /**
+             * Feasibility of the equation systems solved so far, shared by all queries using this cache.
+             * A system is infeasible if it contains a known infeasible system with bounds that are
+             * at least as tight, and feasible if it is contained in a known feasible system with
+             * bounds that are at most as tight.
+             * Results are only valid for one net and initial marking; binding to another clears them.
+             */
+            void bind(const void* net, const void* marking);
+            bool knownInfeasible(const std::vector<equation_t>& equations) const;
+            bool knownFeasible(const std::vector<equation_t>& equations) const;
+            void addInfeasible(const std::vector<equation_t>& equations);
+            void addFeasible(const std::vector<equation_t>& equations);
+
         private:
             // unordered_map does not invalidate on insert, only erase
             std::unordered_set<Vector> vectors;
+
+            struct bound_t {
+                const Vector* row;
+                double lower, upper;
+            };
+            using system_t = std::vector<bound_t>;
+            const void* _net = nullptr;
+            const void* _marking = nullptr;
+            // infeasible systems are indexed by their first row, feasible systems by all of their rows
+            std::vector<system_t> _infeasible, _feasible;
+            std::unordered_map<const Vector*, std::vector<uint32_t>> _infeasible_by_first, _feasible_by_row;
         };
 
     }
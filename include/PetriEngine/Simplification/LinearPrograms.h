@@ -81,6 +81,9 @@ namespace PetriEngine {
             uint32_t explorePotencyImpl(const PQL::SimplificationContext& context,
                                         std::vector<uint32_t> &potencies,
                                         uint32_t maxConfigurationsSolved) override;
+#ifdef VERIFYPN_MC_Simplification
+            void satisfiableParallel(const PQL::SimplificationContext& context, uint32_t solvetime);
+#endif
 
         public:
             MergeCollection(const AbstractProgramCollection_ptr& A, const AbstractProgramCollection_ptr& B);
@@ -0,0 +1,111 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BUCKETQUEUE_H
+#define BUCKETQUEUE_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace PetriEngine {
+    namespace Structures {
+
+        /**
+         * Priority queue for small integer weights, lowest weight first.
+         *
+         * Weights below MAX_BUCKETS get a bucket each, so push is O(1) and pop
+         * only scans past buckets that were emptied. Within a bucket the last
+         * item pushed is popped first; as state ids are handed out in increasing
+         * order this is the same depth-first tie-breaking as the heaps it replaces.
+         * The rare larger weights go to a heap, and are popped once the buckets
+         * are empty.
+         *
+         * Buckets are never released, so a queue costs up to MAX_BUCKETS empty
+         * vectors (1.5MB); keep one per search, not one per transition.
+         */
+        template<typename T = size_t>
+        class BucketQueue {
+        public:
+            static constexpr uint32_t MAX_BUCKETS = 1 << 16;
+
+            void push(uint32_t weight, T item)
+            {
+                ++_size;
+                if (weight >= MAX_BUCKETS)
+                {
+                    _overflow.emplace(weight, item);
+                    return;
+                }
+                if (weight >= _buckets.size())
+                    _buckets.resize(weight + 1);
+                _buckets[weight].push_back(item);
+                if (weight < _min)
+                    _min = weight;
+            }
+
+            /** the lowest weight and its latest item; the queue must not be empty */
+            std::pair<uint32_t, T> pop()
+            {
+                assert(_size > 0);
+                --_size;
+                if (_size < _overflow.size())
+                {
+                    // the buckets were empty
+                    auto e = _overflow.top();
+                    _overflow.pop();
+                    return std::make_pair(e.weight, e.item);
+                }
+                while (_buckets[_min].empty())
+                    ++_min;
+                auto& bucket = _buckets[_min];
+                auto item = bucket.back();
+                bucket.pop_back();
+                return std::make_pair(_min, item);
+            }
+
+            bool empty() const {
+                return _size == 0;
+            }
+
+            size_t size() const {
+                return _size;
+            }
+
+        private:
+            struct weighted_t {
+                uint32_t weight;
+                T item;
+                weighted_t(uint32_t w, T i) : weight(w), item(i) {};
+                bool operator <(const weighted_t& y) const {
+                    if(weight == y.weight) return item < y.item;// do dfs if they match
+                    return weight > y.weight;
+                }
+            };
+
+            std::vector<std::vector<T>> _buckets;
+            // no bucket below this one holds an item
+            uint32_t _min = MAX_BUCKETS;
+            size_t _size = 0;
+            std::priority_queue<weighted_t> _overflow;
+        };
+    }
+}
+
+#endif /* BUCKETQUEUE_H */
@@ -0,0 +1,232 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CONCURRENTSTATESET_H
+#define CONCURRENTSTATESET_H
+
+#include "StateSet.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace PetriEngine {
+    namespace Structures {
+
+        /**
+         * State set which can be inserted into and decoded from by many threads
+         * at once. Markings are encoded by a per-thread AlignedEncoder and
+         * stored in one of a number of ptrie shards, selected by a hash of the
+         * encoding; only the shard itself is locked during insertion.
+         *
+         * Ids are (shard-local id << shard bits) | shard.
+         *
+         * Statistics (discovered(), maxTokens(), maxPlaceBound()) are gathered
+         * per thread and only folded into the shared counters by collect().
+         */
+        class ConcurrentStateSet : public EncodingStateSetInterface {
+        private:
+            using ptrie_t = ptrie::set_stable<ptrie::uchar,size_t,17,128,4>;
+
+            struct shard_t {
+                std::mutex lock;
+                ptrie_t trie;
+            };
+
+            struct local_t {
+                local_t(uint32_t nplaces, uint32_t kbound, uint32_t netplaces)
+                : encoder(nplaces, kbound), maxPlaceBound(netplaces) {
+                    for (auto& b : maxPlaceBound)
+                        b.store(0, std::memory_order_relaxed);
+                }
+                AlignedEncoder encoder;
+                // only written by the owning thread, read by collect()
+                std::atomic<size_t> discovered{0};
+                std::atomic<uint32_t> maxTokens{0};
+                std::vector<std::atomic<uint32_t>> maxPlaceBound;
+            };
+
+        public:
+            ConcurrentStateSet(const PetriNet& net, uint32_t kbound, uint32_t threads = 1, int nplaces = -1)
+            : EncodingStateSetInterface(net, kbound, nplaces), _id(++_instances)
+            {
+                // a handful of shards per thread keeps the chance of two
+                // workers hitting the same shard low
+                _shard_bits = 0;
+                while ((1u << _shard_bits) < 8 * threads && _shard_bits < 12)
+                    ++_shard_bits;
+                _shards = std::make_unique<shard_t[]>(1u << _shard_bits);
+            }
+
+            std::pair<bool, size_t> add(const State& state) override
+            {
+                auto& local = _local();
+                local.discovered.store(local.discovered.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+                MarkVal sum = 0;
+                bool allsame = true;
+                uint32_t val = 0;
+                uint32_t active = 0;
+                uint32_t last = 0;
+                markingStats(state.marking(), sum, allsame, val, active, last);
+
+                if (local.maxTokens.load(std::memory_order_relaxed) < sum)
+                    local.maxTokens.store(sum, std::memory_order_relaxed);
+
+                //Check that we're within k-bound
+                if (_kbound != 0 && sum > _kbound)
+                    return std::pair<bool, size_t>(false, std::numeric_limits<size_t>::max());
+
+                unsigned char type = local.encoder.getType(sum, active, allsame, val);
+                size_t length = local.encoder.encode(state.marking(), type);
+                if(length*8 >= std::numeric_limits<uint16_t>::max())
+                {
+                    throw base_error("Marking could not be encoded into less than 2^16 bytes, current limit of PTries");
+                }
+                auto* raw = local.encoder.scratchpad().const_raw();
+                size_t shard = _hash(raw, length) & ((1u << _shard_bits) - 1);
+                std::pair<bool, size_t> tit;
+                {
+                    std::lock_guard<std::mutex> guard(_shards[shard].lock);
+                    tit = _shards[shard].trie.insert(raw, length);
+                }
+                size_t id = (tit.second << _shard_bits) | shard;
+                if (!tit.first)
+                    return std::pair<bool, size_t>(false, id);
+
+                // update the max token bound for each place in the net (only for newly discovered markings)
+                for (uint32_t i = 0; i < _net.numberOfPlaces(); i++)
+                {
+                    if (local.maxPlaceBound[i].load(std::memory_order_relaxed) < state.marking()[i])
+                        local.maxPlaceBound[i].store(state.marking()[i], std::memory_order_relaxed);
+                }
+                return std::pair<bool, size_t>(true, id);
+            }
+
+            void decode(State& state, size_t id) override
+            {
+                auto& local = _local();
+                auto& shard = _shards[id & ((1u << _shard_bits) - 1)];
+                {
+                    std::lock_guard<std::mutex> guard(shard.lock);
+                    shard.trie.unpack(id >> _shard_bits, local.encoder.scratchpad().raw());
+                }
+                local.encoder.decode(state.marking(), local.encoder.scratchpad().raw());
+            }
+
+            std::pair<bool, size_t> lookup(State& state) override
+            {
+                auto& local = _local();
+                MarkVal sum = 0;
+                bool allsame = true;
+                uint32_t val = 0;
+                uint32_t active = 0;
+                uint32_t last = 0;
+                markingStats(state.marking(), sum, allsame, val, active, last);
+
+                unsigned char type = local.encoder.getType(sum, active, allsame, val);
+                size_t length = local.encoder.encode(state.marking(), type);
+                auto* raw = local.encoder.scratchpad().const_raw();
+                size_t shard = _hash(raw, length) & ((1u << _shard_bits) - 1);
+                std::pair<bool, size_t> tit;
+                {
+                    std::lock_guard<std::mutex> guard(_shards[shard].lock);
+                    tit = _shards[shard].trie.exists(raw, length);
+                }
+                if (tit.first)
+                    return std::make_pair(true, (tit.second << _shard_bits) | shard);
+                return std::make_pair(false, std::numeric_limits<size_t>::max());
+            }
+
+            void setHistory(size_t id, size_t transition) override {}
+
+            std::pair<size_t, size_t> getHistory(size_t markingid) override
+            {
+                assert(false);
+                return std::make_pair(0,0);
+            }
+
+            size_t size() const override {
+                size_t n = 0;
+                for (size_t s = 0; s < (1u << _shard_bits); ++s) {
+                    std::lock_guard<std::mutex> guard(_shards[s].lock);
+                    n += _shards[s].trie.size();
+                }
+                return n;
+            }
+
+            /**
+             * Folds the per-thread statistics into discovered(), maxTokens()
+             * and maxPlaceBound(). Safe while other threads insert, but must
+             * not be called from several threads at once.
+             */
+            void collect()
+            {
+                std::lock_guard<std::mutex> guard(_locals_lock);
+                _discovered = 0;
+                for (auto& [tid, local] : _locals) {
+                    _discovered += local->discovered.load(std::memory_order_relaxed);
+                    _maxTokens = std::max(_maxTokens, local->maxTokens.load(std::memory_order_relaxed));
+                    for (uint32_t i = 0; i < _net.numberOfPlaces(); i++)
+                        _maxPlaceBound[i] = std::max(_maxPlaceBound[i], local->maxPlaceBound[i].load(std::memory_order_relaxed));
+                }
+            }
+
+        private:
+            local_t& _local()
+            {
+                // cache the context of the last set used by this thread
+                thread_local size_t cached_set = 0;
+                thread_local local_t* cached = nullptr;
+                if (cached_set == _id)
+                    return *cached;
+                std::lock_guard<std::mutex> guard(_locals_lock);
+                auto& local = _locals[std::this_thread::get_id()];
+                if (!local)
+                    local = std::make_unique<local_t>(_nplaces, _kbound, _net.numberOfPlaces());
+                cached_set = _id;
+                cached = local.get();
+                return *local;
+            }
+
+            static size_t _hash(const unsigned char* data, size_t length)
+            {
+                // FNV-1a, finalised with a murmur-style mix to spread the low bits
+                uint64_t h = 14695981039346656037ULL;
+                for (size_t i = 0; i < length; ++i) {
+                    h ^= data[i];
+                    h *= 1099511628211ULL;
+                }
+                h ^= h >> 33;
+                h *= 0xff51afd7ed558ccdULL;
+                h ^= h >> 33;
+                return h;
+            }
+
+            inline static std::atomic<size_t> _instances{0};
+            const size_t _id;
+            uint32_t _shard_bits;
+            std::unique_ptr<shard_t[]> _shards;
+            std::mutex _locals_lock;
+            std::unordered_map<std::thread::id, std::unique_ptr<local_t>> _locals;
+        };
+    }
+}
+
+#endif /* CONCURRENTSTATESET_H */
@@ -0,0 +1,104 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DISKSTATESET_H
+#define DISKSTATESET_H
+
+#include "StateSet.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace PetriEngine {
+    namespace Structures {
+
+        /**
+         * State set for a breadth-first search in external memory.
+         *
+         * The search proceeds one layer at a time. Markings of the current layer
+         * are read back from a file with next(), and their successors are given to
+         * add(). Successors are encoded with the AlignedEncoder and buffered in
+         * memory; a full buffer is sorted and written to disk as a run.
+         * nextLayer() merges the runs with the sorted file of all visited markings,
+         * which drops the duplicates and writes both the new visited file and the
+         * file of the next layer. Runs are first merged into fewer runs, so only a
+         * bounded number of files is open at a time.
+         *
+         * Only the buffer is held in memory, so the state space is bounded by the
+         * disk. Markings have no ids and no history, so traces are not supported.
+         */
+        class DiskStateSet : public StateSetInterface {
+        public:
+            /**
+             * @param directory where to keep the files, an empty string for the system temporary directory
+             * @param buffer bytes of encoded markings to collect before writing a run
+             */
+            DiskStateSet(const PetriNet& net, uint32_t kbound, const std::string& directory,
+                         size_t buffer, int nplaces = -1);
+            ~DiskStateSet() override;
+
+            /** queue a marking for the next layer; false if it exceeds the k-bound */
+            bool add(const State& state);
+
+            /** read the next marking of the current layer; false when the layer is done */
+            bool next(State& state);
+
+            /** start the next layer from the markings added since the last call; returns its size */
+            size_t nextLayer();
+
+            size_t size() const override {
+                return _stored;
+            }
+
+            std::pair<size_t, size_t> getHistory(size_t markingid) override
+            {
+                assert(false);
+                return std::make_pair(0,0);
+            }
+
+        private:
+            class writer_t;
+            class reader_t;
+
+            std::filesystem::path _file(const char* kind);
+            void _flush();
+            // merges the runs in passes until at most FAN_IN are left
+            void _compact();
+            // merges sorted runs, calling emit once for each distinct record, in order
+            static void _merge(const std::vector<std::filesystem::path>& runs,
+                               const std::function<void(const unsigned char*)>& emit);
+
+            AlignedEncoder _encoder;
+            std::filesystem::path _directory;
+            size_t _buffer_size;
+            // length-prefixed encodings of the markings added in this layer
+            std::vector<unsigned char> _buffer;
+            std::vector<size_t> _offsets;
+            std::vector<std::filesystem::path> _runs;
+            std::filesystem::path _visited;
+            std::filesystem::path _layer;
+            std::unique_ptr<reader_t> _reader;
+            size_t _stored = 0;
+            size_t _files = 0;
+        };
+    }
+}
+
+#endif /* DISKSTATESET_H */
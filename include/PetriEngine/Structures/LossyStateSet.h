@@ -0,0 +1,287 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LOSSYSTATESET_H
+#define LOSSYSTATESET_H
+
+#include "StateSet.h"
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace PetriEngine {
+    namespace Structures {
+
+        /**
+         * State set that only remembers a hash of each visited marking.
+         *
+         * With hash compaction (bits == 0) every marking is stored as a 64-bit
+         * fingerprint in an open-addressing table. With bitstate hashing a
+         * marking sets HASHES bits in a fixed table of 2^bits bits, and is
+         * considered seen if all of them are set already.
+         *
+         * Two markings may share a hash, in which case the second is taken to
+         * be seen and its successors may be omitted from the search. A search
+         * that exhausts this set has therefore not proven anything unreachable.
+         *
+         * Markings are kept in full only while waiting to be expanded, appended to
+         * segments of consecutive ids; decode() hands the marking out once and then
+         * forgets it, and a segment is freed once all of its markings are decoded.
+         */
+        class LossyStateSet : public EncodingStateSetInterface {
+        public:
+            static constexpr uint32_t HASHES = 3;
+
+            LossyStateSet(const PetriNet& net, uint32_t kbound, uint32_t bits, int nplaces = -1)
+            : EncodingStateSetInterface(net, kbound, nplaces), _store(bits) {}
+
+            std::pair<bool, size_t> add(const State& state) override
+            {
+                return _add(state, _store);
+            }
+
+            void decode(State& state, size_t id) override
+            {
+                _decode(state, id, _store);
+                _store.release(id);
+            }
+
+            std::pair<bool, size_t> lookup(State& state) override
+            {
+                return _lookup(state, _store);
+            }
+
+            void setHistory(size_t id, size_t transition) override {}
+
+            std::pair<size_t, size_t> getHistory(size_t markingid) override
+            {
+                assert(false);
+                return std::make_pair(0,0);
+            }
+
+            size_t size() const override {
+                return _store.size();
+            }
+
+            bool bitstate() const {
+                return _store._bits != 0;
+            }
+
+            /** bytes used for the visited hashes, not counting waiting markings */
+            size_t memory() const {
+                return bitstate() ? _store._bitset.size() * sizeof(uint64_t)
+                                  : _store._fingerprints.size() * sizeof(uint64_t);
+            }
+
+        private:
+            // the interface of a ptrie expected by EncodingStateSetInterface::_add and friends
+            struct store_t {
+                explicit store_t(uint32_t bits) : _bits(bits) {
+                    if (_bits != 0)
+                        _bitset.resize(std::max<size_t>((size_t{1} << _bits) / 64, 1), 0);
+                    else
+                        _fingerprints.resize(1024, 0);
+                }
+
+                std::pair<bool, size_t> insert(const unsigned char* data, size_t length)
+                {
+                    if (!(_bits != 0 ? _setBits(data, length) : _setFingerprint(data, length)))
+                        return std::make_pair(false, std::numeric_limits<size_t>::max());
+                    auto id = _next++;
+                    if (id % SEGMENT == 0)
+                    {
+                        // the previous segment may have been decoded while still being filled
+                        if (!_segments.empty() && _segments.back()->live == 0)
+                            _segments.back().reset();
+                        _segments.emplace_back(std::make_unique<segment_t>());
+                    }
+                    auto& segment = *_segments.back();
+                    segment.begin.push_back(segment.bytes.size());
+                    segment.length.push_back(length);
+                    segment.bytes.insert(segment.bytes.end(), data, data + length);
+                    ++segment.live;
+                    return std::make_pair(true, id);
+                }
+
+                std::pair<bool, size_t> exists(const unsigned char* data, size_t length) const
+                {
+                    bool seen = _bits != 0 ? _hasBits(data, length) : _hasFingerprint(data, length);
+                    return std::make_pair(seen, std::numeric_limits<size_t>::max());
+                }
+
+                void unpack(size_t id, unsigned char* destination) const
+                {
+                    auto& segment = _segments[id / SEGMENT];
+                    auto i = id % SEGMENT;
+                    assert(segment && segment->length[i] != RELEASED);
+                    std::memcpy(destination, segment->bytes.data() + segment->begin[i], segment->length[i]);
+                }
+
+                // forgets the encoding of id, which is not decoded again
+                void release(size_t id)
+                {
+                    auto& segment = _segments[id / SEGMENT];
+                    auto i = id % SEGMENT;
+                    assert(segment && segment->length[i] != RELEASED);
+                    segment->garbage += segment->length[i];
+                    segment->length[i] = RELEASED;
+                    if (--segment->live == 0)
+                    {
+                        // the last segment is released once the next one is started
+                        if (id / SEGMENT + 1 < _segments.size())
+                            segment.reset();
+                    }
+                    else if (2 * segment->garbage > segment->bytes.size() && segment->bytes.size() > 4096)
+                    {
+                        // a few long-waiting markings should not pin the whole segment
+                        std::vector<unsigned char> bytes;
+                        bytes.reserve(segment->bytes.size() / 2);
+                        for (size_t j = 0; j < segment->length.size(); ++j)
+                        {
+                            if (segment->length[j] == RELEASED) continue;
+                            auto* first = segment->bytes.data() + segment->begin[j];
+                            segment->begin[j] = bytes.size();
+                            bytes.insert(bytes.end(), first, first + segment->length[j]);
+                        }
+                        segment->bytes.swap(bytes);
+                        segment->garbage = 0;
+                    }
+                }
+
+                size_t size() const {
+                    return _next;
+                }
+
+                static uint64_t hash(const unsigned char* data, size_t length, uint64_t seed)
+                {
+                    // FNV-1a, finalised with a murmur-style mix to spread the low bits
+                    uint64_t h = 14695981039346656037ULL ^ seed;
+                    for (size_t i = 0; i < length; ++i) {
+                        h ^= data[i];
+                        h *= 1099511628211ULL;
+                    }
+                    h ^= h >> 33;
+                    h *= 0xff51afd7ed558ccdULL;
+                    h ^= h >> 33;
+                    h *= 0xc4ceb9fe1a85ec53ULL;
+                    h ^= h >> 33;
+                    return h;
+                }
+
+                bool _setFingerprint(const unsigned char* data, size_t length)
+                {
+                    if (2 * (_next + 1) > _fingerprints.size())
+                        _grow();
+                    return _place(_fingerprint(data, length));
+                }
+
+                bool _hasFingerprint(const unsigned char* data, size_t length) const
+                {
+                    auto fp = _fingerprint(data, length);
+                    auto mask = _fingerprints.size() - 1;
+                    for (size_t i = fp & mask; _fingerprints[i] != 0; i = (i + 1) & mask)
+                        if (_fingerprints[i] == fp)
+                            return true;
+                    return false;
+                }
+
+                // 0 marks an empty slot
+                static uint64_t _fingerprint(const unsigned char* data, size_t length)
+                {
+                    auto fp = hash(data, length, 0);
+                    return fp == 0 ? 1 : fp;
+                }
+
+                bool _place(uint64_t fp)
+                {
+                    auto mask = _fingerprints.size() - 1;
+                    size_t i = fp & mask;
+                    for (; _fingerprints[i] != 0; i = (i + 1) & mask)
+                        if (_fingerprints[i] == fp)
+                            return false;
+                    _fingerprints[i] = fp;
+                    return true;
+                }
+
+                void _grow()
+                {
+                    std::vector<uint64_t> old(_fingerprints.size() * 2, 0);
+                    old.swap(_fingerprints);
+                    for (auto fp : old)
+                        if (fp != 0)
+                            _place(fp);
+                }
+
+                // double hashing gives the HASHES bit positions of a marking
+                template<typename F>
+                void _positions(const unsigned char* data, size_t length, F&& f) const
+                {
+                    auto h1 = hash(data, length, 0);
+                    auto h2 = hash(data, length, 0x9e3779b97f4a7c15ULL) | 1;
+                    auto mask = _bitset.size() * 64 - 1;
+                    for (uint32_t k = 0; k < HASHES; ++k)
+                        f((h1 + k * h2) & mask);
+                }
+
+                bool _setBits(const unsigned char* data, size_t length)
+                {
+                    bool fresh = false;
+                    _positions(data, length, [&](uint64_t bit) {
+                        auto& word = _bitset[bit / 64];
+                        auto flag = uint64_t{1} << (bit % 64);
+                        fresh |= (word & flag) == 0;
+                        word |= flag;
+                    });
+                    return fresh;
+                }
+
+                bool _hasBits(const unsigned char* data, size_t length) const
+                {
+                    bool seen = true;
+                    _positions(data, length, [&](uint64_t bit) {
+                        seen &= (_bitset[bit / 64] & (uint64_t{1} << (bit % 64))) != 0;
+                    });
+                    return seen;
+                }
+
+                // the encodings of SEGMENT consecutive ids, freed once all of them are decoded
+                struct segment_t {
+                    std::vector<unsigned char> bytes;
+                    std::vector<uint32_t> begin;
+                    std::vector<uint32_t> length;
+                    size_t live = 0;
+                    // bytes of decoded markings, dropped once they are half of the segment
+                    size_t garbage = 0;
+                };
+                static constexpr size_t SEGMENT = 4096;
+                static constexpr uint32_t RELEASED = std::numeric_limits<uint32_t>::max();
+
+                const uint32_t _bits;
+                size_t _next = 0;
+                std::vector<uint64_t> _fingerprints;
+                std::vector<uint64_t> _bitset;
+                // the markings waiting to be decoded, by id / SEGMENT
+                std::vector<std::unique_ptr<segment_t>> _segments;
+            };
+
+            store_t _store;
+        };
+    }
+}
+
+#endif /* LOSSYSTATESET_H */
@@ -20,6 +20,7 @@
 #include <random>
 
 #include "../PQL/PQL.h"
+#include "BucketQueue.h"
 
 namespace PetriEngine {
     namespace Structures {
@@ -81,17 +82,6 @@ namespace PetriEngine {
 
         class HeuristicQueue : public Queue {
         public:
-            struct weighted_t {
-                uint32_t weight;
-                uint32_t item;
-                weighted_t(uint32_t w, uint32_t i) : weight(w), item(i) {};
-                bool operator <(const weighted_t& y) const {
-                    if(weight == y.weight) return item < y.item;// do dfs if they match
-//                    if(weight == y.weight) return item > y.item;// do bfs if they match
-                    return weight > y.weight;
-                }
-            };
-
             HeuristicQueue(size_t);
             virtual ~HeuristicQueue();
 
@@ -100,7 +90,7 @@ namespace PetriEngine {
                 const PQL::Condition* query);
             virtual bool empty() const override;
         private:
-            std::priority_queue<weighted_t> _queue;
+            BucketQueue<size_t> _queue;
         };
     }
 }
@@ -22,6 +22,8 @@
 #include <unordered_map>
 #include <stack>
 #include <iostream>
+#include <atomic>
+#include <random>
 
 #include "State.h"
 #include "AlignedEncoder.h"
@@ -81,9 +83,8 @@ namespace PetriEngine {
         public:
             RandomWalkStateSet(const PetriNet& net, uint32_t kbound, const PQL::Condition *query,
                                const std::vector<MarkVal> &initPotencies, size_t seed, int nplaces = -1)
-                : StateSetInterface(net, kbound, nplaces), _seed(seed)
+                : StateSetInterface(net, kbound, nplaces), _seed(seed), _rng(seed)
             {
-                srand(_seed);
                 _discovered = 1;
                 _initialMarking = std::make_unique<MarkVal[]>(_nplaces);
                 setMarking(net.makeInitialMarking(), _initialMarking.get());
@@ -143,7 +144,7 @@ namespace PetriEngine {
 
                 // Weighted random sampling algorithm
                 _totalWeight += _potencies[t];
-                double r = (double)rand() / RAND_MAX;
+                double r = std::uniform_real_distribution<double>(0, 1)(_rng);
                 double threshold = _potencies[t] / (double)_totalWeight;
                 if (r <= threshold) {
                     setMarking(candidate, _nextMarking.get());
@@ -182,6 +183,32 @@ namespace PetriEngine {
                 return true;
             }
 
+            const std::vector<uint32_t>& potencies() const {
+                return _potencies;
+            }
+
+            /**
+             * Shares the learned potencies with walkers running in parallel.
+             * The change since the last exchange is added to the shared aggregate,
+             * which then becomes the potencies of this walker.
+             * @param shared one potency per transition, starting from the initial potencies
+             */
+            void exchangePotencies(std::vector<std::atomic<uint32_t>>& shared) {
+                if (_published.empty())
+                    _published = _initialPotencies;
+                for (size_t t = 0; t < _potencies.size(); ++t) {
+                    int64_t delta = (int64_t)_potencies[t] - (int64_t)_published[t];
+                    uint32_t current = shared[t].load(std::memory_order_relaxed);
+                    uint32_t next;
+                    do {
+                        next = (uint32_t)std::max<int64_t>(1, std::min<int64_t>(
+                            (int64_t)current + delta, std::numeric_limits<uint32_t>::max()));
+                    } while (delta != 0 && !shared[t].compare_exchange_weak(current, next, std::memory_order_relaxed));
+                    _potencies[t] = delta != 0 ? next : current;
+                }
+                _published = _potencies;
+            }
+
             size_t size() const override {
                 // _discovered is used here but not sure it is the right value
                 return discovered();
@@ -208,9 +235,15 @@ namespace PetriEngine {
             uint32_t _totalWeight;
 
             size_t _seed;
+            std::default_random_engine _rng;
+
+            // the potencies as of the last exchangePotencies, and before any were learned
+            std::vector<uint32_t> _published;
+            std::vector<uint32_t> _initialPotencies;
 
             void _initializePotencies(size_t nTransitions, uint32_t initValue) {
                 _potencies = std::vector<uint32_t>(nTransitions, initValue);
+                _initialPotencies = _potencies;
             }
 
             void _initializePotencies(const std::vector<MarkVal> &initPotencies) {
@@ -219,6 +252,7 @@ namespace PetriEngine {
                 for (auto potency : initPotencies) {
                     _potencies.push_back(potency * _initPotencyMultiplier + _initPotencyConstant);
                 }
+                _initialPotencies = _potencies;
             }
 
             uint32_t _sumMarking(const MarkVal* marking) {
@@ -387,7 +421,12 @@ namespace PetriEngine {
 #ifdef DEBUG
                 _dbg.push_back(new uint32_t[_net.numberOfPlaces()]);
                 memcpy(_dbg.back(), state.marking(), _net.numberOfPlaces()*sizeof(uint32_t));
-                decode(state, _trie.size() - 1);
+                {
+                    State check;
+                    check.setMarking(new MarkVal[_net.numberOfPlaces()]);
+                    // not decode(), which lets some sets forget the marking
+                    _decode(check, _trie.size() - 1, _trie);
+                }
 #endif
 
                 // update the max token bound for each place in the net (only for newly discovered markings)
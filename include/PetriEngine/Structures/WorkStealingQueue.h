@@ -0,0 +1,84 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef WORKSTEALINGQUEUE_H
+#define WORKSTEALINGQUEUE_H
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace PetriEngine {
+    namespace Structures {
+
+        /**
+         * Deque of work items (state-ids, edges) owned by a single worker of a parallel search.
+         * The owner pushes and pops at the back, other workers steal from the
+         * front, where the oldest (and typically largest) pieces of work are.
+         * Each deque has its own lock; it is only contended when stealing.
+         */
+        template<typename T = size_t>
+        class WorkStealingQueue {
+        public:
+            static constexpr T EMPTY = [] {
+                if constexpr (std::is_pointer_v<T>) return T(nullptr);
+                else return std::numeric_limits<T>::max();
+            }();
+
+            void push(T id) {
+                std::lock_guard<std::mutex> guard(_lock);
+                _items.push_back(id);
+            }
+
+            T pop() {
+                std::lock_guard<std::mutex> guard(_lock);
+                if (_items.empty())
+                    return EMPTY;
+                auto id = _items.back();
+                _items.pop_back();
+                return id;
+            }
+
+            /**
+             * Moves up to half of the items (at least one, at most max) into out.
+             * @return the number of items stolen
+             */
+            size_t steal(std::vector<T>& out, size_t max) {
+                std::lock_guard<std::mutex> guard(_lock);
+                size_t n = std::min(max, (_items.size() + 1) / 2);
+                for (size_t i = 0; i < n; ++i) {
+                    out.push_back(_items.front());
+                    _items.pop_front();
+                }
+                return n;
+            }
+
+            bool empty() const {
+                std::lock_guard<std::mutex> guard(_lock);
+                return _items.empty();
+            }
+
+        private:
+            mutable std::mutex _lock;
+            std::deque<T> _items;
+        };
+    }
+}
+
+#endif /* WORKSTEALINGQUEUE_H */
@@ -172,6 +172,15 @@ public:
         return c->_offset + (c->_count++);
     }
 
+    // visits every allocated element, also when several threads allocated from the buckets
+    template<typename F>
+    void for_each(F&& f) {
+        for (bucket_t* n = _begin; n != nullptr; n = n->_nbucket.load()) {
+            for (size_t i = 0; i < n->_count; ++i)
+                f(n->_data[i]);
+        }
+    }
+
     inline void pop_back(size_t thread)
     {
         assert(_tnext[thread] != nullptr && _tnext[thread]->_count > 0);
@@ -28,11 +28,13 @@ namespace PetriEngine {
         ReachabilityStubbornSet(const PetriNet &net, const std::vector<PQL::Condition_ptr> &queries, bool closure = true)
                 : StubbornSet(net, queries), _closure(closure) {
             setInterestingVisitor<InterestingTransitionVisitor>();
+            enableSparseReset();
         }
 
         ReachabilityStubbornSet(const PetriNet &net, bool closure = true)
                 : StubbornSet(net) , _closure(closure) {
             setInterestingVisitor<InterestingTransitionVisitor>();
+            enableSparseReset();
         }
 
         bool prepare(const Structures::State *state) override;
@@ -238,11 +238,36 @@ namespace PetriEngine {
 
         std::vector<PQL::Condition *> _queries;
 
+        // Indices written to _enabled, _stubborn and _places_seen since the last reset.
+        // With sparse reset only these entries are cleared, so a reset costs as much as
+        // the previous state touched rather than the size of the net.
+        // A subclass may only enable it if every write to the arrays goes through
+        // constructEnabled, addToStub, markStubborn, set_all_stubborn or the *setOf methods.
+        std::vector<uint32_t> _touched_enabled, _touched_stubborn, _touched_places;
+        bool _sparse_reset = false;
+        bool _all_stubborn = false;
+
+        void enableSparseReset() { _sparse_reset = true; }
+
+        void markStubborn(uint32_t t) {
+            if (!_stubborn[t]) {
+                _stubborn[t] = true;
+                _touched_stubborn.push_back(t);
+            }
+        }
+
+        void markPlace(uint32_t place, uint8_t flag) {
+            if (_places_seen[place] == 0)
+                _touched_places.push_back(place);
+            _places_seen[place] |= flag;
+        }
+
+        void clearTransitions();
+
         template <typename T = std::nullptr_t>
         void constructEnabled(T&& callback = nullptr){
             _ordering.clear();
-            memset(_enabled.get(), 0, _net.numberOfTransitions());
-            memset(_stubborn.get(), 0, _net.numberOfTransitions());
+            clearTransitions();
             for (uint32_t p = 0; p < _net.numberOfPlaces(); ++p) {
                 // orphans are currently under "place 0" as a special case
                 if (p == 0 || _parent->marking()[p] > 0) {
@@ -257,6 +282,7 @@ namespace PetriEngine {
                             if(!callback(t))
                                 return;
                         _enabled[t] = true;
+                        _touched_enabled.push_back(t);
                         _ordering.push_back(t);
                         ++_nenabled;
                     }
@@ -272,6 +298,7 @@ namespace PetriEngine {
 
         void set_all_stubborn() {
             std::fill(_stubborn.get(), _stubborn.get() + _net.numberOfTransitions(), true);
+            _all_stubborn = true;
             _done = true;
         }
     };
@@ -16,7 +16,9 @@
 
 #include "PetriNet.h"
 #include "Structures/State.h"
+#include <limits>
 #include <memory>
+#include <unordered_map>
 #include "Stubborn/StubbornSet.h"
 
 namespace PetriEngine {
@@ -55,6 +57,25 @@ public:
 
     void reset();
 
+    /**
+     * In incremental mode the generator keeps the enabled transitions of the prepared
+     * marking as a sparse list. A state the search announced with expanding() gets its
+     * list from the list of its parent, re-checking only the transitions affected by the
+     * transition fired to reach it, if the parent's generator was told through stored()
+     * under which id the search kept the state. Other states are checked in full.
+     * The successors and their order are the same as in the default mode, but the
+     * generator cannot be resumed from a position given by state().
+     */
+    void setIncremental(bool incremental);
+
+    /** The next state given to prepare() is the one the search stored as id */
+    void expanding(size_t id) {
+        _expanding = id;
+    }
+
+    /** The successor produced by the last next() is stored by the search as id */
+    void stored(size_t id);
+
     /**
      * Checks if the conditions are met for fireing t, if write != NULL,
      * then also consumes tokens from write while checking
@@ -85,6 +106,18 @@ protected:
 
     template<typename T>
     bool _next(Structures::State& write, T&& predicate) {
+        if (_incremental) {
+            // the list is ordered as the place-wise scan below
+            for (; _cursor < _enabled.size(); ++_cursor) {
+                const uint32_t t = _enabled[_cursor];
+                if (!predicate(t)) continue;
+                ++_cursor;
+                _fire(write, t);
+                return true;
+            }
+            _suc_tcounter = std::numeric_limits<uint32_t>::max();
+            return false;
+        }
         for (; _suc_pcounter < _net._nplaces; ++_suc_pcounter) {
             // orphans are currently under "place 0" as a special case
             if (_suc_pcounter == 0 || (*_parent).marking()[_suc_pcounter] > 0) {
@@ -112,6 +145,31 @@ protected:
     uint32_t _suc_tcounter;
 
 private:
+    void _updateEnabled();
+
+    static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+    // transitions kept for the children of expanded states, and children waiting for theirs
+    static constexpr size_t CARRY_LIMIT = size_t{1} << 24;
+    static constexpr size_t CHILD_LIMIT = size_t{1} << 22;
+
+    // the enabled transitions of an expanded state, kept until its stored children are prepared
+    struct carried_t {
+        std::vector<uint32_t> enabled;
+        size_t children = 0;
+    };
+
+    bool _incremental = false;
+    // the enabled transitions of the prepared marking, ascending, and the next one to try
+    std::vector<uint32_t> _enabled;
+    size_t _cursor = 0;
+    size_t _expanding = NONE;
+    // the slot holding _enabled for the children of the prepared state, once one was stored
+    size_t _slot = NONE;
+    std::vector<carried_t> _carried;
+    std::vector<size_t> _free;
+    size_t _carriedSize = 0;
+    // the stored states not yet prepared: the slot of their parent and the transition fired
+    std::unordered_map<size_t, std::pair<size_t, uint32_t>> _children;
 
     friend class ReducingSuccessorGenerator;
 
@@ -31,6 +31,7 @@
 #include "CTL/CTLResult.h"
 #include "GameSuccessorGenerator.h"
 
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <inttypes.h>
@@ -59,6 +60,9 @@ namespace PetriEngine {
             void print_strategy(std::ostream& strategy_out);
             const CTLResult& result() { return _result; }
 
+            // the search gives up (with an unusable result) once *stop is raised
+            void set_stop_flag(const std::atomic<bool>* stop) { _stop = stop; }
+
         private:
             using successors_t = std::vector<std::pair<size_t, SynthConfig*>>;
 
@@ -91,7 +95,10 @@ namespace PetriEngine {
             PQL::Condition& _query;
             PQL::Condition_ptr _predicate = nullptr;
             CTLResult _result;
-
+            const std::atomic<bool>* _stop = nullptr;
+#ifndef NDEBUG
+            std::vector<MarkVal*> _markings;
+#endif
         };
     }
 }
@@ -50,7 +50,17 @@ namespace PetriEngine {
                 std::vector<std::shared_ptr<PQL::Condition > >& queries,
                 std::vector<ResultPrinter::Result>& results,
                 StatisticsLevel statisticsLevel, bool printtrace);
+
+            /** once the flag is raised the search gives up, leaving the open queries unknown */
+            void setStopFlag(const std::atomic<bool>* stop)
+            {
+                _stop = stop;
+            }
         private:
+            bool stopped() const
+            {
+                return _stop != nullptr && _stop->load(std::memory_order_relaxed);
+            }
 
             void printTrace(trace_t& stack);
             void nextEdge(AntiChain<uint32_t, size_t>& checked, state_t& state, trace_t& waiting, std::set<size_t>& nextinter);
@@ -73,6 +83,7 @@ namespace PetriEngine {
             PetriNet& _net;
             Reducer* _reducer;
             TraceSet _traceset;
+            const std::atomic<bool>* _stop = nullptr;
 
 #ifdef TAR_TIMING
             double _check_time = 0;
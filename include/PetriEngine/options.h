@@ -6,6 +6,7 @@
 
 #include <ctype.h>
 #include <stddef.h>
+#include <atomic>
 #include <limits>
 #include <set>
 #include <sstream>
@@ -13,6 +14,7 @@
 #include <iostream>
 #include <cstdint>
 
+namespace PetriEngine { namespace Reachability { class StateSpaceCache; } }
 
 enum class Strategy {
     BFS,
@@ -40,6 +42,28 @@ enum class TemporalLogic {
     CTL, LTL
 };
 
+enum class StateStorage {
+    Exact,
+    HashCompaction,
+    Bitstate,
+    Disk
+};
+
+enum class PortfolioEngine {
+    HEUR,
+    BFS,
+    DFS,
+    RDFS,
+    RPFS,
+    RandomWalk,
+    TAR,
+    SiphonTrap,
+    LP
+};
+
+/** the name of the engine as given to --portfolio */
+const char* to_string(PortfolioEngine engine);
+
 enum class StatisticsLevel {
     None,
     SearchOnly,
@@ -59,6 +83,13 @@ struct options_t {
     int colReductionTimeout = 30;
     bool stubbornreduction = true;
     bool statespaceexploration = false;
+    bool statespacecache = false;
+    StateStorage statestorage = StateStorage::Exact;
+    uint32_t bitstateBits = 30; // log2 of the size of the bitstate table in bits
+    std::string diskDirectory; // empty for the system temporary directory
+    uint32_t diskBuffer = 1024; // MB of successors to collect before sorting them to disk
+    uint32_t maxMemory = 0; // MB the engines may use before degrading, 0 for no limit
+    std::vector<PortfolioEngine> portfolio; // engines raced on the reachability queries, empty to run one
     StatisticsLevel printstatistics = StatisticsLevel::Full;
     std::set<size_t> querynumbers;
     Strategy strategy = Strategy::DEFAULT;
@@ -68,6 +99,11 @@ struct options_t {
     uint32_t siphontrapTimeout = 0;
     uint32_t siphonDepth = 0;
     uint32_t cores = 1;
+    uint32_t queryTimeout = 0;
+    // raised by the query scheduler when the query being solved should be abandoned
+    const std::atomic<bool>* query_cancel = nullptr;
+    // the explored state space of the net being verified, if statespacecache is set
+    PetriEngine::Reachability::StateSpaceCache* statespace_cache = nullptr;
     bool doVerification = true;
     bool doUnfolding = true;
     int64_t depthRandomWalk = 50000;
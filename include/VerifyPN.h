@@ -117,7 +117,19 @@ unfold(ColoredPetriNetBuilder& cpnBuilder, bool compute_partiton,
        bool compute_symmetry, bool computed_fixed_point,
        std::ostream& out = std::cout, int32_t partitionTimeout = 0,
        int32_t max_intervals = 0, int32_t intervals_reduced = 0,
-       int32_t interval_timeout = 0, bool over_approx = false, bool print_bindings = false);
+       int32_t interval_timeout = 0, bool over_approx = false, bool print_bindings = false,
+       uint32_t threads = 1);
+
+/**
+ * Unfolds the colored net straight into the compact PT net and writes it to out_file,
+ * as outputNet writes the builder returned by unfold, without keeping the PT builder.
+ */
+void outputUnfoldedNet(ColoredPetriNetBuilder& cpnBuilder, bool compute_partiton,
+       bool compute_symmetry, bool computed_fixed_point,
+       std::ostream& out, int32_t partitionTimeout,
+       int32_t max_intervals, int32_t intervals_reduced,
+       int32_t interval_timeout, bool print_bindings,
+       uint32_t threads, const std::string& out_file);
 
 ReturnValue contextAnalysis(bool colored, const shared_name_name_map& transition_names,
                             const shared_place_color_map& place_names,
@@ -0,0 +1,120 @@
+#ifndef MEMORYBUDGET_H
+#define MEMORYBUDGET_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+/**
+ * Process-wide memory budget, set by --max-memory.
+ *
+ * The stores of the engines (ptries, dependency graphs, ...) allocate through
+ * their own containers, so rather than accounting every allocation the budget
+ * is checked against the heap in use by the process, sampled by a background
+ * thread. When the usage exceeds the budget the flag is raised and stays raised
+ * until refresh() is called; engines poll it where they store new states and
+ * then switch to a cheaper mode, or give up with an unknown answer.
+ */
+class MemoryBudget {
+public:
+    /** start watching with a budget of the given bytes, 0 to stop watching */
+    static void set(size_t bytes) {
+        auto& b = instance();
+        b._stop_watching();
+        b._limit = bytes;
+        b._exhausted = false;
+        if (bytes > 0)
+            b._watcher = std::thread([&b] { b._watch(); });
+    }
+
+    static size_t limit() {
+        return instance()._limit;
+    }
+
+    /** the flag raised when the budget is exceeded, for engines taking stop flags */
+    static const std::atomic<bool>* flag() {
+        return &instance()._exhausted;
+    }
+
+    static bool exhausted() {
+        return instance()._exhausted.load(std::memory_order_relaxed);
+    }
+
+    /** sample now and lower the flag if memory was released below the budget */
+    static bool refresh() {
+        auto& b = instance();
+        bool over = b._limit > 0 && usage() > b._limit;
+        b._exhausted = over;
+        return over;
+    }
+
+    /** bytes currently in use by the process, 0 if this platform cannot tell */
+    static size_t usage() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+        // unlike the resident set, this shrinks when a store is released
+        auto info = mallinfo2();
+        return info.uordblks + info.hblkhd;
+#elif defined(__linux__)
+        size_t pages = 0, resident = 0;
+        if (auto* f = std::fopen("/proc/self/statm", "r")) {
+            if (std::fscanf(f, "%zu %zu", &pages, &resident) != 2)
+                resident = 0;
+            std::fclose(f);
+        }
+        return resident * sysconf(_SC_PAGESIZE);
+#else
+        return 0;
+#endif
+    }
+
+private:
+    static MemoryBudget& instance() {
+        static MemoryBudget budget;
+        return budget;
+    }
+
+    ~MemoryBudget() {
+        _stop_watching();
+    }
+
+    void _watch() {
+        std::unique_lock<std::mutex> lock(_lock);
+        while (!_done) {
+            if (!_exhausted && usage() > _limit)
+                _exhausted = true;
+            _wake.wait_for(lock, std::chrono::milliseconds(100));
+        }
+    }
+
+    void _stop_watching() {
+        if (!_watcher.joinable())
+            return;
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _done = true;
+        }
+        _wake.notify_all();
+        _watcher.join();
+        _done = false;
+    }
+
+    size_t _limit = 0;
+    std::atomic<bool> _exhausted{false};
+    bool _done = false;
+    std::thread _watcher;
+    std::mutex _lock;
+    std::condition_variable _wake;
+};
+
+#endif // MEMORYBUDGET_H
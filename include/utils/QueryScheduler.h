@@ -0,0 +1,178 @@
+#ifndef QUERYSCHEDULER_H
+#define QUERYSCHEDULER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+/**
+ * Solves independent queries of one model on a pool of threads.
+ *
+ * Each task gets its own output buffers, which are written to the real streams
+ * in the order the tasks were added, and a cancellation flag which is raised when
+ * the task exceeds its time budget or when another task failed. Engines poll the
+ * flag cooperatively; a task which observes it should not report an answer.
+ */
+class QueryScheduler {
+public:
+    using task_t = std::function<void(std::ostream& out, std::ostream& err, const std::atomic<bool>& cancel)>;
+
+    /**
+     * @param threads number of worker threads (at least one)
+     * @param budget seconds each task may run before it is cancelled, 0 for no limit
+     */
+    QueryScheduler(uint32_t threads, uint32_t budget, std::ostream& out, std::ostream& err)
+    : _threads(std::max<uint32_t>(threads, 1)), _budget(budget), _out(out), _err(err) {}
+
+    void add(task_t task) {
+        _tasks.emplace_back(std::move(task));
+    }
+
+    size_t size() const {
+        return _tasks.size();
+    }
+
+    /**
+     * Runs all added tasks and blocks until they are done.
+     * Rethrows the first exception thrown by a task, after the others were cancelled.
+     */
+    void run() {
+        const size_t n = _tasks.size();
+        _slots = std::make_unique<slot_t[]>(n);
+        _next = 0;
+        _flushed = 0;
+        _finished = 0;
+        _error = nullptr;
+
+        std::thread watchdog;
+        if (_budget > 0)
+            watchdog = std::thread([this, n] { _watch(n); });
+
+        std::vector<std::thread> workers;
+        for (uint32_t i = 1; i < std::min<size_t>(_threads, n); ++i)
+            workers.emplace_back([this, n] { _work(n); });
+        _work(n);
+        for (auto& t : workers)
+            t.join();
+        if (watchdog.joinable())
+            watchdog.join();
+
+        _tasks.clear();
+        if (_error)
+            std::rethrow_exception(_error);
+    }
+
+    /**
+     * Raises the cancellation flag of all started and pending tasks.
+     */
+    void cancel() {
+        std::lock_guard<std::mutex> guard(_lock);
+        _cancel_all();
+    }
+
+    /**
+     * Restarts the time budget of the task run by the calling thread, for tasks
+     * which first had to wait for a resource shared with the other tasks.
+     * Does nothing outside of a task.
+     */
+    static void restart_budget() {
+        if (_running == nullptr)
+            return;
+        std::lock_guard<std::mutex> guard(_running->_lock);
+        _running_slot->start = clock_t::now();
+    }
+
+private:
+    using clock_t = std::chrono::steady_clock;
+
+    struct slot_t {
+        std::ostringstream out;
+        std::ostringstream err;
+        std::atomic<bool> cancel{false};
+        clock_t::time_point start;
+        bool started = false;
+        bool done = false;
+    };
+
+    void _work(size_t n) {
+        for (size_t i = _next++; i < n; i = _next++) {
+            auto& slot = _slots[i];
+            {
+                std::lock_guard<std::mutex> guard(_lock);
+                slot.start = clock_t::now();
+                slot.started = true;
+            }
+            _running = this;
+            _running_slot = &slot;
+            try {
+                if (!slot.cancel)
+                    _tasks[i](slot.out, slot.err, slot.cancel);
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(_lock);
+                if (!_error)
+                    _error = std::current_exception();
+                _cancel_all();
+            }
+            _running = nullptr;
+            _running_slot = nullptr;
+            std::lock_guard<std::mutex> guard(_lock);
+            slot.done = true;
+            ++_finished;
+            // keep the output in the order the queries were given
+            while (_flushed < n && _slots[_flushed].done) {
+                _out << _slots[_flushed].out.str() << std::flush;
+                _err << _slots[_flushed].err.str() << std::flush;
+                ++_flushed;
+            }
+            _changed.notify_all();
+        }
+    }
+
+    void _watch(size_t n) {
+        std::unique_lock<std::mutex> lock(_lock);
+        const auto budget = std::chrono::seconds(_budget);
+        while (_finished < n) {
+            _changed.wait_for(lock, std::chrono::milliseconds(100));
+            auto now = clock_t::now();
+            for (size_t i = _flushed; i < n; ++i) {
+                auto& slot = _slots[i];
+                if (slot.started && !slot.done && now - slot.start >= budget)
+                    slot.cancel = true;
+            }
+        }
+    }
+
+    void _cancel_all() {
+        if (!_slots)
+            return;
+        for (size_t i = 0; i < _tasks.size(); ++i)
+            _slots[i].cancel = true;
+    }
+
+    const uint32_t _threads;
+    const uint32_t _budget;
+    std::ostream& _out;
+    std::ostream& _err;
+    std::vector<task_t> _tasks;
+    std::unique_ptr<slot_t[]> _slots;
+    std::atomic<size_t> _next{0};
+    size_t _flushed = 0;
+    size_t _finished = 0;
+    std::exception_ptr _error;
+    std::mutex _lock;
+    std::condition_variable _changed;
+    // the scheduler and slot of the task run by this thread
+    static inline thread_local QueryScheduler* _running = nullptr;
+    static inline thread_local slot_t* _running_slot = nullptr;
+};
+
+#endif // QUERYSCHEDULER_H
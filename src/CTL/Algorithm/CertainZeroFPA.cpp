@@ -9,6 +9,7 @@ using namespace SearchStrategy;
 bool Algorithm::CertainZeroFPA::search(DependencyGraph::BasicDependencyGraph &t_graph)
 {
     graph = &t_graph;
+    strategy->setTargets(&graph->targets());
 
 
     vertex = graph->initialConfiguration();
@@ -17,7 +18,7 @@ bool Algorithm::CertainZeroFPA::search(DependencyGraph::BasicDependencyGraph &t_
     }
 
     size_t cnt = 0;
-    while(!strategy->empty())
+    while(!strategy->empty() && !stopped())
     {
         while (auto e = strategy->popEdge(false))
         {
@@ -28,7 +29,11 @@ bool Algorithm::CertainZeroFPA::search(DependencyGraph::BasicDependencyGraph &t_
             if(e->refcnt > 0) --e->refcnt;
             if(e->refcnt == 0) graph->release(e);
             ++cnt;
-            if((cnt % 1000) == 0) strategy->trivialNegation();
+            if((cnt % 1000) == 0)
+            {
+                strategy->trivialNegation();
+                if(stopped()) return false;
+            }
             if(vertex->isDone()) return vertex->assignment == ONE;
         }
 
@@ -73,13 +78,14 @@ void Algorithm::CertainZeroFPA::checkEdge(Edge* e, bool only_assign)
     //auto pre_empty = e->targets.empty();
     Configuration *lastUndecided = nullptr;
     {
-        auto it = e->targets.begin();
-        auto pit = e->targets.before_begin();
-        while(it != e->targets.end())
+        auto& targets = graph->targets();
+        auto it = targets.begin(e->targets);
+        auto pit = targets.before_begin(e->targets);
+        while(it != targets.end())
         {
             if ((*it)->assignment == ONE)
             {
-                e->targets.erase_after(pit);
+                targets.erase_after(pit);
                 it = pit;
             }
             else
@@ -132,7 +138,7 @@ void Algorithm::CertainZeroFPA::checkEdge(Edge* e, bool only_assign)
                 {
                     strategy->pushNegation(e);
                 }
-                lastUndecided->addDependency(e);
+                lastUndecided->addDependency(e, graph->dependencies());
                 if (lastUndecided->assignment == UNKNOWN) {
                     explore(lastUndecided);
                 }
@@ -158,8 +164,8 @@ void Algorithm::CertainZeroFPA::checkEdge(Edge* e, bool only_assign)
             if(!e->processed) {
                 if(!lastUndecided->isDone())
                 {
-                    for (auto t : e->targets)
-                        t->addDependency(e);
+                    for (auto t : graph->targets().items(e->targets))
+                        t->addDependency(e, graph->dependencies());
                 }
             }
             if (lastUndecided->assignment == UNKNOWN) {
@@ -182,7 +188,7 @@ void Algorithm::CertainZeroFPA::finalAssign(DependencyGraph::Configuration *c, D
 
     c->assignment = a;
     c->nsuccs = 0;
-    for (DependencyGraph::Edge *e : c->dependency_set) {
+    for (DependencyGraph::Edge *e : graph->dependencies().items(c->dependency_set)) {
         if(!e->source->isDone()) {
             if(a == CZERO)
             {
@@ -209,7 +215,7 @@ void Algorithm::CertainZeroFPA::finalAssign(DependencyGraph::Configuration *c, D
         if(e->refcnt == 0) graph->release(e);
     }
 
-    c->dependency_set.clear();
+    graph->dependencies().clear(c->dependency_set);
 }
 
 void Algorithm::CertainZeroFPA::explore(Configuration *c)
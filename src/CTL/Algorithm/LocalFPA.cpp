@@ -9,22 +9,23 @@ bool Algorithm::LocalFPA::search(DependencyGraph::BasicDependencyGraph &t_graph)
 {
     using namespace DependencyGraph;
     graph = &t_graph;
+    strategy->setTargets(&graph->targets());
 
     Configuration *v = graph->initialConfiguration();
     explore(v);
 
-    while (!strategy->empty())
+    while (!strategy->empty() && !stopped())
     {
         while (auto e = strategy->popEdge()) {
 
-            if (v->assignment == DependencyGraph::ONE) {
+            if (v->assignment == DependencyGraph::ONE || stopped()) {
                 break;
             }
 
             bool allOne = true;
             Configuration *lastUndecided = nullptr;
 
-            for (DependencyGraph::Configuration *c : e->targets) {
+            for (DependencyGraph::Configuration *c : graph->targets().items(e->targets)) {
                 if (c->assignment != DependencyGraph::ONE) {
                     allOne = false;
                     lastUndecided = c;
@@ -75,7 +76,7 @@ void Algorithm::LocalFPA::finalAssign(DependencyGraph::Configuration *c, Depende
     assert(a == DependencyGraph::ONE);
     c->assignment = a;
 
-    for(DependencyGraph::Edge *e : c->dependency_set){
+    for(DependencyGraph::Edge *e : graph->dependencies().items(c->dependency_set)){
         if(e->is_negated)
         {
             strategy->pushNegation(e);
@@ -88,7 +89,7 @@ void Algorithm::LocalFPA::finalAssign(DependencyGraph::Configuration *c, Depende
         if(e->refcnt == 0) graph->release(e);
     }
 
-    c->dependency_set.clear();
+    graph->dependencies().clear(c->dependency_set);
 }
 
 void Algorithm::LocalFPA::explore(DependencyGraph::Configuration *c)
@@ -109,5 +110,5 @@ void Algorithm::LocalFPA::explore(DependencyGraph::Configuration *c)
 
 void Algorithm::LocalFPA::addDependency(DependencyGraph::Edge *e, DependencyGraph::Configuration *target)
 {
-    target->addDependency(e);
+    target->addDependency(e, graph->dependencies());
 }
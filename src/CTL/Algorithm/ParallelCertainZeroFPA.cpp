@@ -0,0 +1,371 @@
+#include "CTL/Algorithm/ParallelCertainZeroFPA.h"
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+using namespace DependencyGraph;
+
+namespace Algorithm {
+
+// how many edges a busy worker hands over when some worker is idle
+constexpr size_t share_batch = 32;
+
+ParallelCertainZeroFPA::ParallelCertainZeroFPA(Strategy type, uint32_t threads)
+: FixedPointAlgorithm(type), _type(type), _threads(std::max<uint32_t>(threads, 1))
+{
+}
+
+bool ParallelCertainZeroFPA::search(BasicDependencyGraph &t_graph)
+{
+    graph = &t_graph;
+    const uint32_t threads = std::max<uint32_t>(1, std::min(_threads, graph->workers()));
+    _workers = std::vector<worker_t>(threads);
+    _shared = std::vector<PetriEngine::Structures::WorkStealingQueue<Edge*>>(threads);
+    for(uint32_t i = 0; i < threads; ++i)
+    {
+        _workers[i].id = i;
+        _workers[i].rng.seed(i);
+    }
+    _pending = 0;
+    _idle = 0;
+    _finished = false;
+    _negations.clear();
+    _error = nullptr;
+
+    vertex = graph->initialConfiguration();
+    explore(_workers[0], vertex);
+
+    std::vector<std::thread> pool;
+    for(uint32_t i = 1; i < threads; ++i)
+        pool.emplace_back([this, i] { work(_workers[i]); });
+    work(_workers[0]);
+    for(auto& t : pool)
+        t.join();
+
+    for(auto& w : _workers)
+    {
+        _processedEdges += w.processedEdges;
+        _processedNegationEdges += w.processedNegationEdges;
+        _exploredConfigurations += w.exploredConfigurations;
+        _numberOfEdges += w.numberOfEdges;
+    }
+    if(_error)
+        std::rethrow_exception(_error);
+    return vertex->assignment == ONE;
+}
+
+void ParallelCertainZeroFPA::work(worker_t& w)
+{
+    try {
+        while(!vertex->isDone() && !_finished && !stopped())
+        {
+            auto e = pop(w);
+            if(e == nullptr)
+            {
+                if(!w.idle)
+                {
+                    w.idle = true;
+                    ++_idle;
+                }
+                if(_pending.load() == 0)
+                    releaseNegations(w);
+                else
+                    std::this_thread::yield();
+                continue;
+            }
+            if(w.idle)
+            {
+                w.idle = false;
+                --_idle;
+            }
+
+            checkEdge(w, e);
+            // anything pushed by checkEdge is accounted for before the edge is retired
+            --_pending;
+
+            if(_idle.load(std::memory_order_relaxed) > 0 && _shared[w.id].empty())
+            {
+                for(size_t i = 0; i < share_batch && !w.waiting.empty(); ++i)
+                {
+                    _shared[w.id].push(w.waiting.front());
+                    w.waiting.pop_front();
+                }
+            }
+        }
+    } catch(...) {
+        std::lock_guard<std::mutex> guard(_error_lock);
+        if(!_error)
+            _error = std::current_exception();
+        _finished = true;
+    }
+}
+
+Edge* ParallelCertainZeroFPA::pop(worker_t& w)
+{
+    if(!w.dependencies.empty())
+    {
+        auto e = w.dependencies.back();
+        w.dependencies.pop_back();
+        return e;
+    }
+    if(w.waiting.empty())
+    {
+        if(auto e = _shared[w.id].pop(); e != nullptr)
+            return e;
+        // try to steal from the other workers, starting at a random victim
+        std::vector<Edge*> stolen;
+        const size_t n = _workers.size();
+        const size_t offset = w.rng();
+        for(size_t i = 1; i < n && stolen.empty(); ++i)
+            _shared[(w.id + offset + i) % n].steal(stolen, share_batch);
+        if(stolen.empty())
+            return nullptr;
+        w.waiting.insert(w.waiting.end(), stolen.begin(), stolen.end());
+    }
+    Edge* e = nullptr;
+    if(_type == Strategy::BFS)
+    {
+        e = w.waiting.front();
+        w.waiting.pop_front();
+    }
+    else
+    {
+        e = w.waiting.back();
+        w.waiting.pop_back();
+    }
+    return e;
+}
+
+void ParallelCertainZeroFPA::releaseNegations(worker_t& w)
+{
+    std::unique_lock<std::mutex> guard(_negation_lock, std::try_to_lock);
+    // nobody can produce new work while nothing is pending, except the owner of this lock
+    if(!guard.owns_lock() || _pending.load() != 0 || _finished || vertex->isDone())
+        return;
+
+    // first, negations whose target is already decided
+    bool trivial = false;
+    auto it = std::remove_if(_negations.begin(), _negations.end(), [&](Edge* e) {
+        if(e->source->isDone())
+            return true;
+        bool decided = false;
+        {
+            std::lock_guard<std::mutex> eguard(lock(e));
+            decided = e->handled || e->targets.empty() || graph->targets().front(e->targets)->isDone();
+        }
+        if(decided)
+        {
+            pushDependency(w, e);
+            trivial = true;
+        }
+        return decided;
+    });
+    _negations.erase(it, _negations.end());
+    if(trivial)
+        return;
+    if(_negations.empty())
+    {
+        // a fixed point is reached
+        _finished = true;
+        return;
+    }
+
+    // the remaining targets are (certainly) zero at the deepest nesting of negations
+    uint32_t dist = 0;
+    for(auto e : _negations)
+        dist = std::max(dist, e->source->getDistance());
+    std::vector<Edge*> released;
+    it = std::remove_if(_negations.begin(), _negations.end(), [&](Edge* e) {
+        if(e->source->getDistance() < dist)
+            return false;
+        released.push_back(e);
+        return true;
+    });
+    _negations.erase(it, _negations.end());
+    for(auto e : released)
+    {
+        ++w.processedNegationEdges;
+        finalAssign(w, e->source, ONE);
+    }
+}
+
+void ParallelCertainZeroFPA::checkEdge(worker_t& w, Edge* e)
+{
+    auto source = e->source;
+    if(source->isDone()) return;
+
+    bool allOne = true;
+    bool hasCZero = false;
+    bool first = false;
+    Configuration *lastUndecided = nullptr;
+    std::vector<Configuration*> targets;
+    {
+        std::lock_guard<std::mutex> guard(lock(e));
+        if(e->handled) return;
+        auto& arena = graph->targets();
+        auto it = arena.begin(e->targets);
+        auto pit = arena.before_begin(e->targets);
+        while(it != arena.end())
+        {
+            if ((*it)->assignment == ONE)
+            {
+                arena.erase_after(pit, w.id);
+                it = pit;
+            }
+            else
+            {
+                allOne = false;
+                if ((*it)->assignment == CZERO) {
+                    hasCZero = true;
+                    break;
+                }
+                else if(lastUndecided == nullptr)
+                {
+                    lastUndecided = *it;
+                }
+                else if(lastUndecided->assignment == UNKNOWN && (*it)->assignment == ZERO)
+                {
+                    lastUndecided = *it;
+                }
+            }
+            pit = it;
+            ++it;
+        }
+        if(e->is_negated ? allOne : hasCZero)
+        {
+            e->handled = true;
+        }
+        else if(!allOne && !hasCZero)
+        {
+            first = !e->processed;
+            e->processed = true;
+            if(first && !e->is_negated)
+                targets.assign(arena.begin(e->targets), arena.end());
+        }
+    }
+
+    if(e->is_negated)
+    {
+        ++w.processedNegationEdges;
+        if(allOne)
+        {
+            removeSuccessor(w, source);
+        }
+        else if(hasCZero)
+        {
+            finalAssign(w, source, ONE);
+        }
+        else
+        {
+            if(first)
+            {
+                {
+                    std::lock_guard<std::mutex> guard(_negation_lock);
+                    _negations.push_back(e);
+                }
+                if(!addDependency(w, lastUndecided, e))
+                    pushDependency(w, e);
+            }
+            if(lastUndecided->assignment == UNKNOWN)
+                explore(w, lastUndecided);
+        }
+    }
+    else
+    {
+        ++w.processedEdges;
+        if(allOne)
+        {
+            finalAssign(w, source, ONE);
+        }
+        else if(hasCZero)
+        {
+            removeSuccessor(w, source);
+        }
+        else
+        {
+            bool missed = false;
+            for(auto t : targets)
+            {
+                if(!addDependency(w, t, e))
+                    missed = true;
+            }
+            // a target was decided before we could depend on it
+            if(missed)
+                pushDependency(w, e);
+            if(lastUndecided->assignment == UNKNOWN)
+                explore(w, lastUndecided);
+        }
+    }
+}
+
+void ParallelCertainZeroFPA::explore(worker_t& w, Configuration* c)
+{
+    {
+        std::lock_guard<std::mutex> guard(lock(c));
+        if(c->assignment != UNKNOWN) return;
+        c->assignment = ZERO;
+    }
+
+    auto succs = graph->successors(c, w.id);
+    ++w.exploredConfigurations;
+    w.numberOfEdges += succs.size();
+    {
+        // no edge of c is visible to other workers yet
+        std::lock_guard<std::mutex> guard(lock(c));
+        c->nsuccs = succs.size();
+    }
+    if(succs.empty())
+    {
+        finalAssign(w, c, CZERO);
+        return;
+    }
+    if(_type == Strategy::RDFS || _type == Strategy::RPFS)
+        std::shuffle(succs.begin(), succs.end(), w.rng);
+    _pending += succs.size();
+    w.waiting.insert(w.waiting.end(), succs.begin(), succs.end());
+}
+
+void ParallelCertainZeroFPA::finalAssign(worker_t& w, Configuration* c, Assignment a)
+{
+    assert(a == ONE || a == CZERO);
+    DependencyArena::list_t dependers;
+    {
+        std::lock_guard<std::mutex> guard(lock(c));
+        if(c->isDone()) return;
+        c->assignment = a;
+        c->nsuccs = 0;
+        std::swap(dependers, c->dependency_set);
+    }
+    auto& arena = graph->dependencies();
+    for(auto e : arena.items(dependers))
+        pushDependency(w, e);
+    arena.clear(dependers, w.id);
+}
+
+void ParallelCertainZeroFPA::removeSuccessor(worker_t& w, Configuration* c)
+{
+    {
+        std::lock_guard<std::mutex> guard(lock(c));
+        if(c->isDone()) return;
+        assert(c->nsuccs > 0);
+        if(--c->nsuccs > 0) return;
+    }
+    finalAssign(w, c, CZERO);
+}
+
+bool ParallelCertainZeroFPA::addDependency(worker_t& w, Configuration* c, Edge* e)
+{
+    std::lock_guard<std::mutex> guard(lock(c));
+    if(c->isDone()) return false;
+    c->insertDependency(e, graph->dependencies(), w.id);
+    return true;
+}
+
+void ParallelCertainZeroFPA::pushDependency(worker_t& w, Edge* e)
+{
+    if(e->source->isDone()) return;
+    ++_pending;
+    w.dependencies.push_back(e);
+}
+}
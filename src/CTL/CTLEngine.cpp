@@ -5,8 +5,11 @@
 
 #include "CTL/Algorithm/CertainZeroFPA.h"
 #include "CTL/Algorithm/LocalFPA.h"
+#include "CTL/Algorithm/ParallelCertainZeroFPA.h"
 
 #include "utils/stopwatch.h"
+#include "utils/QueryScheduler.h"
+#include "utils/MemoryBudget.h"
 #include "PetriEngine/options.h"
 #include "PetriEngine/Reachability/ReachabilityResult.h"
 #include "PetriEngine/TAR/TARReachability.h"
@@ -27,7 +30,7 @@ using namespace PetriEngine::Reachability;
 using namespace PetriNets;
 
 ReturnValue getAlgorithm(std::shared_ptr<Algorithm::FixedPointAlgorithm>& algorithm,
-                         CTLAlgorithmType algorithmtype, Strategy search)
+                         CTLAlgorithmType algorithmtype, Strategy search, uint32_t threads)
 {
     switch(algorithmtype)
     {
@@ -35,7 +38,10 @@ ReturnValue getAlgorithm(std::shared_ptr<Algorithm::FixedPointAlgorithm>& algori
             algorithm = std::make_shared<Algorithm::LocalFPA>(search);
             break;
         case CTLAlgorithmType::CZero:
-            algorithm = std::make_shared<Algorithm::CertainZeroFPA>(search);
+            if(threads > 1)
+                algorithm = std::make_shared<Algorithm::ParallelCertainZeroFPA>(search, threads);
+            else
+                algorithm = std::make_shared<Algorithm::CertainZeroFPA>(search);
             break;
         default:
             throw base_error("Unknown or unsupported algorithm");
@@ -45,19 +51,28 @@ ReturnValue getAlgorithm(std::shared_ptr<Algorithm::FixedPointAlgorithm>& algori
 
 bool CTLSingleSolve(const Condition_ptr& query, PetriNet* net,
                  CTLAlgorithmType algorithmtype,
-                 Strategy strategytype, bool partial_order, CTLResult& result)
+                 Strategy strategytype, bool partial_order, CTLResult& result,
+                 const std::atomic<bool>* stop, uint32_t threads, StateSpaceCache* cache)
 {
-    return CTLSingleSolve(query.get(), net, algorithmtype, strategytype, partial_order, result);
+    return CTLSingleSolve(query.get(), net, algorithmtype, strategytype, partial_order, result, stop, threads, cache);
 }
 
 bool CTLSingleSolve(Condition* query, PetriNet* net,
                  CTLAlgorithmType algorithmtype,
-                 Strategy strategytype, bool partial_order, CTLResult& result)
+                 Strategy strategytype, bool partial_order, CTLResult& result,
+                 const std::atomic<bool>* stop, uint32_t threads, StateSpaceCache* cache)
 {
-    OnTheFlyDG graph(net, partial_order);
+    // only the certain-zero algorithm can explore the graph in parallel, and it does so without stubborn sets
+    if(algorithmtype != CTLAlgorithmType::CZero || partial_order)
+        threads = 1;
+    OnTheFlyDG graph(net, partial_order, threads);
     graph.setQuery(query);
+    // markings beyond a k-bound are missing from the cache, which is fine for reachability only
+    if(cache != nullptr && cache->covers(*net, 0) && cache->build(stop))
+        graph.setStateSpaceCache(cache);
     std::shared_ptr<Algorithm::FixedPointAlgorithm> alg = nullptr;
-    getAlgorithm(alg, algorithmtype,  strategytype);
+    getAlgorithm(alg, algorithmtype,  strategytype, threads);
+    alg->setStopFlag(stop);
 
     stopwatch timer;
     timer.start();
@@ -72,6 +87,7 @@ bool CTLSingleSolve(Condition* query, PetriNet* net,
     result.exploredConfigurations += alg->exploredConfigurations();
     result.numberOfEdges += alg->numberOfEdges();
     result.maxTokens = std::max(graph.maxTokens(), result.maxTokens);
+    result.outOfMemory |= alg->outOfMemory();
     return res;
 }
 
@@ -164,6 +180,7 @@ bool solveLogicalCondition(LogicalCondition* query, bool is_conj, PetriNet* net,
         if(!options.tar)
         {
             ReachabilitySearch strategy(*net, handler, options.kbound, true);
+            strategy.setStateSpaceCache(options.statespace_cache);
             strategy.reachable(queries, res,
                                options.strategy,
                                options.stubbornreduction,
@@ -171,6 +188,7 @@ bool solveLogicalCondition(LogicalCondition* query, bool is_conj, PetriNet* net,
                                StatisticsLevel::None,
                                false,
                                options.seed());
+            result.outOfMemory |= strategy.outOfMemory();
             result.maxTokens = std::max(handler._max_tokens, result.maxTokens);
             result.exploredConfigurations += handler._explored;
             result.numberOfConfigurations += handler._stored;
@@ -253,6 +271,7 @@ bool recursiveSolve(Condition* query, PetriEngine::PetriNet* net,
         else
         {
             ReachabilitySearch strategy(*net, handler, options.kbound, true);
+            strategy.setStateSpaceCache(options.statespace_cache);
             strategy.reachable(queries, res,
                                options.strategy,
                                options.stubbornreduction,
@@ -260,6 +279,7 @@ bool recursiveSolve(Condition* query, PetriEngine::PetriNet* net,
                                StatisticsLevel::None,
                                false,
                                options.seed());
+            result.outOfMemory |= strategy.outOfMemory();
             result.maxTokens = std::max(handler._max_tokens, result.maxTokens);
             result.exploredConfigurations += handler._explored;
             result.numberOfConfigurations += handler._stored;
@@ -294,18 +314,20 @@ bool recursiveSolve(Condition* query, PetriEngine::PetriNet* net,
         if(ok)
         {
             LTL::LTLSearch search(*net, q, options.buchiOptimization, options.ltl_compress_aps);
+            search.set_stop_flag(options.query_cancel);
             auto r = search.solve(false, options.kbound, options.ltlalgorithm, options.ltl_por,
-                            options.strategy, options.ltlHeuristic, options.ltluseweak, options.seed_offset);
+                            options.strategy, options.ltlHeuristic, options.ltluseweak, options.seed_offset, options.cores);
             result.numberOfMarkings += search.markings();
             result.numberOfConfigurations += search.configurations();
             result.exploredConfigurations += search.explored();
             result.maxTokens = std::max(search.max_tokens(), result.maxTokens);
+            result.outOfMemory |= search.out_of_memory();
             return r;
         }
     }
     //else
     {
-        return CTLSingleSolve(query, net, algorithmtype, strategytype, partial_order, result);
+        return CTLSingleSolve(query, net, algorithmtype, strategytype, partial_order, result, options.query_cancel, options.cores, options.statespace_cache);
     }
 }
 
@@ -321,43 +343,72 @@ ReturnValue CTLMain(PetriNet* net,
                     options_t& options
         )
 {
+    QueryScheduler scheduler(options.cores, options.queryTimeout, std::cout, std::cerr);
     for(auto qnum : querynumbers){
-        CTLResult result(queries[qnum]);
-        bool solved = false;
+        scheduler.add([&, qnum](std::ostream& out, std::ostream&, const std::atomic<bool>& cancel) {
+            // every query gets its own copy of the options, as solving them updates the seed.
+            options_t qoptions = options;
+            qoptions.query_cancel = &cancel;
+            // and its share of the cores, as the queries are solved concurrently
+            qoptions.cores = std::max<uint32_t>(1, options.cores / querynumbers.size());
+            CTLResult result(queries[qnum]);
+            bool solved = false;
 
-        {
-            OnTheFlyDG graph(net, partial_order);
-            graph.setQuery(result.query);
-            switch (graph.initialEval()) {
-                case Condition::Result::RFALSE:
-                    result.result = false;
-                    solved = true;
-                    break;
-                case Condition::Result::RTRUE:
-                    result.result = true;
-                    solved = true;
-                    break;
-                default:
-                    break;
+            {
+                OnTheFlyDG graph(net, partial_order);
+                graph.setQuery(result.query);
+                switch (graph.initialEval()) {
+                    case Condition::Result::RFALSE:
+                        result.result = false;
+                        solved = true;
+                        break;
+                    case Condition::Result::RTRUE:
+                        result.result = true;
+                        solved = true;
+                        break;
+                    default:
+                        break;
+                }
             }
-        }
-        result.numberOfConfigurations = 0;
-        result.numberOfMarkings = 0;
-        result.processedEdges = 0;
-        result.processedNegationEdges = 0;
-        result.exploredConfigurations = 0;
-        result.numberOfEdges = 0;
-        result.duration = 0;
-        result.maxTokens = 0;
-        if(!solved)
-        {
-            if(options.strategy == Strategy::BFS || options.strategy == Strategy::RDFS)
-                result.result = CTLSingleSolve(result.query, net, algorithmtype, options.strategy, options.stubbornreduction, result);
-            else
-                result.result = recursiveSolve(result.query, net, algorithmtype, strategytype, partial_order, result, options);
-        }
-        result.print(querynames[qnum], printstatistics, qnum, options, std::cout);
+            result.numberOfConfigurations = 0;
+            result.numberOfMarkings = 0;
+            result.processedEdges = 0;
+            result.processedNegationEdges = 0;
+            result.exploredConfigurations = 0;
+            result.numberOfEdges = 0;
+            result.duration = 0;
+            result.maxTokens = 0;
+            if(!solved)
+            {
+                if(qoptions.strategy == Strategy::BFS || qoptions.strategy == Strategy::RDFS)
+                    result.result = CTLSingleSolve(result.query, net, algorithmtype, qoptions.strategy, qoptions.stubbornreduction, result, &cancel, qoptions.cores, qoptions.statespace_cache);
+                else
+                    result.result = recursiveSolve(result.query, net, algorithmtype, strategytype, partial_order, result, qoptions);
+            }
+            if(cancel)
+            {
+                out << "\nFORMULA " << querynames[qnum] << " CANNOT_COMPUTE\n"
+                    << "Query index " << qnum << " exceeded the time budget of " << options.queryTimeout << " seconds\n" << std::endl;
+                return;
+            }
+            if(result.outOfMemory)
+            {
+                out << "\nFORMULA " << querynames[qnum] << " CANNOT_COMPUTE\n"
+                    << "Query index " << qnum << " exceeded the memory budget of " << options.maxMemory << " MB\n";
+                if(printstatistics != StatisticsLevel::None)
+                    out << "STATS:\n"
+                        << "\tConfigurations    : " << result.numberOfConfigurations << "\n"
+                        << "\tMarkings          : " << result.numberOfMarkings << "\n"
+                        << "\tExplored Configs  : " << result.exploredConfigurations << "\n";
+                out << std::endl;
+                // let the next queries run if the memory of this one made room
+                MemoryBudget::refresh();
+                return;
+            }
+            result.print(querynames[qnum], printstatistics, qnum, qoptions, out);
+        });
     }
+    scheduler.run();
     return ReturnValue::SuccessCode;
 }
 
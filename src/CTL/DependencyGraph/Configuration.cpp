@@ -3,22 +3,27 @@
 
 namespace DependencyGraph {
 
-    void Configuration::addDependency(Edge* e) {
-        if(assignment == ONE) return;
+    void Configuration::addDependency(Edge* e, DependencyArena& arena, uint32_t worker) {
+        if(insertDependency(e, arena, worker))
+            ++e->refcnt;
+    }
+
+    bool Configuration::insertDependency(Edge* e, DependencyArena& arena, uint32_t worker) {
+        if(assignment == ONE) return false;
         unsigned int sDist = e->is_negated ? e->source->getDistance() + 1 : e->source->getDistance();
         unsigned int tDist = getDistance();
 
         setDistance(std::max(sDist, tDist));
-        auto it = dependency_set.begin();
-        auto pit = dependency_set.before_begin();
-        while(it != dependency_set.end())
+        auto it = arena.begin(dependency_set);
+        auto pit = arena.before_begin(dependency_set);
+        while(it != arena.end())
         {
-            if(*it == e) return;
+            if(*it == e) return false;
             if(*it > e) break;
             pit = it;
             ++it;
         }
-        dependency_set.insert_after(pit, e);
-        ++e->refcnt;
+        arena.insert_after(pit, e, worker);
+        return true;
     }
 }
\ No newline at end of file
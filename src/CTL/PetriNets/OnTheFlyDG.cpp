@@ -13,19 +13,23 @@
 #include "PetriEngine/Stubborn/ReachabilityStubbornSet.h"
 #include "PetriEngine/PQL/PredicateCheckers.h"
 #include "PetriEngine/PQL/Evaluation.h"
+#include "utils/errors.h"
 
 using namespace PetriEngine::PQL;
 using namespace DependencyGraph;
 
 namespace PetriNets {
 
-OnTheFlyDG::OnTheFlyDG(PetriEngine::PetriNet *t_net, bool partial_order) : encoder(t_net->numberOfPlaces(), 0),
-        edge_alloc(new linked_bucket_t<DependencyGraph::Edge,1024*10>(1)),
-        conf_alloc(new linked_bucket_t<char[sizeof(PetriConfig)], 1024*1024>(1)),
-        _redgen(*t_net, std::make_shared<PetriEngine::ReachabilityStubbornSet>(*t_net)), _partial_order(partial_order) {
+OnTheFlyDG::OnTheFlyDG(PetriEngine::PetriNet *t_net, bool partial_order, uint32_t threads) :
+        DependencyGraph::BasicDependencyGraph(std::max<uint32_t>(threads, 1)),
+        edge_alloc(new linked_bucket_t<DependencyGraph::Edge,1024*10>(std::max<uint32_t>(threads, 1))),
+        conf_alloc(new linked_bucket_t<char[sizeof(PetriConfig)], 1024*1024>(std::max<uint32_t>(threads, 1))),
+        _redgen(*t_net, std::make_shared<PetriEngine::ReachabilityStubbornSet>(*t_net)), _partial_order(partial_order && threads <= 1) {
     net = t_net;
     n_places = t_net->numberOfPlaces();
     n_transitions = t_net->numberOfTransitions();
+    for(uint32_t i = 0; i < std::max<uint32_t>(threads, 1); ++i)
+        _workers.emplace_back(std::make_unique<worker_t>(n_places));
 }
 
 
@@ -34,11 +38,10 @@ OnTheFlyDG::~OnTheFlyDG()
     cleanUp();
     //Note: initial marking is in the markings set, therefore it will be deleted by the for loop
     //TODO: Ensure we don't leak memory here, when code moving is done
-    size_t s = conf_alloc->size();
-    for(size_t i = 0; i < s; ++i)
-    {
-        ((PetriConfig*)&(*conf_alloc)[i])->~PetriConfig();
-    }
+    // unused slots are zeroed, which is an empty configuration
+    conf_alloc->for_each([](auto& mem) {
+        ((PetriConfig*)&mem)->~PetriConfig();
+    });
     delete conf_alloc;
     delete edge_alloc;
 }
@@ -46,7 +49,7 @@ OnTheFlyDG::~OnTheFlyDG()
 Condition::Result OnTheFlyDG::initialEval()
 {
     initialConfiguration();
-    EvaluationContext e(query_marking.marking(), net);
+    EvaluationContext e(_workers[0]->query_marking.marking(), net);
     return PetriEngine::PQL::evaluate(query, e);
 }
 
@@ -56,35 +59,40 @@ Condition::Result OnTheFlyDG::fastEval(Condition* query, Marking* unfolded)
     return PetriEngine::PQL::evaluate(query, e);
 }
 
-std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
+std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c, uint32_t worker)
 {
-    PetriEngine::PQL::DistanceContext context(net, query_marking.marking());
+    auto& w = *_workers[worker];
+    PetriEngine::PQL::DistanceContext context(net, w.query_marking.marking());
     PetriConfig *v = static_cast<PetriConfig*>(c);
-    trie.unpack(v->marking, encoder.scratchpad().raw());
-    encoder.decode(query_marking.marking(), encoder.scratchpad().raw());
+    {
+        std::unique_lock<std::mutex> guard(_lock, std::defer_lock);
+        if(_workers.size() > 1) guard.lock();
+        trie.unpack(v->marking, w.encoder.scratchpad().raw());
+    }
+    w.encoder.decode(w.query_marking.marking(), w.encoder.scratchpad().raw());
     //    v->printConfiguration();
     std::vector<Edge*> succs;
     auto query_type = v->query->getQueryType();
     if(query_type == EVAL){
         assert(false);
         //assert(false && "Someone told me, this was a bad place to be.");
-        if (fastEval(query, &query_marking) == Condition::RTRUE){
-            succs.push_back(newEdge(*v, 0));///*v->query->distance(context))*/0);
+        if (fastEval(query, &w.query_marking) == Condition::RTRUE){
+            succs.push_back(newEdge(*v, 0, worker));///*v->query->distance(context))*/0);
         }
     }
     else if (query_type == LOPERATOR){
         if(v->query->getQuantifier() == NEG){
             // no need to try to evaluate here -- this is already transient in other evaluations.
             auto cond = static_cast<NotCondition*>(v->query);
-            Configuration* c = createConfiguration(v->marking, v->getOwner(), (*cond)[0]);
-            Edge* e = newEdge(*v, /*v->query->distance(context)*/0);
+            Configuration* c = createConfiguration(v->marking, v->getOwner(), (*cond)[0], worker);
+            Edge* e = newEdge(*v, /*v->query->distance(context)*/0, worker);
             e->is_negated = true;
-            if (!e->addTarget(c)) {
+            if (!e->addTarget(c, targets(), worker)) {
                 succs.push_back(e);
             }
             else {
                 --e->refcnt;
-                release(e);
+                release(e, worker);
             }
         }
         else if(v->query->getQuantifier() == AND){
@@ -93,7 +101,7 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
             std::vector<Condition*> conds;
             for(auto& c : *cond)
             {
-                auto res = fastEval(c.get(), &query_marking);
+                auto res = fastEval(c.get(), &w.query_marking);
                 if(res == Condition::RFALSE)
                 {
                     return succs;
@@ -104,7 +112,7 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
                 }
             }
 
-            Edge *e = newEdge(*v, /*cond->distance(context)*/0);
+            Edge *e = newEdge(*v, /*cond->distance(context)*/0, worker);
 
             //If we get here, then either both propositions are true (shouldn't be possible)
             //Or a temporal operator and a true proposition
@@ -112,12 +120,12 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
             for(auto c : conds)
             {
                 assert(PetriEngine::PQL::isTemporal(c));
-                if (e->addTarget(createConfiguration(v->marking, v->getOwner(), c)))
+                if (e->addTarget(createConfiguration(v->marking, v->getOwner(), c, worker), targets(), worker))
                     break;
             }
             if (e->handled) {
                 --e->refcnt;
-                release(e);
+                release(e, worker);
             }
             else
                 succs.push_back(e);
@@ -128,10 +136,10 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
             std::vector<Condition*> conds;
             for(auto& c : *cond)
             {
-                auto res = fastEval(c.get(), &query_marking);
+                auto res = fastEval(c.get(), &w.query_marking);
                 if(res == Condition::RTRUE)
                 {
-                    succs.push_back(newEdge(*v, 0));
+                    succs.push_back(newEdge(*v, 0, worker));
                     return succs;
                 }
                 if(res == Condition::RUNKNOWN)
@@ -146,10 +154,10 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
             for(auto c : conds)
             {
                 assert(PetriEngine::PQL::isTemporal(c));
-                Edge *e = newEdge(*v, /*cond->distance(context)*/0);
-                if (e->addTarget(createConfiguration(v->marking, v->getOwner(), c))) {
+                Edge *e = newEdge(*v, /*cond->distance(context)*/0, worker);
+                if (e->addTarget(createConfiguration(v->marking, v->getOwner(), c, worker), targets(), worker)) {
                     --e->refcnt;
-                    release(e);
+                    release(e, worker);
                 }
                 else
                     succs.push_back(e);
@@ -164,35 +172,35 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
             if (v->query->getPath() == U){
                 auto cond = static_cast<AUCondition*>(v->query);
                 Edge *right = nullptr;
-                auto r1 = fastEval((*cond)[1], &query_marking);
+                auto r1 = fastEval((*cond)[1], &w.query_marking);
                 if (r1 != Condition::RUNKNOWN){
                     //right side is not temporal, eval it right now!
                     if (r1 == Condition::RTRUE) {    //satisfied, no need to go through successors
-                        succs.push_back(newEdge(*v, 0));
+                        succs.push_back(newEdge(*v, 0, worker));
                         return succs;
                     }//else: It's not valid, no need to add any edge, just add successors
                 }
                 else {
                     //right side is temporal, we need to evaluate it as normal
-                    Configuration* c = createConfiguration(v->marking, v->getOwner(), (*cond)[1]);
-                    right = newEdge(*v, /*(*cond)[1]->distance(context)*/0);
-                    right->addTarget(c);
+                    Configuration* c = createConfiguration(v->marking, v->getOwner(), (*cond)[1], worker);
+                    right = newEdge(*v, /*(*cond)[1]->distance(context)*/0, worker);
+                    right->addTarget(c, targets(), worker);
                 }
                 bool valid = false;
                 Configuration *left = nullptr;
-                auto r0 = fastEval((*cond)[0], &query_marking);
+                auto r0 = fastEval((*cond)[0], &w.query_marking);
                 if (r0 != Condition::RUNKNOWN) {
                     //left side is not temporal, eval it right now!
                     valid = r0 == Condition::RTRUE;
                 } else {
                     //left side is temporal, include it in the edge
-                    left = createConfiguration(v->marking, v->getOwner(), (*cond)[0]);
+                    left = createConfiguration(v->marking, v->getOwner(), (*cond)[0], worker);
                 }
                 if (valid || left != nullptr) {
                     //if left side is guaranteed to be not satisfied, skip successor generation
                     Edge* leftEdge = nullptr;
-                    nextStates (query_marking, cond,
-                                [&](){ leftEdge = newEdge(*v, std::numeric_limits<uint32_t>::max());},
+                    nextStates (w, cond,
+                                [&](){ leftEdge = newEdge(*v, std::numeric_limits<uint32_t>::max(), worker);},
                                 [&](Marking& mark){
                                     auto res = fastEval(cond, &mark);
                                     if(res == Condition::RTRUE) return true;
@@ -200,24 +208,24 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
                                     {
                                         left = nullptr;
                                         --leftEdge->refcnt;
-                                        release(leftEdge);
+                                        release(leftEdge, worker);
                                         leftEdge = nullptr;
                                         return false;
                                     }
                                     context.setMarking(mark.marking());
-                                    Configuration* c = createConfiguration(createMarking(mark), owner(mark, cond), cond);
-                                    return !leftEdge->addTarget(c);
+                                    Configuration* c = createConfiguration(createMarking(mark, worker), owner(mark, cond), cond, worker);
+                                    return !leftEdge->addTarget(c, targets(), worker);
                                 },
                                 [&]()
                                 {
                                     if(leftEdge)
                                     {
                                         if (left != nullptr) {
-                                            leftEdge->addTarget(left);
+                                            leftEdge->addTarget(left, targets(), worker);
                                         }
                                         if (leftEdge->handled){
                                             --leftEdge->refcnt;
-                                            release(leftEdge);
+                                            release(leftEdge, worker);
                                             leftEdge = nullptr;
                                         }
                                         else
@@ -230,7 +238,7 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
                 if (right != nullptr) {
                     if (right->handled){
                         --right->refcnt;
-                        release(right);
+                        release(right, worker);
                     }
                     else
                         succs.push_back(right);
@@ -239,21 +247,21 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
             else if(v->query->getPath() == F){
                 auto cond = static_cast<AFCondition*>(v->query);
                 Edge *subquery = nullptr;
-                auto r = fastEval((*cond)[0], &query_marking);
+                auto r = fastEval((*cond)[0], &w.query_marking);
                 if (r != Condition::RUNKNOWN) {
                     bool valid = r == Condition::RTRUE;
                     if (valid) {
-                        succs.push_back(newEdge(*v, 0));
+                        succs.push_back(newEdge(*v, 0, worker));
                         return succs;
                     }
                 } else {
-                    subquery = newEdge(*v, /*cond->distance(context)*/0);
-                    Configuration* c = createConfiguration(v->marking, v->getOwner(), (*cond)[0]);
-                    subquery->addTarget(c); // cannot be self-loop since the formula is smaller
+                    subquery = newEdge(*v, /*cond->distance(context)*/0, worker);
+                    Configuration* c = createConfiguration(v->marking, v->getOwner(), (*cond)[0], worker);
+                    subquery->addTarget(c, targets(), worker); // cannot be self-loop since the formula is smaller
                 }
                 Edge* e1 = nullptr;
-                nextStates(query_marking, cond,
-                        [&](){e1 = newEdge(*v, std::numeric_limits<uint32_t>::max());},
+                nextStates(w, cond,
+                        [&](){e1 = newEdge(*v, std::numeric_limits<uint32_t>::max(), worker);},
                         [&](Marking& mark)
                         {
                             auto res = fastEval(cond, &mark);
@@ -263,21 +271,21 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
                                 if(subquery)
                                 {
                                     --subquery->refcnt;
-                                    release(subquery);
+                                    release(subquery, worker);
                                     subquery = nullptr;
                                 }
-                                e1->targets.clear();
+                                targets().clear(e1->targets, worker);
                                 return false;
                             }
                             context.setMarking(mark.marking());
-                            Configuration* c = createConfiguration(createMarking(mark), owner(mark, cond), cond);
-                            return !e1->addTarget(c);
+                            Configuration* c = createConfiguration(createMarking(mark, worker), owner(mark, cond), cond, worker);
+                            return !e1->addTarget(c, targets(), worker);
                         },
                         [&]()
                         {
                             if (e1->handled) {
                                 --e1->refcnt;
-                                release(e1);
+                                release(e1, worker);
                             }
                             else
                                 succs.push_back(e1);
@@ -290,10 +298,10 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
             }
             else if(v->query->getPath() == X){
                 auto cond = static_cast<AXCondition*>(v->query);
-                Edge* e = newEdge(*v, std::numeric_limits<uint32_t>::max());
+                Edge* e = newEdge(*v, std::numeric_limits<uint32_t>::max(), worker);
                 Condition::Result allValid = Condition::RTRUE;
                 // no possible self-loops from AX q
-                nextStates(query_marking, cond,
+                nextStates(w, cond,
                         [](){},
                         [&](Marking& mark){
                             auto res = fastEval((*cond)[0], &mark);
@@ -308,8 +316,8 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
                             {
                                 allValid = Condition::RUNKNOWN;
                                 context.setMarking(mark.marking());
-                                Configuration* c = createConfiguration(createMarking(mark), v->getOwner(), (*cond)[0]);
-                                e->addTarget(c);
+                                Configuration* c = createConfiguration(createMarking(mark, worker), v->getOwner(), (*cond)[0], worker);
+                                e->addTarget(c, targets(), worker);
                             }
                             return true;
                         },
@@ -321,7 +329,7 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
                     }
                     else if(allValid == Condition::RTRUE)
                     {
-                        e->targets.clear();
+                        targets().clear(e->targets, worker);
                         succs.push_back(e);
                     }
                     else
@@ -338,15 +346,15 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
             if (v->query->getPath() == U){
                 auto cond = static_cast<EUCondition*>(v->query);
                 Edge *right = nullptr;
-                auto r1 = fastEval((*cond)[1], &query_marking);
+                auto r1 = fastEval((*cond)[1], &w.query_marking);
                 if (r1 == Condition::RUNKNOWN) {
-                    Configuration* c = createConfiguration(v->marking, v->getOwner(), (*cond)[1]);
-                    right = newEdge(*v, /*(*cond)[1]->distance(context)*/0);
-                    right->addTarget(c);
+                    Configuration* c = createConfiguration(v->marking, v->getOwner(), (*cond)[1], worker);
+                    right = newEdge(*v, /*(*cond)[1]->distance(context)*/0, worker);
+                    right->addTarget(c, targets(), worker);
                 } else {
                     bool valid = r1 == Condition::RTRUE;
                     if (valid) {
-                        succs.push_back(newEdge(*v, 0));
+                        succs.push_back(newEdge(*v, 0, worker));
                         return succs;
                     }   // else: right condition is not satisfied, no need to add an edge
                 }
@@ -354,11 +362,11 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
 
                 Configuration *left = nullptr;
                 bool valid = false;
-                nextStates(query_marking, cond,
+                nextStates(w, cond,
                     [&](){
-                        auto r0 = fastEval((*cond)[0], &query_marking);
+                        auto r0 = fastEval((*cond)[0], &w.query_marking);
                         if (r0 == Condition::RUNKNOWN) {
-                            left = createConfiguration(v->marking, v->getOwner(), (*cond)[0]);
+                            left = createConfiguration(v->marking, v->getOwner(), (*cond)[0], worker);
                         } else {
                             valid = r0 == Condition::RTRUE;
                         }
@@ -369,34 +377,34 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
                         if(res == Condition::RFALSE) return true;
                         if(res == Condition::RTRUE)
                         {
-                            for(auto s : succs){ --s->refcnt; release(s);}
+                            for(auto s : succs){ --s->refcnt; release(s, worker);}
                             succs.clear();
-                            succs.push_back(newEdge(*v, 0));
+                            succs.push_back(newEdge(*v, 0, worker));
                             if(right && (left == nullptr && valid))
                             {
                                 // we don't need to validate right IF left
                                 // is trivially satisfied and we have a satisfied
                                 // successor.
                                 --right->refcnt;
-                                release(right);
+                                release(right, worker);
                                 right = nullptr;
                             }
 
                             if(left)
-                                succs.back()->addTarget(left);
+                                succs.back()->addTarget(left, targets(), worker);
 
                             return false;
                         }
                         context.setMarking(marking.marking());
-                        Edge* e = newEdge(*v, /*cond->distance(context)*/0);
-                        Configuration* c1 = createConfiguration(createMarking(marking), owner(marking, cond), cond);
-                        e->addTarget(c1);
+                        Edge* e = newEdge(*v, /*cond->distance(context)*/0, worker);
+                        Configuration* c1 = createConfiguration(createMarking(marking, worker), owner(marking, cond), cond, worker);
+                        e->addTarget(c1, targets(), worker);
                         if (left != nullptr) {
-                            e->addTarget(left);
+                            e->addTarget(left, targets(), worker);
                         }
                         if (e->handled) {
                             --e->refcnt;
-                            release(e);
+                            release(e, worker);
                             // we _don't_ abort suc generation, since EU will have many out-edges
                         }
                         else
@@ -407,7 +415,7 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
                 if (right != nullptr) {
                     if (right->handled) {
                         --right->refcnt;
-                        release(right);
+                        release(right, worker);
                     }
                     else
                         succs.push_back(right);
@@ -416,46 +424,46 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
             else if(v->query->getPath() == F){
                 auto cond = static_cast<EFCondition*>(v->query);
                 Edge *subquery = nullptr;
-                auto r = fastEval((*cond)[0], &query_marking);
+                auto r = fastEval((*cond)[0], &w.query_marking);
                 if (r != Condition::RUNKNOWN) {
                     bool valid = r == Condition::RTRUE;
                     if (valid) {
-                        succs.push_back(newEdge(*v, 0));
+                        succs.push_back(newEdge(*v, 0, worker));
                         return succs;
                     }
                 } else {
-                    Configuration* c = createConfiguration(v->marking, v->getOwner(), (*cond)[0]);
-                    subquery = newEdge(*v, /*cond->distance(context)*/0);
-                    subquery->addTarget(c);
+                    Configuration* c = createConfiguration(v->marking, v->getOwner(), (*cond)[0], worker);
+                    subquery = newEdge(*v, /*cond->distance(context)*/0, worker);
+                    subquery->addTarget(c, targets(), worker);
                 }
 
-                nextStates(query_marking, cond,
+                nextStates(w, cond,
                             [](){},
                             [&](Marking& mark){
                                 auto res = fastEval(cond, &mark);
                                 if(res == Condition::RFALSE) return true;
                                 if(res == Condition::RTRUE)
                                 {
-                                    for(auto s : succs){ --s->refcnt; release(s);}
+                                    for(auto s : succs){ --s->refcnt; release(s, worker);}
                                     succs.clear();
-                                    succs.push_back(newEdge(*v, 0));
+                                    succs.push_back(newEdge(*v, 0, worker));
                                     if(subquery)
                                     {
                                         --subquery->refcnt;
-                                        release(subquery);
+                                        release(subquery, worker);
                                     }
                                     subquery = nullptr;
                                     return false;
                                 }
                                 context.setMarking(mark.marking());
-                                Edge* e = newEdge(*v, /*cond->distance(context)*/0);
-                                Configuration* c = createConfiguration(createMarking(mark), owner(mark, cond), cond);
-                                e->addTarget(c);
+                                Edge* e = newEdge(*v, /*cond->distance(context)*/0, worker);
+                                Configuration* c = createConfiguration(createMarking(mark, worker), owner(mark, cond), cond, worker);
+                                e->addTarget(c, targets(), worker);
                                 if (!e->handled)
                                     succs.push_back(e);
                                 else {
                                     --e->refcnt;
-                                    release(e);
+                                    release(e, worker);
                                 }
                                 return true;
                             },
@@ -469,23 +477,23 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
             else if(v->query->getPath() == X){
                 auto cond = static_cast<EXCondition*>(v->query);
                 auto query = (*cond)[0];
-                nextStates(query_marking, cond,
+                nextStates(w, cond,
                         [](){},
                         [&](Marking& marking) {
                             auto res = fastEval(query, &marking);
                             if(res == Condition::RTRUE)
                             {
-                                for(auto s : succs){ --s->refcnt; release(s);}
+                                for(auto s : succs){ --s->refcnt; release(s, worker);}
                                 succs.clear();
-                                succs.push_back(newEdge(*v, 0));
+                                succs.push_back(newEdge(*v, 0, worker));
                                 return false;
                             }   //else: It can't hold there, no need to create an edge
                             else if(res == Condition::RUNKNOWN)
                             {
                                 context.setMarking(marking.marking());
-                                Edge* e = newEdge(*v, /*(*cond)[0]->distance(context)*/0);
-                                Configuration* c = createConfiguration(createMarking(marking), v->getOwner(), query);
-                                e->addTarget(c);
+                                Edge* e = newEdge(*v, /*(*cond)[0]->distance(context)*/0, worker);
+                                Configuration* c = createConfiguration(createMarking(marking, worker), v->getOwner(), query, worker);
+                                e->addTarget(c, targets(), worker);
                                 succs.push_back(e);
                             }
                             return true;
@@ -515,34 +523,54 @@ std::vector<DependencyGraph::Edge*> OnTheFlyDG::successors(Configuration *c)
 
 Configuration* OnTheFlyDG::initialConfiguration()
 {
-    if(working_marking.marking() == nullptr)
+    auto& w = *_workers[0];
+    if(w.working_marking.marking() == nullptr)
     {
-        working_marking.setMarking  (net->makeInitialMarking());
-        query_marking.setMarking    (net->makeInitialMarking());
-        auto o = owner(working_marking, this->query);
-        initial_config = createConfiguration(createMarking(working_marking), o, this->query);
+        for(auto& other : _workers)
+        {
+            other->working_marking.setMarking  (net->makeInitialMarking());
+            other->query_marking.setMarking    (net->makeInitialMarking());
+        }
+        auto o = owner(w.working_marking, this->query);
+        initial_config = createConfiguration(createMarking(w.working_marking, 0), o, this->query, 0);
     }
     return initial_config;
 }
 
 
-void OnTheFlyDG::nextStates(Marking& t_marking, Condition* ptr,
+void OnTheFlyDG::nextStates(worker_t& w, Condition* ptr,
     std::function<void ()> pre,
     std::function<bool (Marking&)> foreach,
     std::function<void ()> post)
 {
     bool first = true;
-    memcpy(working_marking.marking(), query_marking.marking(), n_places*sizeof(PetriEngine::MarkVal));
+    memcpy(w.working_marking.marking(), w.query_marking.marking(), n_places*sizeof(PetriEngine::MarkVal));
     auto qf = static_cast<QuantifierCondition*>(ptr);
     if(!_partial_order || ptr->getQuantifier() != E || ptr->getPath() != F || PetriEngine::PQL::isTemporal((*qf)[0]))
     {
-        PetriEngine::SuccessorGenerator PNGen(*net);
-        dowork<PetriEngine::SuccessorGenerator>(PNGen, first, pre, foreach);
+        auto id = _cache ? _cache->lookup(w.query_marking) : std::make_pair(false, size_t{0});
+        if(id.first)
+        {
+            auto succs = _cache->successors(id.second);
+            for(auto it = succs.first; it != succs.second; ++it)
+            {
+                _cache->decode(w.working_marking, *it);
+                if(first) pre();
+                first = false;
+                if(!foreach(w.working_marking))
+                    break;
+            }
+        }
+        else
+        {
+            PetriEngine::SuccessorGenerator PNGen(*net);
+            dowork<PetriEngine::SuccessorGenerator>(w, PNGen, first, pre, foreach);
+        }
     }
     else
     {
         _redgen.setQuery(ptr);
-        dowork<PetriEngine::ReducingSuccessorGenerator>(_redgen, first, pre, foreach);
+        dowork<PetriEngine::ReducingSuccessorGenerator>(w, _redgen, first, pre, foreach);
     }
 
     if(!first) post();
@@ -550,10 +578,13 @@ void OnTheFlyDG::nextStates(Marking& t_marking, Condition* ptr,
 
 void OnTheFlyDG::cleanUp()
 {
-    while(!recycle.empty())
+    for(auto& w : _workers)
     {
-        assert(recycle.top()->refcnt == -1);
-        recycle.pop();
+        while(!w->recycle.empty())
+        {
+            assert(w->recycle.top()->refcnt == -1);
+            w->recycle.pop();
+        }
     }
     // TODO, implement proper cleanup
 }
@@ -562,10 +593,13 @@ void OnTheFlyDG::cleanUp()
 void OnTheFlyDG::setQuery(Condition* query)
 {
     this->query = query;
-    delete[] working_marking.marking();
-    delete[] query_marking.marking();
-    working_marking.setMarking(nullptr);
-    query_marking.setMarking(nullptr);
+    for(auto& w : _workers)
+    {
+        delete[] w->working_marking.marking();
+        delete[] w->query_marking.marking();
+        w->working_marking.setMarking(nullptr);
+        w->query_marking.setMarking(nullptr);
+    }
     initialConfiguration();
     assert(this->query);
 }
@@ -584,28 +618,37 @@ size_t OnTheFlyDG::maxTokens() const {
     return _maxTokens;
 }
 
-PetriConfig *OnTheFlyDG::createConfiguration(size_t marking, size_t own, Condition* t_query)
+PetriConfig *OnTheFlyDG::createConfiguration(size_t marking, size_t own, Condition* t_query, uint32_t worker)
 {
-    auto& configs = trie.get_data(marking);
-    for(PetriConfig* c : configs){
+    std::unique_lock<std::mutex> guard(_lock, std::defer_lock);
+    if(_workers.size() > 1) guard.lock();
+    // the configurations of a marking are chained through their siblings
+    auto& latest = trie.get_data(marking);
+    for(auto handle = latest; handle != 0;){
+        PetriConfig* c = configuration(handle);
         if(c->query == t_query)
             return c;
+        handle = c->sibling;
     }
 
+    size_t id = conf_alloc->next(worker);
+    if(id >= std::numeric_limits<uint32_t>::max())
+        throw base_error("The dependency graph exceeds 2^32 configurations");
     _configurationCount++;
-    size_t id = conf_alloc->next(0);
     char* mem = (*conf_alloc)[id];
     PetriConfig* newConfig = new (mem) PetriConfig();
     newConfig->marking = marking;
     newConfig->query = t_query;
     newConfig->setOwner(own);
-    configs.push_back(newConfig);
+    newConfig->sibling = latest;
+    latest = id + 1;
     return newConfig;
 }
 
 
 
-size_t OnTheFlyDG::createMarking(Marking& t_marking){
+size_t OnTheFlyDG::createMarking(Marking& t_marking, uint32_t worker){
+    auto& encoder = _workers[worker]->encoder;
     size_t sum = 0;
     bool allsame = true;
     uint32_t val = 0;
@@ -615,7 +658,11 @@ size_t OnTheFlyDG::createMarking(Marking& t_marking){
     unsigned char type = encoder.getType(sum, active, allsame, val);
     size_t length = encoder.encode(t_marking.marking(), type);
     binarywrapper_t w = binarywrapper_t(encoder.scratchpad().raw(), length*8);
+    std::unique_lock<std::mutex> guard(_lock, std::defer_lock);
+    if(_workers.size() > 1) guard.lock();
     auto tit = trie.insert(w.raw(), w.size());
+    if(tit.second >= std::numeric_limits<uint32_t>::max())
+        throw base_error("The dependency graph exceeds 2^32 markings");
     if(tit.first){
         _markingCount++;
         _maxTokens = std::max(sum, _maxTokens);
@@ -624,16 +671,16 @@ size_t OnTheFlyDG::createMarking(Marking& t_marking){
     return tit.second;
 }
 
-void OnTheFlyDG::release(Edge* e)
+void OnTheFlyDG::release(Edge* e, uint32_t worker)
 {
     assert(e->refcnt == 0);
     e->is_negated = false;
     e->processed = false;
     e->source = nullptr;
-    e->targets.clear();
+    targets().clear(e->targets, worker);
     e->refcnt = -1;
     e->handled = false;
-    recycle.push(e);
+    _workers[worker]->recycle.push(e);
 }
 
 size_t OnTheFlyDG::owner(Marking& marking, Condition* cond) {
@@ -642,12 +689,13 @@ size_t OnTheFlyDG::owner(Marking& marking, Condition* cond) {
 }
 
 
-Edge* OnTheFlyDG::newEdge(Configuration &t_source, uint32_t weight)
+Edge* OnTheFlyDG::newEdge(Configuration &t_source, uint32_t weight, uint32_t worker)
 {
     Edge* e = nullptr;
+    auto& recycle = _workers[worker]->recycle;
     if(recycle.empty())
     {
-        size_t n = edge_alloc->next(0);
+        size_t n = edge_alloc->next(worker);
         e = &(*edge_alloc)[n];
     }
     else
@@ -28,7 +28,6 @@ void RDFSSearch::pushToW(DependencyGraph::Edge* edge) {
     W.push_back(edge);
 }
 
-auto rng = std::default_random_engine {};
 void RDFSSearch::flush() {
     last_parent = std::min(last_parent, W.size());
     std::shuffle(W.begin() + last_parent, W.end(), rng);
@@ -19,7 +19,7 @@ namespace SearchStrategy{
         bool allOne = true;
         bool hasCZero = false;
 
-        for (DependencyGraph::Configuration *c : edge->targets) {
+        for (DependencyGraph::Configuration *c : _targets->items(edge->targets)) {
             if (c->assignment == DependencyGraph::Assignment::CZERO) {
                 hasCZero = true;
                 break;
@@ -116,7 +116,7 @@ namespace SearchStrategy{
             bool allOne = true;
             bool hasCZero = false;
             auto e = *it;
-            for (DependencyGraph::Configuration *c : e->targets) {
+            for (DependencyGraph::Configuration *c : _targets->items(e->targets)) {
                 if (c->assignment == DependencyGraph::Assignment::CZERO) {
                     hasCZero = true;
                     break;
@@ -297,6 +297,11 @@ namespace LTL {
         return std::make_pair(spot_formula, spotConverter.apInfo());
     }
 
+    std::mutex& spot_mutex() {
+        static std::mutex lock;
+        return lock;
+    }
+
     Structures::BuchiAutomaton make_buchi_automaton(const PetriEngine::PQL::Condition_ptr &query, BuchiOptimization optimization, APCompression compression) {
         auto [formula, apinfo] = to_spot_formula(query, compression);
         formula = spot::formula::Not(formula);
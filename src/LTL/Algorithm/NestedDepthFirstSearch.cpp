@@ -99,7 +99,7 @@ namespace LTL {
             auto res = states.add(state);
             if (std::get<0>(res)) {
                 dfs(successor_generator, states, std::get<1>(res));
-                if(_violation)
+                if(_violation || stopped())
                     break;
             }
         }
@@ -116,7 +116,7 @@ namespace LTL {
 
         todo.push_back(stack_entry_t<T>{init, successor_generator.initial_suc_info()});
 
-        while (!todo.empty()) {
+        while (!todo.empty() && !stopped()) {
             auto &top = todo.back();
             states.decode(curState, top._id);
             successor_generator.prepare(&curState, top._sucinfo);
@@ -168,7 +168,7 @@ namespace LTL {
 
         nested_todo.push_back(stack_entry_t<T>{std::get<1>(states.add(state)), successor_generator.initial_suc_info()});
 
-        while (!nested_todo.empty()) {
+        while (!nested_todo.empty() && !stopped()) {
             auto &top = nested_todo.back();
             states.decode(curState, top._id);
             successor_generator.prepare(&curState, top._sucinfo);
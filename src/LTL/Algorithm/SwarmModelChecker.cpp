@@ -0,0 +1,133 @@
+/* Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LTL/Algorithm/SwarmModelChecker.h"
+
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace LTL {
+
+    SwarmModelChecker::SwarmModelChecker(const PetriEngine::PetriNet& net, const PetriEngine::PQL::Condition_ptr &query,
+                                         const Structures::BuchiAutomaton &buchi,
+                                         std::vector<std::unique_ptr<ModelChecker>>&& checkers)
+    : ModelChecker(net, query, buchi), _checkers(std::move(checkers))
+    {
+        assert(!_checkers.empty());
+        for (auto& c : _checkers)
+            c->add_stop_flag(&_done);
+    }
+
+    void SwarmModelChecker::add_stop_flag(const std::atomic<bool>* stop)
+    {
+        ModelChecker::add_stop_flag(stop);
+        for (auto& c : _checkers)
+            c->add_stop_flag(stop);
+    }
+
+    void SwarmModelChecker::set_memory_flag(const std::atomic<bool>* exhausted)
+    {
+        ModelChecker::set_memory_flag(exhausted);
+        for (auto& c : _checkers)
+            c->set_memory_flag(exhausted);
+    }
+
+    bool SwarmModelChecker::out_of_memory() const
+    {
+        for (auto& c : _checkers)
+            if (c->out_of_memory())
+                return true;
+        return false;
+    }
+
+    bool SwarmModelChecker::check()
+    {
+        std::mutex lock;
+        std::exception_ptr error;
+        bool found = false;
+        bool result = true;
+        auto worker = [&](size_t id) {
+            try {
+                auto res = _checkers[id]->check();
+                std::lock_guard<std::mutex> guard(lock);
+                // _done is only raised under this lock, so a checker finishing
+                // before anybody raised it has run to completion.
+                if (!found) {
+                    found = true;
+                    _winner = id;
+                    result = res;
+                    _done = true;
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(lock);
+                if (!found) {
+                    found = true;
+                    error = std::current_exception();
+                    _done = true;
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < _checkers.size(); ++i)
+            threads.emplace_back(worker, i);
+        worker(0);
+        for (auto& t : threads)
+            t.join();
+
+        if (error)
+            std::rethrow_exception(error);
+
+        auto& winner = *_checkers[_winner];
+        _explored = winner.get_explored();
+        _expanded = winner.get_expanded();
+        _trace = winner.trace();
+        _loop = winner.loop_index();
+        _violation = !result;
+        return result;
+    }
+
+    void SwarmModelChecker::print_stats(std::ostream &os) const
+    {
+        _checkers[_winner]->print_stats(os);
+    }
+
+    size_t SwarmModelChecker::max_tokens() const
+    {
+        return _checkers[_winner]->max_tokens();
+    }
+
+    size_t SwarmModelChecker::get_discovered() const
+    {
+        return _checkers[_winner]->get_discovered();
+    }
+
+    size_t SwarmModelChecker::get_markings() const
+    {
+        return _checkers[_winner]->get_markings();
+    }
+
+    size_t SwarmModelChecker::get_configurations() const
+    {
+        return _checkers[_winner]->get_configurations();
+    }
+
+    LTLPartialOrder SwarmModelChecker::used_partial_order() const
+    {
+        return _checkers[_winner]->used_partial_order();
+    }
+}
@@ -58,6 +58,11 @@ namespace LTL {
     bool TarjanModelChecker::check() {
         if(_heuristic != nullptr || _order != LTLPartialOrder::None)
         {
+            // The automaton based reductions build and destroy BDDs with the generators, which needs
+            // the spot lock; the search itself only takes it to evaluate a guard.
+            std::unique_lock<std::mutex> lock(spot_mutex(), std::defer_lock);
+            if (_order == LTLPartialOrder::Liebke || _order == LTLPartialOrder::Automaton)
+                lock.lock();
             // we need advanced successor generator pipeline (we need to look at successors)
             std::unique_ptr<SuccessorSpooler> spooler;
             SpoolingSuccessorGenerator gen{_net, _formula};
@@ -77,11 +82,11 @@ namespace LTL {
             if(_order == LTLPartialOrder::Automaton)
             {
                 ReachStubProductSuccessorGenerator succ_gen(_net, _buchi, gen, std::make_unique<EnabledSpooler>(_net, gen));
-                return select_trace_compute(succ_gen);
+                return compute_unlocked(lock, succ_gen);
             }
             else {
                 ProductSuccessorGenerator succ_gen(_net, _buchi, gen);
-                return select_trace_compute(succ_gen);
+                return compute_unlocked(lock, succ_gen);
             }
         }
         else
@@ -92,6 +97,20 @@ namespace LTL {
         }
     }
 
+    template<typename SuccGen>
+    bool TarjanModelChecker::compute_unlocked(std::unique_lock<std::mutex>& lock, SuccGen& successorGenerator)
+    {
+        if (!lock.owns_lock())
+            return select_trace_compute(successorGenerator);
+        lock.unlock();
+        // relock even when the search throws, the generators are destroyed under the lock
+        struct relock_t {
+            std::unique_lock<std::mutex>& _lock;
+            ~relock_t() { _lock.lock(); }
+        } relock{lock};
+        return select_trace_compute(successorGenerator);
+    }
+
     template<typename SuccGen>
     bool TarjanModelChecker::select_trace_compute(SuccGen& successorGenerator)
     {
@@ -121,12 +140,12 @@ namespace LTL {
         State working = _factory.new_state();
         State parent = _factory.new_state();
         for (auto &state : initial_states) {
-            if(_violation) break;
+            if(_violation || stopped()) break;
             const auto res = seen.add(state);
             if (std::get<0>(res)) {
                 push(seen, cstack, dstack, successorGenerator, state, std::get<1>(res));
             }
-            while (!dstack.empty() && !_violation) {
+            while (!dstack.empty() && !_violation && !stopped()) {
                 auto &dtop = dstack.back();
                 // write next successor state to working.
                 if (!next_trans(seen, cstack, successorGenerator, working, parent, dtop)) {
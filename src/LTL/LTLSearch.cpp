@@ -23,11 +23,13 @@
 #include "LTL/SuccessorGeneration/SpoolingSuccessorGenerator.h"
 #include "LTL/Algorithm/NestedDepthFirstSearch.h"
 #include "LTL/Algorithm/TarjanModelChecker.h"
+#include "LTL/Algorithm/SwarmModelChecker.h"
 
 #include "PetriEngine/PQL/PredicateCheckers.h"
 #include "PetriEngine/PQL/PQL.h"
 #include "PetriEngine/PQL/Expressions.h"
 #include "PetriEngine/options.h"
+#include "utils/MemoryBudget.h"
 
 #include <utility>
 
@@ -140,13 +142,25 @@ namespace LTL {
         }
         _traces.clear();
         std::tie(_negated_formula, _negated_answer) = to_ltl(query, _traces);
+        std::lock_guard<std::mutex> guard(spot_mutex());
         _buchi = make_buchi_automaton(_negated_formula, optimization, compression);
     }
 
+    LTLSearch::~LTLSearch()
+    {
+        // checkers, heuristics and the automaton may all own BDDs
+        std::lock_guard<std::mutex> guard(spot_mutex());
+        _checker.reset();
+        _swarm_heuristics.clear();
+        _heuristic.reset();
+        _buchi = Structures::BuchiAutomaton();
+    }
+
     void LTLSearch::print_buchi(std::ostream& out, const BuchiOutType type)
     {
         if(_compression != APCompression::None)
             throw base_error("Printing of Büchi automata only supported with APCompression::None");
+        std::lock_guard<std::mutex> guard(spot_mutex());
         _buchi.output_buchi(out, type);
     }
 
@@ -226,28 +240,58 @@ namespace LTL {
                             const Strategy search_strategy,
                             const LTLHeuristic heuristics_flag,
                             const bool utilize_weak,
-                            const uint64_t seed) {
+                            const uint64_t seed,
+                            const uint32_t threads) {
 
+        std::unique_lock<std::mutex> lock(spot_mutex());
         _heuristic = make_heuristic(_net, _negated_formula, _buchi, search_strategy, heuristics_flag, seed);
 
-        switch (algorithm) {
-            case Algorithm::NDFS:
-            {
-                _checker = std::make_unique<NestedDepthFirstSearch>(_net, _negated_formula, _buchi, k_bound, _traces.size());
-                break;
+        // the members of a swarm split the memory of a single search
+        auto make_checker = [&](Heuristic* heuristic, LTLPartialOrder order, uint32_t members) {
+            std::unique_ptr<ModelChecker> checker;
+            switch (algorithm) {
+                case Algorithm::NDFS:
+                {
+                    checker = std::make_unique<NestedDepthFirstSearch>(_net, _negated_formula, _buchi, k_bound, _traces.size());
+                    break;
+                }
+                case Algorithm::Tarjan:
+                    checker = std::make_unique<TarjanModelChecker>(_net, _negated_formula, _buchi, k_bound, _traces.size(),
+                                                                   TarjanModelChecker::DEFAULT_HASH_SIZE / members);
+                    break;
+                case Algorithm::None:
+                default:
+                    assert(false);
+                    throw base_error("Cannot LTL verify with algorithm None");
+            }
+            checker->set_utilize_weak(utilize_weak);
+            checker->set_heuristic(heuristic);
+            checker->set_partial_order(order);
+            checker->set_tracing(trace);
+            return checker;
+        };
+
+        if (threads <= 1 || _traces.size() > 1) {
+            _checker = make_checker(_heuristic.get(), por, 1);
+        } else {
+            // The first worker runs the search as configured, the others search in random
+            // orders. Partial order reduction relies on BDDs during the search which are not
+            // thread-safe, so only the first worker may use it.
+            std::vector<std::unique_ptr<ModelChecker>> checkers;
+            checkers.emplace_back(make_checker(_heuristic.get(), por, threads));
+            _swarm_heuristics.clear();
+            for (uint32_t i = 1; i < threads; ++i) {
+                _swarm_heuristics.emplace_back(std::make_unique<RandomHeuristic>(seed + i));
+                checkers.emplace_back(make_checker(_swarm_heuristics.back().get(), LTLPartialOrder::None, threads));
             }
-            case Algorithm::Tarjan:
-                _checker = std::make_unique<TarjanModelChecker>(_net, _negated_formula, _buchi, k_bound, _traces.size());
-                break;
-            case Algorithm::None:
-            default:
-                assert(false);
-                std::cerr << "Error: cannot LTL verify with algorithm None";
+            _checker = std::make_unique<SwarmModelChecker>(_net, _negated_formula, _buchi, std::move(checkers));
+            _checker->set_utilize_weak(utilize_weak);
         }
-        _checker->set_utilize_weak(utilize_weak);
-        _checker->set_heuristic(_heuristic.get());
-        _checker->set_partial_order(por);
-        _checker->set_tracing(trace);
+        if (_stop)
+            _checker->add_stop_flag(_stop);
+        _checker->set_memory_flag(MemoryBudget::flag());
+        // the checkers take the lock themselves where the search touches BDDs
+        lock.unlock();
         _result = _checker->check();
         return _result xor _negated_answer;
     }
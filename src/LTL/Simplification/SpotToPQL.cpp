@@ -128,6 +128,7 @@ namespace LTL {
         } else if (auto a = std::dynamic_pointer_cast<ACondition>(formula)) {
             return std::make_shared<ACondition>(simplify((*a)[0], optimization, compression));
         }
+        std::lock_guard<std::mutex> guard(spot_mutex());
         auto[f, apinfo] = LTL::to_spot_formula(formula, compression);
         spot::tl_simplifier simplifier{static_cast<int>(optimization)};
         f = simplifier.simplify(f);
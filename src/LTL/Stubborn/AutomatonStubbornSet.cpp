@@ -158,7 +158,8 @@ namespace LTL {
         }
 
 
-        guard_info_t buchi_state = _state_guards[state->get_buchi_state()];
+        // a reference, copying the guards would touch the BDD reference counts without the spot lock
+        const guard_info_t& buchi_state = _state_guards[state->get_buchi_state()];
 
         PQL::EvaluationContext evaluationContext{_parent->marking(), &_net};
 
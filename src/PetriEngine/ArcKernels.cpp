@@ -0,0 +1,76 @@
+/* Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "PetriEngine/ArcKernels.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define VERIFYPN_ARC_AVX2
+#include <immintrin.h>
+#endif
+
+namespace PetriEngine {
+    namespace ArcKernels {
+        using covers_t = bool (*)(const uint32_t*, const uint32_t*, const uint32_t*, uint32_t);
+
+        static bool coversScalar(const uint32_t* marking, const uint32_t* places, const uint32_t* tokens, uint32_t n)
+        {
+            for (uint32_t i = 0; i < n; ++i)
+                if (marking[places[i]] < tokens[i])
+                    return false;
+            return true;
+        }
+
+#ifdef VERIFYPN_ARC_AVX2
+        __attribute__((target("avx2")))
+        static bool coversAVX2(const uint32_t* marking, const uint32_t* places, const uint32_t* tokens, uint32_t n)
+        {
+            uint32_t i = 0;
+            for (; i + 8 <= n; i += 8)
+            {
+                auto idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(places + i));
+                auto m = _mm256_i32gather_epi32(reinterpret_cast<const int*>(marking), idx, 4);
+                auto w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tokens + i));
+                // unsigned m >= w exactly when max(m, w) == m
+                auto ok = _mm256_cmpeq_epi32(_mm256_max_epu32(m, w), m);
+                if (_mm256_movemask_epi8(ok) != -1)
+                    return false;
+            }
+            return coversScalar(marking, places + i, tokens + i, n - i);
+        }
+#endif
+
+        static covers_t selectCovers()
+        {
+#ifdef VERIFYPN_ARC_AVX2
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2"))
+                return coversAVX2;
+#endif
+            return coversScalar;
+        }
+
+        static const covers_t covers_impl = selectCovers();
+
+        bool coversWide(const uint32_t* marking, const uint32_t* places, const uint32_t* tokens, uint32_t n)
+        {
+            return covers_impl(marking, places, tokens, n);
+        }
+
+        bool vectorised()
+        {
+            return covers_impl != coversScalar;
+        }
+    }
+}
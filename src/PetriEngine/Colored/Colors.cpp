@@ -181,6 +181,8 @@ namespace PetriEngine {
         }
 
         const Color& ProductType::operator[](size_t index) const {
+            // references into the map stay valid after a rehash
+            std::lock_guard<std::mutex> guard(_cache_lock);
             if (_cache.count(index) < 1) {
                 size_t mod = 1;
                 size_t div = 1;
@@ -3,9 +3,218 @@
 #include "PetriEngine/Colored/Unfolder.h"
 #include "PetriEngine/Colored/BindingGenerator.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 namespace PetriEngine {
     namespace Colored {
 
+        // adds the unfolded transitions to a PT builder, naming the places and transitions
+        class Unfolder::BuilderSink {
+        public:
+            BuilderSink(Unfolder& unfolder, PetriNetBuilder& ptBuilder)
+            : _unfolder(unfolder), _ptBuilder(ptBuilder) {}
+
+            void binding(uint32_t transitionId, uint32_t index, const std::vector<UnfoldedArc>& arcs) {
+                const Colored::Transition &transition = _unfolder._builder.transitions()[transitionId];
+                auto name = std::make_shared<const_string>(*transition.name + "_" + std::to_string(index));
+                _ptBuilder.addTransition(name, transition._player, transition._x, transition._y + 15.0 * index);
+
+                for (const auto& arc : arcs) {
+                    _unfolder.addArc(_ptBuilder, arc, name);
+                }
+
+                _unfolder._pttransitionnames[transition.name].push_back(name);
+                _unfolder.unfoldInhibitorArc(_ptBuilder, transition.name, name);
+            }
+
+            void transition(uint32_t transitionId, bool fixpoint, uint32_t bindings) {
+                if (fixpoint && bindings == 0) {
+                    _unfolder._pttransitionnames[_unfolder._builder.transitions()[transitionId].name] = std::vector<shared_const_string>();
+                }
+            }
+
+        private:
+            Unfolder& _unfolder;
+            PetriNetBuilder& _ptBuilder;
+        };
+
+        // lays the unfolded transitions out as the arrays of the compact PT net, and keeps for
+        // each place and transition where it came from, instead of its name
+        class Unfolder::NetSink {
+        public:
+            static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+            // in place of a color: the place summing the tokens of an inhibiting colored place,
+            // or the place with the tokens of a colored place which no unfolded place holds
+            static constexpr uint32_t SUM = NONE - 1;
+            static constexpr uint32_t ORPHAN = NONE - 2;
+
+            struct names_t {
+                std::vector<shared_const_string> coloredPlaces, coloredTransitions;
+                // per PT place the colored place and color id, per PT transition the colored transition and binding
+                std::vector<uint32_t> placeOrigin, placeColor;
+                std::vector<uint32_t> transitionOrigin, transitionBinding;
+
+                std::string place(uint32_t p) const {
+                    const auto& name = *coloredPlaces[placeOrigin[p]];
+                    switch (placeColor[p]) {
+                        case SUM: return name + "Sum";
+                        case ORPHAN: return name + "_orphan";
+                        default: return name + "_" + std::to_string(placeColor[p]);
+                    }
+                }
+
+                std::string transition(uint32_t t) const {
+                    return *coloredTransitions[transitionOrigin[t]] + "_" + std::to_string(transitionBinding[t]);
+                }
+            };
+
+            struct arc_t {
+                uint32_t place;
+                uint32_t weight;
+                bool inhibitor;
+            };
+
+            explicit NetSink(Unfolder& unfolder)
+            : names(std::make_shared<names_t>()), _unfolder(unfolder),
+              _colored(unfolder._builder.places().size()), _inhibitors(unfolder._builder.transitions().size()) {
+                for (const auto& place : unfolder._builder.places()) {
+                    names->coloredPlaces.push_back(place.name);
+                }
+                for (const auto& transition : unfolder._builder.transitions()) {
+                    names->coloredTransitions.push_back(transition.name);
+                }
+                const auto& inhibitors = unfolder._builder.inhibitors();
+                for (uint32_t i = 0; i < inhibitors.size(); ++i) {
+                    _inhibitors[inhibitors[i].transition].push_back(i);
+                }
+            }
+
+            void binding(uint32_t transitionId, uint32_t index, const std::vector<UnfoldedArc>& arcs) {
+                names->transitionOrigin.push_back(transitionId);
+                names->transitionBinding.push_back(index);
+                for (const auto& arc : arcs) {
+                    uint32_t place;
+                    if (arc.shadow) {
+                        place = sumPlace(arc.place, false);
+                        if (arc.weight == 0) continue;
+                    } else {
+                        place = unfoldedPlace(arc.place, arc.color, arc.id);
+                    }
+                    if (arc.input) {
+                        addInput(place, arc.weight, false);
+                    } else {
+                        addOutput(place, arc.weight);
+                    }
+                    ++_unfolder._nptarcs;
+                }
+                for (auto i : _inhibitors[transitionId]) {
+                    const Colored::Arc& inhibitor = _unfolder._builder.inhibitors()[i];
+                    addInput(sumPlace(inhibitor.place, true), inhibitor.inhib_weight, true);
+                }
+                prePtrs.push_back(pre.size());
+                postPtrs.push_back(post.size());
+            }
+
+            void transition(uint32_t, bool, uint32_t) {}
+
+            // adds the places with the tokens of the colored places which the unfolded places do not hold
+            void addOrphans() {
+                const auto& places = _unfolder._builder.places();
+                for (uint32_t placeId = 0; placeId < places.size(); ++placeId) {
+                    const Colored::Place& place = places[placeId];
+                    if (place.skipped) continue;
+                    auto& colored = _colored[placeId];
+                    size_t used = 0;
+                    for (const auto& unfolded : colored.unfolded) {
+                        used += marking[unfolded.second];
+                    }
+                    if (colored.sumUnfolds) {
+                        used += marking[colored.sum];
+                    }
+                    if (place.marking.size() > used || (colored.unfolded.empty() && !colored.sumUnfolds)) {
+                        addPlace(placeId, ORPHAN, place.marking.size() - used, place._x, place._y);
+                    }
+                }
+            }
+
+            std::shared_ptr<names_t> names;
+            std::vector<MarkVal> marking;
+            std::vector<std::tuple<double, double>> placeLocations;
+            // the arcs of PT transition t, in unfolding order, are pre[prePtrs[t], prePtrs[t + 1]) and alike for post
+            std::vector<uint32_t> prePtrs{0}, postPtrs{0};
+            std::vector<arc_t> pre, post;
+
+        private:
+            struct colored_place_t {
+                // the PT place of each unfolded color id
+                std::unordered_map<uint32_t, uint32_t> unfolded;
+                uint32_t sum = NONE;
+                // whether the sum place counts as an unfolding of the place when looking for orphaned
+                // tokens, as it does for the builder when an inhibitor arc unfolded it first
+                bool sumUnfolds = false;
+            };
+
+            uint32_t addPlace(uint32_t placeId, uint32_t color, size_t tokens, double x, double y) {
+                names->placeOrigin.push_back(placeId);
+                names->placeColor.push_back(color);
+                marking.push_back(tokens);
+                placeLocations.emplace_back(x, y);
+                return marking.size() - 1;
+            }
+
+            uint32_t unfoldedPlace(uint32_t placeId, const Colored::Color* color, uint32_t id) {
+                auto& unfolded = _colored[placeId].unfolded;
+                auto it = unfolded.find(id);
+                if (it != unfolded.end()) return it->second;
+                const Colored::Place& place = _unfolder._builder.places()[placeId];
+                auto p = addPlace(placeId, color->getId(), _unfolder.unfoldedTokens(&place, color, placeId),
+                    place._x, place._y + (15 * color->getId()));
+                unfolded.emplace(id, p);
+                return p;
+            }
+
+            uint32_t sumPlace(uint32_t placeId, bool inhibitor) {
+                auto& colored = _colored[placeId];
+                if (colored.sum == NONE) {
+                    const Colored::Place& place = _unfolder._builder.places()[placeId];
+                    colored.sumUnfolds = inhibitor && colored.unfolded.empty();
+                    colored.sum = addPlace(placeId, SUM, place.marking.size(), place._x + 30, place._y - 30);
+                }
+                return colored.sum;
+            }
+
+            void addInput(uint32_t place, uint32_t weight, bool inhibitor) {
+                for (size_t i = prePtrs.back(); i < pre.size(); ++i) {
+                    auto& arc = pre[i];
+                    if (arc.place != place) continue;
+                    if (arc.inhibitor != inhibitor) {
+                        throw base_error("Adding an inhibitor and a non-inhibitor arc to the same Place/Transition pair:",
+                            names->place(place), names->transition(names->transitionOrigin.size() - 1));
+                    }
+                    arc.weight = inhibitor ? std::min(arc.weight, weight) : arc.weight + weight;
+                    return;
+                }
+                pre.push_back({place, weight, inhibitor});
+            }
+
+            void addOutput(uint32_t place, uint32_t weight) {
+                for (size_t i = postPtrs.back(); i < post.size(); ++i) {
+                    if (post[i].place == place) {
+                        post[i].weight += weight;
+                        return;
+                    }
+                }
+                post.push_back({place, weight, false});
+            }
+
+            Unfolder& _unfolder;
+            std::vector<colored_place_t> _colored;
+            // the inhibitor arcs of each colored transition
+            std::vector<std::vector<uint32_t>> _inhibitors;
+        };
+
         std::string Unfolder::arc_to_string(const Colored::Arc& arc) const {
             return !arc.input ? "(" + *_builder.transitions()[arc.transition].name + ", " + *_builder.places()[arc.place].name + ")" :
                 "(" + *_builder.places()[arc.place].name + ", " + *_builder.transitions()[arc.transition].name + ")";
@@ -56,14 +265,13 @@ namespace PetriEngine {
             return pnBuilder;
         }
 
-        PetriNetBuilder Unfolder::unfold() {
+        PetriNetBuilder Unfolder::unfold(uint32_t threads) {
             PetriNetBuilder ptBuilder(_builder.string_set());
             if (_builder.isColored()) {
                 auto start = std::chrono::high_resolution_clock::now();
 
-                for (uint32_t transitionId = 0; transitionId < _builder.transitions().size(); transitionId++) {
-                    unfoldTransition(ptBuilder, transitionId);
-                }
+                BuilderSink sink(*this, ptBuilder);
+                unfoldTransitions(sink, threads);
 
                 const auto& unfoldedPlaceMap = ptBuilder.getPlaceNames();
                 for (auto& place : _builder.places()) {
@@ -77,6 +285,88 @@ namespace PetriEngine {
             return ptBuilder;
         }
 
+        std::unique_ptr<PetriNet> Unfolder::unfoldNet(uint32_t threads) {
+            assert(_builder.isColored());
+            auto start = std::chrono::high_resolution_clock::now();
+            NetSink sink(*this);
+            unfoldTransitions(sink, threads);
+            sink.addOrphans();
+
+            auto& names = *sink.names;
+            const uint32_t nplaces = sink.marking.size();
+            const uint32_t ntransitions = names.transitionOrigin.size();
+            auto byPlace = [](const NetSink::arc_t& a, const NetSink::arc_t& b) { return a.place < b.place; };
+            // the transitions are ordered as makePetriNet(false) orders them: those without a
+            // non-inhibitor input first, then by their first non-inhibitor input place
+            std::vector<uint32_t> bucket(nplaces + 2, 0);
+            std::vector<uint32_t> key(ntransitions);
+            for (uint32_t t = 0; t < ntransitions; ++t) {
+                auto first = sink.pre.begin() + sink.prePtrs[t];
+                auto last = sink.pre.begin() + sink.prePtrs[t + 1];
+                std::sort(first, last, byPlace);
+                std::sort(sink.post.begin() + sink.postPtrs[t], sink.post.begin() + sink.postPtrs[t + 1], byPlace);
+                auto normal = std::find_if(first, last, [](const NetSink::arc_t& a) { return !a.inhibitor; });
+                key[t] = normal == last ? 0 : normal->place + 1;
+                ++bucket[key[t] + 1];
+            }
+            for (uint32_t k = 1; k < bucket.size(); ++k) {
+                bucket[k] += bucket[k - 1];
+            }
+
+            std::unique_ptr<PetriNet> net(new PetriNet(ntransitions, sink.pre.size() + sink.post.size(), nplaces));
+            for (uint32_t p = 1; p < nplaces; ++p) {
+                net->_placeToPtrs[p] = bucket[p + 1];
+            }
+            if (nplaces > 0) {
+                net->_placeToPtrs[0] = 0;
+            }
+            std::vector<uint32_t> order(ntransitions);
+            for (uint32_t t = 0; t < ntransitions; ++t) {
+                order[bucket[key[t]]++] = t;
+            }
+
+            uint32_t inv = 0;
+            auto origin = std::move(names.transitionOrigin);
+            auto binding = std::move(names.transitionBinding);
+            names.transitionOrigin.assign(ntransitions, 0);
+            names.transitionBinding.assign(ntransitions, 0);
+            net->_transitionlocations.resize(ntransitions);
+            for (uint32_t i = 0; i < ntransitions; ++i) {
+                const uint32_t t = order[i];
+                const Colored::Transition& transition = _builder.transitions()[origin[t]];
+                names.transitionOrigin[i] = origin[t];
+                names.transitionBinding[i] = binding[t];
+                net->_controllable[i] = transition._player == 0;
+                net->_transitionlocations[i] = std::make_tuple(transition._x, transition._y + 15.0 * binding[t]);
+                net->_transitions[i].inputs = inv;
+                for (uint32_t a = sink.prePtrs[t]; a < sink.prePtrs[t + 1]; ++a, ++inv) {
+                    net->_invariants[inv].place = sink.pre[a].place;
+                    net->_invariants[inv].tokens = sink.pre[a].weight;
+                    net->_invariants[inv].inhibitor = sink.pre[a].inhibitor;
+                }
+                net->_transitions[i].outputs = inv;
+                for (uint32_t a = sink.postPtrs[t]; a < sink.postPtrs[t + 1]; ++a, ++inv) {
+                    net->_invariants[inv].place = sink.post[a].place;
+                    net->_invariants[inv].tokens = sink.post[a].weight;
+                    net->_invariants[inv].inhibitor = false;
+                }
+            }
+            std::copy(sink.marking.begin(), sink.marking.end(), net->_initialMarking);
+            net->_placelocations = std::move(sink.placeLocations);
+
+            auto shared = sink.names;
+            net->_transitionOracle = [shared](uint32_t t) { return shared->transition(t); };
+            net->_placeOracle = [shared](uint32_t p) { return shared->place(p); };
+
+            net->computeDirections();
+            net->computeDependents();
+            net->computeArcLayout();
+
+            auto end = std::chrono::high_resolution_clock::now();
+            _time = (std::chrono::duration_cast<std::chrono::microseconds>(end - start).count())*0.000001;
+            return net;
+        }
+
         //Due to the way we unfold places, we only unfold places connected to an arc (which makes sense)
         //However, in queries asking about orphan places it cannot find these, as they have not been unfolded
         //so we make a placeholder place which just has tokens equal to the number of colored tokens
@@ -106,6 +396,13 @@ namespace PetriEngine {
         }
 
         void Unfolder::unfoldPlace(PetriNetBuilder& ptBuilder, const Colored::Place* place, const PetriEngine::Colored::Color *color, uint32_t placeId, uint32_t id) {
+            auto name = std::make_shared<const_string>(*place->name + "_" + std::to_string(color->getId()));
+
+            ptBuilder.addPlace(name, unfoldedTokens(place, color, placeId), place->_x, place->_y + (15 * color->getId()));
+            _ptplacenames[place->name][id] = std::move(name);
+        }
+
+        size_t Unfolder::unfoldedTokens(const Colored::Place* place, const PetriEngine::Colored::Color *color, uint32_t placeId) const {
             size_t tokenSize = 0;
             if (!_partition.computed() || _partition.partition()[placeId].isDiagonal()) {
                 tokenSize = place->marking[color];
@@ -131,64 +428,146 @@ namespace PetriEngine {
                     }
                 }
             }
-            auto name = std::make_shared<const_string>(*place->name + "_" + std::to_string(color->getId()));
+            return tokenSize;
+        }
 
-            ptBuilder.addPlace(name, tokenSize, place->_x, place->_y + (15 * color->getId()));
-            _ptplacenames[place->name][id] = std::move(name);
+        template<typename Sink>
+        void Unfolder::unfoldTransitions(Sink& sink, uint32_t threads) {
+            if (threads > 1 && _builder.transitions().size() > 1) {
+                unfoldParallel(sink, threads);
+                return;
+            }
+            // a single thread hands over each binding as it is enumerated, nothing is collected
+            std::vector<UnfoldedArc> arcs;
+            for (uint32_t transitionId = 0; transitionId < _builder.transitions().size(); transitionId++) {
+                const Colored::Transition &transition = _builder.transitions()[transitionId];
+                if (transition.skipped) continue;
+                uint32_t index = 0;
+                bool fixpoint = forEachBinding(transitionId, [&](const Colored::BindingMap& b) {
+                    arcs.clear();
+                    unfoldArcs(transition, b, arcs);
+                    sink.binding(transitionId, index++, arcs);
+                });
+                sink.transition(transitionId, fixpoint, index);
+            }
         }
 
-        void Unfolder::unfoldTransition(PetriNetBuilder& ptBuilder, uint32_t transitionId) {
-            double offset = 0;
+        template<typename Sink>
+        void Unfolder::unfoldParallel(Sink& sink, uint32_t threads) {
+            const size_t ntransitions = _builder.transitions().size();
+            // bounds how far the workers run ahead of the merge, and with it the memory held by unmerged transitions
+            const size_t window = 4 * threads;
+            std::vector<UnfoldedTransition> unfolded(ntransitions);
+            std::vector<bool> done(ntransitions, false);
+            std::mutex lock;
+            std::condition_variable changed;
+            size_t next = 0;
+            size_t merged = 0;
+            bool stop = false;
+
+            auto worker = [&]() {
+                while (true) {
+                    size_t transitionId;
+                    {
+                        std::unique_lock<std::mutex> guard(lock);
+                        changed.wait(guard, [&] { return stop || next >= ntransitions || next < merged + window; });
+                        if (stop || next >= ntransitions) return;
+                        transitionId = next++;
+                    }
+                    try {
+                        unfoldTransition(transitionId, unfolded[transitionId]);
+                    } catch (...) {
+                        unfolded[transitionId].error = std::current_exception();
+                    }
+                    {
+                        std::lock_guard<std::mutex> guard(lock);
+                        done[transitionId] = true;
+                    }
+                    changed.notify_all();
+                }
+            };
+
+            std::vector<std::thread> workers;
+            for (uint32_t i = 0; i < threads; ++i) {
+                workers.emplace_back(worker);
+            }
+
+            // the transitions are merged in order, so names and indices match the sequential unfolding
+            std::exception_ptr error;
+            for (size_t transitionId = 0; transitionId < ntransitions; ++transitionId) {
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    changed.wait(guard, [&] { return done[transitionId]; });
+                }
+                error = unfolded[transitionId].error;
+                if (!error && !_builder.transitions()[transitionId].skipped) {
+                    try {
+                        auto& bindings = unfolded[transitionId].bindings;
+                        for (uint32_t index = 0; index < bindings.size(); ++index) {
+                            sink.binding(transitionId, index, bindings[index]);
+                        }
+                        sink.transition(transitionId, unfolded[transitionId].fixpoint, bindings.size());
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                }
+                unfolded[transitionId] = UnfoldedTransition();
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    merged = transitionId + 1;
+                    stop = error != nullptr;
+                }
+                changed.notify_all();
+                if (error) break;
+            }
+
+            for (auto& w : workers) {
+                w.join();
+            }
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        template<typename F>
+        bool Unfolder::forEachBinding(uint32_t transitionId, F&& f) const {
             const Colored::Transition &transition = _builder.transitions()[transitionId];
-            if (transition.skipped) return;
             if (_fixed_point.computed() || _partition.computed()) {
                 assert(_fixed_point.variable_map().size() > transitionId);
                 assert(_symmetry.symmetries().size() > transitionId);
                 FixpointBindingGenerator gen(transition, _builder.colors(), _symmetry.symmetries()[transitionId],
                     _fixed_point.variable_map()[transitionId]);
-                size_t i = 0;
-                bool hasBindings = false;
                 for (const auto &b : gen) {
-                    auto name = std::make_shared<const_string>(*transition.name + "_" + std::to_string(i++));
-
-                    storeBinding(name, b);
-                   
-                    hasBindings = true;
-                    ptBuilder.addTransition(name, transition._player, transition._x, transition._y + offset);
-                    offset += 15;
-
-                    for (auto& arc : transition.input_arcs) {
-                        unfoldArc(ptBuilder, arc, b, name);
-                    }
-                    for (auto& arc : transition.output_arcs) {
-                        unfoldArc(ptBuilder, arc, b, name);
-                    }
-
-                    _pttransitionnames[transition.name].push_back(name);
-                    unfoldInhibitorArc(ptBuilder, transition.name, name);
-                }
-                if (!hasBindings) {
-                    _pttransitionnames[transition.name] = std::vector<shared_const_string>();
+                    f(b);
                 }
+                return true;
             } else {
                 NaiveBindingGenerator gen(transition, _builder.colors());
-                size_t i = 0;
                 for (const auto &b : gen) {
-                    auto name = std::make_shared<const_string>(*transition.name + "_" + std::to_string(i++));
-                    ptBuilder.addTransition(name, transition._player, transition._x, transition._y + offset);
-                    offset += 15;
+                    f(b);
+                }
+                return false;
+            }
+        }
 
-                    storeBinding(name, b);
+        void Unfolder::unfoldTransition(uint32_t transitionId, UnfoldedTransition& unfolded) const {
+            unfolded.bindings.clear();
+            unfolded.fixpoint = false;
+            unfolded.error = nullptr;
+            const Colored::Transition &transition = _builder.transitions()[transitionId];
+            if (transition.skipped) return;
 
-                    for (const auto& arc : transition.input_arcs) {
-                        unfoldArc(ptBuilder, arc, b, name);
-                    }
-                    for (const auto& arc : transition.output_arcs) {
-                        unfoldArc(ptBuilder, arc, b, name);
-                    }
-                    _pttransitionnames[transition.name].push_back(name);
-                    unfoldInhibitorArc(ptBuilder, transition.name, name);
-                }
+            unfolded.fixpoint = forEachBinding(transitionId, [&](const Colored::BindingMap& b) {
+                unfoldArcs(transition, b, unfolded.bindings.emplace_back());
+            });
+        }
+
+        void Unfolder::unfoldArcs(const Colored::Transition& transition, const Colored::BindingMap& binding, std::vector<UnfoldedArc>& arcs) const {
+            for (const auto& arc : transition.input_arcs) {
+                unfoldArc(arc, binding, arcs);
+            }
+            for (const auto& arc : transition.output_arcs) {
+                unfoldArc(arc, binding, arcs);
             }
         }
 
@@ -213,7 +592,7 @@ namespace PetriEngine {
             }
         }
 
-        void Unfolder::unfoldArc(PetriNetBuilder& ptBuilder, const Colored::Arc& arc, const Colored::BindingMap& binding, const shared_const_string& tName) {
+        void Unfolder::unfoldArc(const Colored::Arc& arc, const Colored::BindingMap& binding, std::vector<UnfoldedArc>& arcs) const {
             const PetriEngine::Colored::Place& place = _builder.places()[arc.place];
             //If the place is stable, the arc does not need to be unfolded.
             //This exploits the fact that since the transition is being unfolded with this binding
@@ -223,7 +602,7 @@ namespace PetriEngine {
             assert(_partition.partition().size() > arc.place);
             const Colored::ExpressionContext context{binding, _builder.colors(), _partition.partition()[arc.place]};
             const auto ms = Colored::EvaluationVisitor::evaluate(*arc.expr, context);
-            int shadowWeight = 0;
+            uint32_t shadowWeight = 0;
             
             const Colored::Color *newColor;
             std::vector<uint32_t> tupleIds;
@@ -249,64 +628,59 @@ namespace PetriEngine {
                 } else {
                     id = _partition.partition()[arc.place].getUniqueIdForColor(newColor);
                 }
-                auto pName = _ptplacenames[place.name][id];
-
-                if (pName == nullptr || pName->empty()) {
-                    unfoldPlace(ptBuilder, &place, newColor, arc.place, id);
-                    pName = _ptplacenames[place.name][id];
-                }
-
-                if (arc.input) {
-                    ptBuilder.addInputArc(pName, tName, false, color.second);
-                } else {
-                    ptBuilder.addOutputArc(tName, pName, color.second);
-                }
-                ++_nptarcs;
+                arcs.push_back({arc.place, id, newColor, color.second, arc.input, false});
             }
 
             if (place.inhibitor) {
+                arcs.push_back({arc.place, 0, nullptr, shadowWeight, arc.input, true});
+            }
+        }
+
+        void Unfolder::addArc(PetriNetBuilder& ptBuilder, const UnfoldedArc& arc, const shared_const_string& tName) {
+            const PetriEngine::Colored::Place& place = _builder.places()[arc.place];
+            shared_const_string pName;
+            if (arc.shadow) {
                 if (_sumPlacesNames.size() <= arc.place) _sumPlacesNames.resize(arc.place + 1);
                 auto& sumPlaceName = _sumPlacesNames[arc.place];
                 if (sumPlaceName == nullptr || sumPlaceName->empty()) {
-                    auto newSumPlaceName = std::make_shared<const_string>(*place.name + "Sum");
-                    ptBuilder.addPlace(newSumPlaceName, place.marking.size(), place._x + 30, place._y - 30);
-                    sumPlaceName = _sumPlacesNames[arc.place] = std::move(newSumPlaceName);
+                    sumPlaceName = std::make_shared<const_string>(*place.name + "Sum");
+                    ptBuilder.addPlace(sumPlaceName, place.marking.size(), place._x + 30, place._y - 30);
                 }
-
-
-                if (shadowWeight > 0) {
-                    if (!arc.input) {
-                        ptBuilder.addOutputArc(tName, sumPlaceName, shadowWeight);
-                    } else {
-                        ptBuilder.addInputArc(sumPlaceName, tName, false, shadowWeight);
-                    }
-                    ++_nptarcs;
+                if (arc.weight == 0) return;
+                pName = sumPlaceName;
+            } else {
+                pName = _ptplacenames[place.name][arc.id];
+                if (pName == nullptr || pName->empty()) {
+                    unfoldPlace(ptBuilder, &place, arc.color, arc.place, arc.id);
+                    pName = _ptplacenames[place.name][arc.id];
                 }
             }
-        }
 
-    
-        void Unfolder::storeBinding(const shared_const_string& name, const Colored::BindingMap& binding) {
-            if (_print_bindings) { 
-                Colored::BindingMap b;
-                for (auto var: binding) {
-                    b[var.first] = var.second;
-                } 
-                _transitionBinding[*name] = b;
+            if (arc.input) {
+                ptBuilder.addInputArc(pName, tName, false, arc.weight);
+            } else {
+                ptBuilder.addOutputArc(tName, pName, arc.weight);
             }
+            ++_nptarcs;
         }
 
+    
         void  Unfolder::printBinding(){
             if (_print_bindings) {
                 std::cout << "<bindings>\n";
-                for (auto const transition : _transitionBinding) {
-                    std::cout << "   <transition id=\"" << transition.first << "\">\n";    
-                    for(auto const var: transition.second) {
-                        std::cout << "      <variable id=\"" << var.first->name << "\">\n";
-                        std::cout << "         <color>" << var.second->getColorName() << "</color>\n";
-                        std::cout << "      </variable>\n";
-                    }
-                    std::cout << "   </transition>\n";
+                for (uint32_t transitionId = 0; transitionId < _builder.transitions().size(); transitionId++) {
+                    const Colored::Transition &transition = _builder.transitions()[transitionId];
+                    if (transition.skipped) continue;
+                    size_t i = 0;
+                    forEachBinding(transitionId, [&](const Colored::BindingMap& binding) {
+                        std::cout << "   <transition id=\"" << *transition.name << "_" << i++ << "\">\n";
+                        for(auto const& var: binding) {
+                            std::cout << "      <variable id=\"" << var.first->name << "\">\n";
+                            std::cout << "         <color>" << var.second->getColorName() << "</color>\n";
+                            std::cout << "      </variable>\n";
+                        }
+                        std::cout << "   </transition>\n";
+                    });
                 }
                 std::cout << "</bindings>\n";
             }
@@ -10,6 +10,7 @@
 #include "PetriEngine/ExplicitColored/Algorithms/ColoredSearchTypes.h"
 #include "PetriEngine/ExplicitColored/FireabilityChecker.h"
 #include "PetriEngine/ExplicitColored/ExplicitErrors.h"
+#include "utils/MemoryBudget.h"
 
 namespace PetriEngine::ExplicitColored {
     ExplicitWorklist::ExplicitWorklist(
@@ -106,6 +107,19 @@ namespace PetriEngine::ExplicitColored {
         }
 
         while (!waiting.empty()){
+            if (MemoryBudget::exhausted()) {
+                // first give up the trace, then the search
+                if (_createTrace) {
+                    _createTrace = false;
+                    decltype(_stateMap.transitions)().swap(_stateMap.transitions);
+                }
+                if (MemoryBudget::refresh()) {
+                    _outOfMemory = true;
+                    _searchStatistics.endWaitingStates = waiting.size();
+                    _searchStatistics.biggestEncoding = encoder.getBiggestEncoding();
+                    return _getResult(false, false);
+                }
+            }
             auto& next = waiting.next();
             auto [successor, traceStep] = _successorGenerator.next(next);
             if (next.done()) {
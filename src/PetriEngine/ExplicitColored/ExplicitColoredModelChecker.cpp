@@ -10,26 +10,34 @@
 #include <PetriEngine/ExplicitColored/Algorithms/FireabilitySearch.h>
 
 namespace PetriEngine::ExplicitColored {
-    ExplicitColoredModelChecker::Result ExplicitColoredModelChecker::checkQuery(
+    void ExplicitColoredModelChecker::loadModel(
         const std::string& modelPath,
-        const Condition_ptr& query,
-        options_t& options,
-        IColoredResultPrinter* resultPrinter
-    ) const {
+        const std::vector<Condition_ptr>& queries,
+        options_t& options
+    ) {
         std::stringstream pnmlModelStream;
-        Result result = Result::UNKNOWN;
         std::ifstream modelFile(modelPath);
         pnmlModelStream << modelFile.rdbuf();
-        std::string pnmlModel = std::move(pnmlModelStream).str();
+        _pnmlModel = std::move(pnmlModelStream).str();
+        _ignorantBuilder.reset();
+        _explicitBuilder.reset();
+        _explicitNet.reset();
 
         if (options.enablecolreduction) {
             std::stringstream reducedPnml;
-            _reduce(pnmlModel, reducedPnml, query, options);
-            pnmlModel = std::move(reducedPnml).str();
+            _reduce(_pnmlModel, reducedPnml, queries, options);
+            _pnmlModel = std::move(reducedPnml).str();
         }
+    }
 
+    ExplicitColoredModelChecker::Result ExplicitColoredModelChecker::checkQuery(
+        const Condition_ptr& query,
+        options_t& options,
+        IColoredResultPrinter* resultPrinter
+    ) {
+        Result result = Result::UNKNOWN;
         if (options.queryReductionTimeout > 0) {
-            result = checkColorIgnorantLP(pnmlModel, query, options);
+            result = checkColorIgnorantLP(query, options);
             if (result != Result::UNKNOWN) {
                 if (resultPrinter) {
                     //TODO: add other techniques
@@ -45,7 +53,7 @@ namespace PetriEngine::ExplicitColored {
         }
 
         SearchStatistics searchStatistics;
-        auto [newResult, trace] = explicitColorCheck(pnmlModel, query, options, &searchStatistics);
+        auto [newResult, trace] = explicitColorCheck(query, options, &searchStatistics);
         result = newResult;
         if (result != Result::UNKNOWN) {
             if (resultPrinter) {
@@ -65,21 +73,22 @@ namespace PetriEngine::ExplicitColored {
     }
 
     ExplicitColoredModelChecker::Result ExplicitColoredModelChecker::checkColorIgnorantLP(
-        const std::string& pnmlModel,
         const Condition_ptr& query,
         options_t& options
-    ) const {
+    ) {
         if (!isReachability(query)) {
             return Result::UNKNOWN;
         }
         auto queryCopy = ConditionCopyVisitor::copyCondition(query);
-        ColorIgnorantPetriNetBuilder ignorantBuilder(_stringSet);
-        std::stringstream pnmlModelStream {pnmlModel};
-        ignorantBuilder.parse_model(pnmlModelStream);
-
-        ignorantBuilder.build();
+        if (!_ignorantBuilder) {
+            _ignorantBuilder = std::make_unique<ColorIgnorantPetriNetBuilder>(_stringSet);
+            std::stringstream pnmlModelStream {_pnmlModel};
+            _ignorantBuilder->parse_model(pnmlModelStream);
+            _ignorantBuilder->build();
+        }
 
-        auto builder = ignorantBuilder.getUnderlying();
+        // makePetriNet reindexes the builder it is called on, so each query works on a copy
+        auto builder = _ignorantBuilder->getUnderlying();
         const auto qnet = std::unique_ptr<PetriNet>(builder.makePetriNet(false));
         const std::unique_ptr<MarkVal[]> qm0(qnet->makeInitialMarking());
         std::vector queries { std::move(queryCopy) };
@@ -232,16 +241,21 @@ namespace PetriEngine::ExplicitColored {
     }
 
     std::pair<ExplicitColoredModelChecker::Result, std::optional<std::vector<TraceStep>>> ExplicitColoredModelChecker::explicitColorCheck(
-        const std::string& pnmlModel,
         const Condition_ptr& query,
         options_t& options,
         SearchStatistics* searchStatistics
-    ) const {
-        ExplicitColoredPetriNetBuilder cpnBuilder;
-        auto pnmlModelStream = std::istringstream {pnmlModel};
-        cpnBuilder.parse_model(pnmlModelStream);
+    ) {
+        if (!_explicitBuilder) {
+            _explicitBuilder = std::make_unique<ExplicitColoredPetriNetBuilder>();
+            auto pnmlModelStream = std::istringstream {_pnmlModel};
+            _explicitBuilder->parse_model(pnmlModelStream);
+            _explicitStatus = _explicitBuilder->build();
+            if (_explicitStatus == ColoredPetriNetBuilderStatus::OK) {
+                _explicitNet = std::make_unique<ColoredPetriNet>(_explicitBuilder->takeNet());
+            }
+        }
 
-        switch (const auto buildStatus = cpnBuilder.build()) {
+        switch (_explicitStatus) {
         case ColoredPetriNetBuilderStatus::OK:
             break;
         case ColoredPetriNetBuilderStatus::TOO_MANY_BINDINGS:
@@ -249,10 +263,11 @@ namespace PetriEngine::ExplicitColored {
                     << "TOO_MANY_BINDINGS" << std::endl;
             return std::make_pair(Result::UNKNOWN, std::nullopt);
         default:
-            throw base_error("Unknown builder error ", static_cast<uint32_t>(buildStatus));
+            throw base_error("Unknown builder error ", static_cast<uint32_t>(_explicitStatus));
         }
 
-        auto net = cpnBuilder.takeNet();
+        const auto& cpnBuilder = *_explicitBuilder;
+        const auto& net = *_explicitNet;
 
         ExplicitWorklist worklist(net, query, cpnBuilder.getPlaceIndices(), cpnBuilder.getTransitionIndices(), options.seed(), options.trace != TraceLevel::None);
         bool result = worklist.check(options.strategy, options.colored_sucessor_generator);
@@ -261,6 +276,11 @@ namespace PetriEngine::ExplicitColored {
             *searchStatistics = worklist.GetSearchStatistics();
         }
 
+        if (worklist.outOfMemory()) {
+            std::cout << "The memory budget of " << options.maxMemory << " MB was exhausted" << std::endl;
+            return std::make_pair(Result::UNKNOWN, std::nullopt);
+        }
+
         std::optional<std::vector<TraceStep>> trace = std::nullopt;
         if (options.trace != TraceLevel::None) {
             auto counterExample = worklist.getCounterExampleId();
@@ -278,13 +298,13 @@ namespace PetriEngine::ExplicitColored {
     void ExplicitColoredModelChecker::_reduce(
         const std::string& pnmlModel,
         std::stringstream& out,
-        const Condition_ptr& query,
+        const std::vector<Condition_ptr>& reducedQueries,
         options_t& options
     ) const {
         PetriEngine::ColoredPetriNetBuilder cpnBuilder(_stringSet);
         std::stringstream pnmlModelStream {pnmlModel};
         cpnBuilder.parse_model(pnmlModelStream);
-        auto queries = std::vector{query};
+        auto queries = reducedQueries;
         const bool result = reduceColored(cpnBuilder, queries, options.logic, options.colReductionTimeout, _fullStatisticOut,
                       options.enablecolreduction, options.colreductions);
         std::stringstream cpnResult;
@@ -0,0 +1,487 @@
+/* Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PetriEngine/PQL/CompiledCondition.h"
+#include "PetriEngine/PQL/Evaluation.h"
+
+#include <cassert>
+#include <limits>
+
+namespace PetriEngine { namespace PQL {
+
+    // operands are truncated the same way as in CompareCondition::_distance
+    static int truncate(int64_t v) {
+        return (int)(uint32_t) v;
+    }
+
+    CompiledCondition::CompiledCondition(const Condition_ptr& query, const PetriNet* net)
+    : _query(query), _net(net) {
+        if (!compile(query.get())) {
+            _nodes.clear();
+            _code.clear();
+            _places.clear();
+        }
+        else
+            indexAtoms(0, false);
+    }
+
+    bool CompiledCondition::compile(const Condition* condition) {
+        if (condition == nullptr)
+            return false;
+        auto id = _nodes.size();
+        _nodes.emplace_back();
+        switch (condition->type()) {
+            case type_id<BooleanCondition>():
+                _nodes[id]._op = static_cast<const BooleanCondition*>(condition)->value ? TRUE_OP : FALSE_OP;
+                break;
+            case type_id<DeadlockCondition>():
+                _nodes[id]._op = DEADLOCK_OP;
+                break;
+            case type_id<AndCondition>():
+            case type_id<OrCondition>():
+                _nodes[id]._op = condition->type() == type_id<AndCondition>() ? AND_OP : OR_OP;
+                for (auto& c : static_cast<const LogicalCondition*>(condition)->getOperands())
+                    if (!compile(c.get()))
+                        return false;
+                break;
+            case type_id<NotCondition>():
+                _nodes[id]._op = NOT_OP;
+                if (!compile(static_cast<const NotCondition*>(condition)->getCond().get()))
+                    return false;
+                break;
+            case type_id<EFCondition>():
+                _nodes[id]._op = EF_OP;
+                if (!compile(static_cast<const EFCondition*>(condition)->getCond().get()))
+                    return false;
+                break;
+            case type_id<AGCondition>():
+                _nodes[id]._op = AG_OP;
+                if (!compile(static_cast<const AGCondition*>(condition)->getCond().get()))
+                    return false;
+                break;
+            case type_id<CompareConjunction>():
+                _nodes[id]._op = CONJUNCTION_OP;
+                _nodes[id]._conjunction = static_cast<const CompareConjunction*>(condition);
+                break;
+            case type_id<LessThanCondition>():
+            case type_id<LessThanOrEqualCondition>():
+            case type_id<EqualCondition>():
+            case type_id<NotEqualCondition>():
+            {
+                auto type = condition->type();
+                _nodes[id]._op = type == type_id<LessThanCondition>() ? LT_OP :
+                                 type == type_id<LessThanOrEqualCondition>() ? LE_OP :
+                                 type == type_id<EqualCondition>() ? EQ_OP : NE_OP;
+                auto compare = static_cast<const CompareCondition*>(condition);
+                _nodes[id]._lhs = _code.size();
+                if (!compileExpr((*compare)[0].get(), 0))
+                    return false;
+                _nodes[id]._rhs = _code.size();
+                if (!compileExpr((*compare)[1].get(), 0))
+                    return false;
+                _nodes[id]._end = _code.size();
+                break;
+            }
+            default:
+                return false;
+        }
+        _nodes[id]._next = _nodes.size();
+        return true;
+    }
+
+    bool CompiledCondition::compileExpr(const Expr* expr, uint32_t depth) {
+        if (expr == nullptr || depth + 1 > MAX_STACK)
+            return false;
+        switch (expr->type()) {
+            case type_id<LiteralExpr>():
+                _code.push_back({CONSTANT, 0, 0, static_cast<const LiteralExpr*>(expr)->value()});
+                return true;
+            case type_id<UnfoldedIdentifierExpr>():
+            {
+                auto offset = static_cast<const UnfoldedIdentifierExpr*>(expr)->offset();
+                if (offset < 0)
+                    return false;
+                _code.push_back({LOAD, (uint32_t) offset, 0, 0});
+                return true;
+            }
+            case type_id<IdentifierExpr>():
+                return compileExpr(static_cast<const IdentifierExpr*>(expr)->compiled().get(), depth);
+            case type_id<PlusExpr>():
+            case type_id<MultiplyExpr>():
+            {
+                bool plus = expr->type() == type_id<PlusExpr>();
+                auto commutative = static_cast<const CommutativeExpr*>(expr);
+                _code.push_back({plus ? SUM : PRODUCT, (uint32_t) _places.size(),
+                                 (uint32_t) commutative->places().size(), commutative->constant()});
+                for (auto& p : commutative->places())
+                    _places.push_back(p.first);
+                uint32_t n = 1;
+                for (auto& e : commutative->expressions()) {
+                    if (!compileExpr(e.get(), depth + n))
+                        return false;
+                    ++n;
+                }
+                if (n > 1)
+                    _code.push_back({plus ? ADD : MULTIPLY, 0, n, 0});
+                return true;
+            }
+            case type_id<SubtractExpr>():
+            {
+                auto subtract = static_cast<const SubtractExpr*>(expr);
+                uint32_t n = 0;
+                for (auto& e : subtract->expressions()) {
+                    if (!compileExpr(e.get(), depth + n))
+                        return false;
+                    ++n;
+                }
+                _code.push_back({SUBTRACT, 0, n, 0});
+                return n > 0;
+            }
+            case type_id<MinusExpr>():
+                if (!compileExpr((*static_cast<const MinusExpr*>(expr))[0].get(), depth))
+                    return false;
+                _code.push_back({NEGATE, 0, 0, 0});
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    int64_t CompiledCondition::value(uint32_t begin, uint32_t end, const MarkVal* marking) const {
+        int64_t stack[MAX_STACK];
+        uint32_t sp = 0;
+        for (auto pc = begin; pc != end; ++pc) {
+            auto& instr = _code[pc];
+            switch (instr._code) {
+                case CONSTANT:
+                    stack[sp++] = instr._value;
+                    break;
+                case LOAD:
+                    stack[sp++] = (int64_t) marking[instr._arg];
+                    break;
+                case SUM:
+                {
+                    int64_t r = instr._value;
+                    for (uint32_t i = instr._arg; i < instr._arg + instr._count; ++i)
+                        r += marking[_places[i]];
+                    stack[sp++] = r;
+                    break;
+                }
+                case PRODUCT:
+                {
+                    int64_t r = instr._value;
+                    for (uint32_t i = instr._arg; i < instr._arg + instr._count; ++i)
+                        r *= marking[_places[i]];
+                    stack[sp++] = r;
+                    break;
+                }
+                case ADD:
+                case MULTIPLY:
+                case SUBTRACT:
+                {
+                    auto first = sp - instr._count;
+                    int64_t r = stack[first];
+                    for (auto i = first + 1; i < sp; ++i) {
+                        if (instr._code == ADD) r += stack[i];
+                        else if (instr._code == MULTIPLY) r *= stack[i];
+                        else r -= stack[i];
+                    }
+                    sp = first + 1;
+                    stack[first] = r;
+                    break;
+                }
+                case NEGATE:
+                    stack[sp - 1] = -stack[sp - 1];
+                    break;
+            }
+        }
+        assert(sp == 1);
+        return stack[0];
+    }
+
+    Condition::Result CompiledCondition::evaluate(const MarkVal* marking) const {
+        if (!compiled()) {
+            EvaluationContext context(marking, _net);
+            return PQL::evaluate(_query.get(), context);
+        }
+        return evaluate(0, marking);
+    }
+
+    Condition::Result CompiledCondition::evaluate(uint32_t node, const MarkVal* marking) const {
+        auto& n = _nodes[node];
+        switch (n._op) {
+            case TRUE_OP:
+                return Condition::RTRUE;
+            case FALSE_OP:
+                return Condition::RFALSE;
+            case AND_OP:
+            case OR_OP:
+            {
+                // the result that decides the operator on its own
+                auto decisive = n._op == AND_OP ? Condition::RFALSE : Condition::RTRUE;
+                auto res = n._op == AND_OP ? Condition::RTRUE : Condition::RFALSE;
+                for (auto c = node + 1; c < n._next; c = _nodes[c]._next) {
+                    auto r = evaluate(c, marking);
+                    if (r == decisive)
+                        return decisive;
+                    else if (r == Condition::RUNKNOWN)
+                        res = Condition::RUNKNOWN;
+                }
+                return res;
+            }
+            case NOT_OP:
+            {
+                auto r = evaluate(node + 1, marking);
+                if (r == Condition::RUNKNOWN)
+                    return r;
+                return r == Condition::RFALSE ? Condition::RTRUE : Condition::RFALSE;
+            }
+            case EF_OP:
+                return evaluate(node + 1, marking) == Condition::RTRUE ? Condition::RTRUE : Condition::RUNKNOWN;
+            case AG_OP:
+                return evaluate(node + 1, marking) == Condition::RFALSE ? Condition::RFALSE : Condition::RUNKNOWN;
+            case LT_OP:
+            case LE_OP:
+            case EQ_OP:
+            case NE_OP:
+            {
+                auto v1 = value(n._lhs, n._rhs, marking);
+                auto v2 = value(n._rhs, n._end, marking);
+                bool res = n._op == LT_OP ? v1 < v2 :
+                           n._op == LE_OP ? v1 <= v2 :
+                           n._op == EQ_OP ? v1 == v2 : v1 != v2;
+                return res ? Condition::RTRUE : Condition::RFALSE;
+            }
+            case CONJUNCTION_OP:
+            {
+                bool res = true;
+                for (auto& c : n._conjunction->constraints()) {
+                    res = marking[c._place] <= c._upper && marking[c._place] >= c._lower;
+                    if (!res) break;
+                }
+                return (n._conjunction->isNegated() xor res) ? Condition::RTRUE : Condition::RFALSE;
+            }
+            case DEADLOCK_OP:
+                return _net->deadlocked(marking) ? Condition::RTRUE : Condition::RFALSE;
+        }
+        assert(false);
+        return Condition::RUNKNOWN;
+    }
+
+    uint32_t CompiledCondition::distance(DistanceContext& context) const {
+        if (!compiled())
+            return _query->distance(context);
+        return distance(0, context);
+    }
+
+    uint32_t CompiledCondition::distance(uint32_t node, DistanceContext& context) const {
+        auto& n = _nodes[node];
+        switch (n._op) {
+            case TRUE_OP:
+            case FALSE_OP:
+                return context.negated() != (n._op == TRUE_OP) ? 0 : std::numeric_limits<uint32_t>::max();
+            case AND_OP:
+            case OR_OP:
+            {
+                // a negated conjunction is as far as its closest operand, as is a disjunction
+                if ((n._op == AND_OP) == context.negated()) {
+                    uint32_t d = std::numeric_limits<uint32_t>::max();
+                    for (auto c = node + 1; c < n._next; c = _nodes[c]._next)
+                        d = std::min(distance(c, context), d);
+                    return d;
+                } else {
+                    uint32_t d = 0;
+                    for (auto c = node + 1; c < n._next; c = _nodes[c]._next)
+                        d += distance(c, context);
+                    return d;
+                }
+            }
+            case NOT_OP:
+            case AG_OP:
+            {
+                context.negate();
+                auto d = distance(node + 1, context);
+                context.negate();
+                return d;
+            }
+            case EF_OP:
+                return distance(node + 1, context);
+            case LT_OP:
+            case LE_OP:
+            case EQ_OP:
+            case NE_OP:
+                return atomDistance(n, context.marking(), context.negated());
+            case CONJUNCTION_OP:
+                return n._conjunction->CompareConjunction::distance(context);
+            case DEADLOCK_OP:
+                return 0;
+        }
+        assert(false);
+        return 0;
+    }
+
+    void CompiledCondition::indexAtoms(uint32_t node, bool negated) {
+        auto& n = _nodes[node];
+        n._negated = negated;
+        switch (n._op) {
+            case AND_OP:
+            case OR_OP:
+                for (auto c = node + 1; c < n._next; c = _nodes[c]._next)
+                    indexAtoms(c, negated);
+                break;
+            case NOT_OP:
+            case AG_OP:
+                indexAtoms(node + 1, !negated);
+                break;
+            case EF_OP:
+                indexAtoms(node + 1, negated);
+                break;
+            case LT_OP:
+            case LE_OP:
+            case EQ_OP:
+            case NE_OP:
+            case CONJUNCTION_OP:
+                n._atom = _atoms.size();
+                _atoms.push_back(node);
+                break;
+            default:
+                break;
+        }
+    }
+
+    uint32_t CompiledCondition::atomDistance(const node_t& n, const MarkVal* marking, bool negated) const {
+        if (n._op == CONJUNCTION_OP) {
+            DistanceContext context(_net, marking);
+            if (negated)
+                context.negate();
+            return n._conjunction->CompareConjunction::distance(context);
+        }
+        auto v1 = truncate(value(n._lhs, n._rhs, marking));
+        auto v2 = truncate(value(n._rhs, n._end, marking));
+        switch (n._op) {
+            case LT_OP: return delta<LessThanCondition>(v1, v2, negated);
+            case LE_OP: return delta<LessThanOrEqualCondition>(v1, v2, negated);
+            case EQ_OP: return delta<EqualCondition>(v1, v2, negated);
+            default:    return delta<NotEqualCondition>(v1, v2, negated);
+        }
+    }
+
+    void CompiledCondition::prepareIncremental() {
+        if (!compiled() || incremental())
+            return;
+        // the atoms reading each place
+        std::vector<std::vector<uint32_t>> readers(_net->numberOfPlaces());
+        for (uint32_t a = 0; a < _atoms.size(); ++a) {
+            auto& n = _nodes[_atoms[a]];
+            if (n._op == CONJUNCTION_OP) {
+                for (auto& c : n._conjunction->constraints())
+                    readers[c._place].push_back(a);
+                continue;
+            }
+            for (auto pc = n._lhs; pc != n._end; ++pc) {
+                auto& instr = _code[pc];
+                if (instr._code == LOAD)
+                    readers[instr._arg].push_back(a);
+                else if (instr._code == SUM || instr._code == PRODUCT)
+                    for (uint32_t i = instr._arg; i < instr._arg + instr._count; ++i)
+                        readers[_places[i]].push_back(a);
+            }
+        }
+
+        // the places a transition changes are those of its arcs with a direction
+        std::vector<uint32_t> seen(_atoms.size(), std::numeric_limits<uint32_t>::max());
+        _affectedOffset.reserve(_net->numberOfTransitions() + 1);
+        _affectedOffset.push_back(0);
+        for (uint32_t t = 0; t < _net->numberOfTransitions(); ++t) {
+            for (auto arcs : {_net->preset(t), _net->postset(t)}) {
+                for (; arcs.first != arcs.second; ++arcs.first) {
+                    if (arcs.first->direction == 0)
+                        continue;
+                    for (auto a : readers[arcs.first->place]) {
+                        if (seen[a] == t)
+                            continue;
+                        seen[a] = t;
+                        _affected.push_back(a);
+                    }
+                }
+            }
+            _affectedOffset.push_back(_affected.size());
+        }
+    }
+
+    void CompiledCondition::cache(const MarkVal* marking, DistanceCache& cache) const {
+        assert(incremental());
+        cache._atoms.resize(_atoms.size());
+        for (uint32_t a = 0; a < _atoms.size(); ++a) {
+            auto& n = _nodes[_atoms[a]];
+            cache._atoms[a] = atomDistance(n, marking, n._negated);
+        }
+    }
+
+    uint32_t CompiledCondition::distance(DistanceContext& context, DistanceCache& cache, uint32_t transition) const {
+        if (!incremental())
+            return distance(context);
+        assert(!context.negated());
+        assert(cache._atoms.size() == _atoms.size());
+        auto begin = _affectedOffset[transition];
+        auto end = _affectedOffset[transition + 1];
+        // the other successors of the parent need its values, so they are put back afterwards
+        cache._saved.resize(end - begin);
+        for (auto i = begin; i < end; ++i) {
+            auto a = _affected[i];
+            auto& n = _nodes[_atoms[a]];
+            cache._saved[i - begin] = cache._atoms[a];
+            cache._atoms[a] = atomDistance(n, context.marking(), n._negated);
+        }
+        auto d = combine(0, cache._atoms);
+        for (auto i = begin; i < end; ++i)
+            cache._atoms[_affected[i]] = cache._saved[i - begin];
+        return d;
+    }
+
+    uint32_t CompiledCondition::combine(uint32_t node, const std::vector<uint32_t>& atoms) const {
+        // distance(node, context) with the atoms looked up and the negations known from indexAtoms
+        auto& n = _nodes[node];
+        switch (n._op) {
+            case TRUE_OP:
+            case FALSE_OP:
+                return n._negated != (n._op == TRUE_OP) ? 0 : std::numeric_limits<uint32_t>::max();
+            case AND_OP:
+            case OR_OP:
+            {
+                if ((n._op == AND_OP) == n._negated) {
+                    uint32_t d = std::numeric_limits<uint32_t>::max();
+                    for (auto c = node + 1; c < n._next; c = _nodes[c]._next)
+                        d = std::min(combine(c, atoms), d);
+                    return d;
+                } else {
+                    uint32_t d = 0;
+                    for (auto c = node + 1; c < n._next; c = _nodes[c]._next)
+                        d += combine(c, atoms);
+                    return d;
+                }
+            }
+            case NOT_OP:
+            case AG_OP:
+            case EF_OP:
+                return combine(node + 1, atoms);
+            case DEADLOCK_OP:
+                return 0;
+            default:
+                return atoms[n._atom];
+        }
+    }
+} }
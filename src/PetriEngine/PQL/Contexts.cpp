@@ -3,8 +3,12 @@
  */
 
 #include "PetriEngine/PQL/Contexts.h"
+#include "PetriEngine/PQL/CompiledCondition.h"
 
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 namespace PetriEngine {
     namespace PQL {
@@ -58,6 +62,13 @@ namespace PetriEngine {
             return result;
         }
 
+        uint32_t DistanceContext::distance(const Condition* query)
+        {
+            if (_compiled != nullptr)
+                return _parent != nullptr ? _compiled->distance(*this, *_parent, _transition) : _compiled->distance(*this);
+            return query->distance(*this);
+        }
+
         uint32_t SimplificationContext::getLpTimeout() const
         {
             return _lpTimeout;
@@ -75,15 +86,138 @@ namespace PetriEngine {
             return (std::chrono::duration_cast<std::chrono::microseconds>(end - _start).count())*0.000001;
         }
 
-        glp_prob* SimplificationContext::makeBaseLP() const
+        glp_prob* SimplificationContext::acquireLP() const
         {
             if (_base_lp == nullptr)
                 _base_lp = buildBase();
-            if (_base_lp == nullptr)
-                return nullptr;
-            auto* tmp_lp = glp_create_prob();
-            glp_copy_prob(tmp_lp, _base_lp, GLP_OFF);
-            return tmp_lp;
+            return _base_lp;
+        }
+
+        // threads solving LPs on behalf of a context; thread w runs the job of worker w
+        struct SimplificationContext::lp_pool_t {
+            std::mutex lock;
+            std::condition_variable wake, done;
+            std::vector<std::thread> threads;
+            const std::function<void(size_t)>* job = nullptr;
+            size_t round = 0;
+            // the threads taking part in the current round, and those of them still running
+            size_t active = 0;
+            size_t running = 0;
+            bool stop = false;
+
+            void loop(size_t w)
+            {
+                size_t seen = 0;
+                std::unique_lock<std::mutex> guard(lock);
+                while (true)
+                {
+                    wake.wait(guard, [&] { return stop || round != seen; });
+                    if (stop)
+                        return;
+                    seen = round;
+                    if (w > active)
+                        continue;
+                    auto* f = job;
+                    guard.unlock();
+                    (*f)(w);
+                    guard.lock();
+                    if (--running == 0)
+                        done.notify_one();
+                }
+            }
+
+            ~lp_pool_t()
+            {
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    stop = true;
+                }
+                wake.notify_all();
+                for (auto& t : threads)
+                    t.join();
+            }
+        };
+
+        SimplificationContext::SimplificationContext(const MarkVal* marking,
+                const PetriNet* net, uint32_t queryTimeout, uint32_t lpTimeout,
+                Simplification::LPCache* cache, uint32_t potencyTimeout)
+                : _queryTimeout(queryTimeout), _lpTimeout(lpTimeout),
+                _potencyTimeout(potencyTimeout) {
+            _negated = false;
+            _marking = marking;
+            _net = net;
+            _start = std::chrono::high_resolution_clock::now();
+            _cache = cache;
+            _markingOutOfBounds = false;
+            for(size_t i = 0; i < net->numberOfPlaces(); ++i) {
+                if (marking[i] >  std::numeric_limits<int32_t>::max()) { //too many tokens exceeding int32_t limits, LP solver will give wrong results
+                    _markingOutOfBounds = true;
+                }
+            }
+        }
+
+        SimplificationContext::~SimplificationContext()
+        {
+            // the workers may still use their problems until the pool is joined
+            _pool.reset();
+            _workers.clear();
+            if(_base_lp != nullptr)
+                glp_delete_prob(_base_lp);
+            _base_lp = nullptr;
+        }
+
+        void SimplificationContext::runWorkers(size_t n, const std::function<void(const SimplificationContext&)>& job) const
+        {
+            if (n == 0)
+                return;
+            while (_workers.size() < n)
+            {
+                auto w = std::make_unique<SimplificationContext>(_marking, _net, _queryTimeout,
+                    _lpTimeout, nullptr, _potencyTimeout);
+                w->_start = _start;
+                _workers.emplace_back(std::move(w));
+            }
+            if (_pool == nullptr)
+                _pool = std::make_unique<lp_pool_t>();
+
+            auto& pool = *_pool;
+            std::function<void(size_t)> task = [&](size_t w) { job(*_workers[w]); };
+            {
+                std::lock_guard<std::mutex> guard(pool.lock);
+                while (pool.threads.size() + 1 < n)
+                {
+                    auto w = pool.threads.size() + 1;
+                    pool.threads.emplace_back([&pool, w] { pool.loop(w); });
+                }
+                pool.job = &task;
+                pool.active = pool.running = n - 1;
+                ++pool.round;
+            }
+            pool.wake.notify_all();
+
+            auto wait = [&pool] {
+                std::unique_lock<std::mutex> guard(pool.lock);
+                pool.done.wait(guard, [&pool] { return pool.running == 0; });
+            };
+            try {
+                task(0);
+            } catch (...) {
+                wait();
+                throw;
+            }
+            wait();
+        }
+
+        void SimplificationContext::releaseLP(glp_prob* lp) const
+        {
+            assert(lp == _base_lp);
+            auto nrows = glp_get_num_rows(lp);
+            if (nrows == _base_rows)
+                return;
+            std::vector<int> rows(nrows - _base_rows + 1);
+            for (int i = 1; i < (int)rows.size(); ++i)
+                rows[i] = _base_rows + i;
+            glp_del_rows(lp, rows.size() - 1, rows.data());
         }
 
         glp_prob* SimplificationContext::buildBase() const
@@ -153,6 +287,15 @@ namespace PetriEngine {
                     return nullptr;
                 }
             }
+
+            // minimise the number of transitions fired; bounds() temporarily replaces the objective
+            for (size_t i = 1; i <= nCol; i++) {
+                glp_set_obj_coef(lp, i, 1);
+                glp_set_col_kind(lp, i, GLP_IV);
+                glp_set_col_bnds(lp, i, GLP_LO, 0, infty);
+            }
+            glp_set_obj_dir(lp, GLP_MIN);
+            _base_rows = glp_get_num_rows(lp);
             return lp;
         }
     }
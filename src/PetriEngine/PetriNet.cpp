@@ -166,6 +166,184 @@ namespace PetriEngine {
         return marking;
     }
 
+    void PetriNet::computeDirections()
+    {
+        for(size_t t = 0; t < _ntransitions; ++t)
+        {
+            {
+                auto tiv = std::make_pair(&_invariants[_transitions[t].inputs], &_invariants[_transitions[t].outputs]);
+                for(; tiv.first != tiv.second; ++tiv.first)
+                {
+                    tiv.first->direction = tiv.first->inhibitor ? 0 : -1;
+                    bool found = false;
+                    auto tov = std::make_pair(&_invariants[_transitions[t].outputs], &_invariants[_transitions[t + 1].inputs]);
+                    for(; tov.first != tov.second; ++tov.first)
+                    {
+                        if(tov.first->place == tiv.first->place)
+                        {
+                            found = true;
+                            if(tiv.first->inhibitor)                        tiv.first->direction = tov.first->direction = 1;
+                            else if(tiv.first->tokens < tov.first->tokens)  tiv.first->direction = tov.first->direction = 1;
+                            else if(tiv.first->tokens == tov.first->tokens) tiv.first->direction = tov.first->direction = 0;
+                            else if(tiv.first->tokens > tov.first->tokens)  tiv.first->direction = tov.first->direction = -1;
+                            break;
+                        }
+                    }
+                    if(!found) assert(tiv.first->direction < 0 || tiv.first->inhibitor);
+                }
+            }
+            {
+                auto tiv = std::make_pair(&_invariants[_transitions[t].outputs], &_invariants[_transitions[t + 1].inputs]);
+                for(; tiv.first != tiv.second; ++tiv.first)
+                {
+                    tiv.first->direction = 1;
+                    bool found = false;
+                    auto tov = std::make_pair(&_invariants[_transitions[t].inputs], &_invariants[_transitions[t].outputs]);
+                    for(; tov.first != tov.second; ++tov.first)
+                    {
+                        if(tov.first->place == tiv.first->place)
+                        {
+                            found = true;
+                            if     (tov.first->inhibitor)                   tiv.first->direction = tov.first->direction = 1;
+                            else if(tiv.first->tokens > tov.first->tokens)  tiv.first->direction = tov.first->direction = 1;
+                            else if(tiv.first->tokens == tov.first->tokens) tiv.first->direction = tov.first->direction = 0;
+                            else if(tiv.first->tokens < tov.first->tokens)  tiv.first->direction = tov.first->direction = -1;
+                            break;
+                        }
+                    }
+                    if(!found) assert(tiv.first->direction > 0);
+                }
+            }
+        }
+    }
+
+    shared_const_string PetriNet::transitionName(uint32_t t) const
+    {
+        if(_transitionOracle)
+            return std::make_shared<const_string>(_transitionOracle(t));
+        return _transitionnames[t];
+    }
+
+    shared_const_string PetriNet::placeName(uint32_t p) const
+    {
+        if(_placeOracle)
+            return std::make_shared<const_string>(_placeOracle(p));
+        return _placenames[p];
+    }
+
+    void PetriNet::nameAll() const
+    {
+        if(!_transitionOracle)
+            return;
+        std::call_once(_named, [this] {
+            _transitionnames.resize(_ntransitions);
+            for(uint32_t t = 0; t < _ntransitions; ++t)
+                _transitionnames[t] = std::make_shared<const_string>(_transitionOracle(t));
+            _placenames.resize(_nplaces);
+            for(uint32_t p = 0; p < _nplaces; ++p)
+                _placenames[p] = std::make_shared<const_string>(_placeOracle(p));
+        });
+    }
+
+    void PetriNet::computeDependents()
+    {
+        _dependentPtrs.assign(_nplaces + 1, 0);
+        for(size_t t = 0; t < _ntransitions; ++t)
+        {
+            for(uint32_t i = _transitions[t].inputs; i < _transitions[t].outputs; ++i)
+                ++_dependentPtrs[_invariants[i].place + 1];
+        }
+        for(size_t p = 0; p < _nplaces; ++p)
+            _dependentPtrs[p + 1] += _dependentPtrs[p];
+
+        _dependents.resize(_dependentPtrs[_nplaces]);
+        std::vector<uint32_t> next(_dependentPtrs.begin(), _dependentPtrs.end() - 1);
+        for(uint32_t t = 0; t < _ntransitions; ++t)
+        {
+            for(uint32_t i = _transitions[t].inputs; i < _transitions[t].outputs; ++i)
+                _dependents[next[_invariants[i].place]++] = t;
+        }
+    }
+
+    bool PetriNet::affectedIndex() const
+    {
+        std::call_once(_affectedOnce, [this] {
+            // nets where most transitions share a place would need |T|^2 entries
+            const size_t limit = std::max<size_t>(size_t{16} * _invariants.size(), size_t{1} << 22);
+            std::vector<int64_t> delta(_nplaces, 0);
+            std::vector<uint32_t> seen(_ntransitions, 0);
+            std::vector<uint32_t> ptrs(1, 0);
+            std::vector<uint32_t> affected;
+            for(uint32_t t = 0; t < _ntransitions; ++t)
+            {
+                for(uint32_t i = _prePtrs[t]; i < _prePtrs[t + 1]; ++i)
+                    delta[_prePlaces[i]] -= _preTokens[i];
+                for(uint32_t i = _postPtrs[t]; i < _postPtrs[t + 1]; ++i)
+                    delta[_postPlaces[i]] += _postTokens[i];
+                const size_t first = affected.size();
+                // clears delta[p] again, so each changed place is visited once
+                auto visit = [&](uint32_t p) {
+                    if(delta[p] == 0)
+                        return;
+                    delta[p] = 0;
+                    for(uint32_t i = _dependentPtrs[p]; i < _dependentPtrs[p + 1]; ++i)
+                    {
+                        if(seen[_dependents[i]] == t + 1)
+                            continue;
+                        seen[_dependents[i]] = t + 1;
+                        affected.push_back(_dependents[i]);
+                    }
+                };
+                for(uint32_t i = _prePtrs[t]; i < _prePtrs[t + 1]; ++i)
+                    visit(_prePlaces[i]);
+                for(uint32_t i = _postPtrs[t]; i < _postPtrs[t + 1]; ++i)
+                    visit(_postPlaces[i]);
+                if(affected.size() > limit)
+                    return;
+                std::sort(affected.begin() + first, affected.end());
+                ptrs.push_back(affected.size());
+            }
+            _affectedPtrs.swap(ptrs);
+            _affected.swap(affected);
+        });
+        return !_affectedPtrs.empty();
+    }
+
+    void PetriNet::computeArcLayout()
+    {
+        _prePtrs.assign(1, 0);
+        _inhibPtrs.assign(1, 0);
+        _postPtrs.assign(1, 0);
+        _prePlaces.clear(); _preTokens.clear();
+        _inhibPlaces.clear(); _inhibTokens.clear();
+        _postPlaces.clear(); _postTokens.clear();
+        for(uint32_t t = 0; t < _ntransitions; ++t)
+        {
+            for(uint32_t i = _transitions[t].inputs; i < _transitions[t].outputs; ++i)
+            {
+                auto& inv = _invariants[i];
+                if(inv.inhibitor)
+                {
+                    _inhibPlaces.push_back(inv.place);
+                    _inhibTokens.push_back(inv.tokens);
+                }
+                else
+                {
+                    _prePlaces.push_back(inv.place);
+                    _preTokens.push_back(inv.tokens);
+                }
+            }
+            for(uint32_t i = _transitions[t].outputs; i < _transitions[t + 1].inputs; ++i)
+            {
+                _postPlaces.push_back(_invariants[i].place);
+                _postTokens.push_back(_invariants[i].tokens);
+            }
+            _prePtrs.push_back(_prePlaces.size());
+            _inhibPtrs.push_back(_inhibPlaces.size());
+            _postPtrs.push_back(_postPlaces.size());
+        }
+    }
+
     void PetriNet::sort()
     {
         for(size_t i = 0; i < _ntransitions; ++i)
@@ -189,7 +367,7 @@ namespace PetriEngine {
 
         for(size_t i = 0; i < _nplaces; ++i)
         {
-            auto& p = _placenames[i];
+            auto p = placeName(i);
             auto& placelocation = _placelocations[i];
             out << "<place id=\"" << *p << "\">\n"
                 << "<graphics><position x=\"" << std::get<0>(placelocation)
@@ -204,9 +382,10 @@ namespace PetriEngine {
         for(size_t i = 0; i < _ntransitions; ++i)
         {
             auto& transitionlocation = _transitionlocations[i];
-            out << "<transition id=\"" << *_transitionnames[i] << "\">\n"
+            auto name = transitionName(i);
+            out << "<transition id=\"" << *name << "\">\n"
                 << "<player><value>" << (_controllable[i] ? '0' : '1') << "</value></player>\n"
-                << "<name><text>" << *_transitionnames[i] << "</text></name>\n";
+                << "<name><text>" << *name << "</text></name>\n";
             out << "<graphics><position x=\"" << std::get<0>(transitionlocation)
                 << "\" y=\"" << std::get<1>(transitionlocation) << "\"/></graphics>\n";
             out << "</transition>\n";
@@ -214,13 +393,14 @@ namespace PetriEngine {
         size_t id = 0;
         for(size_t t = 0; t < _ntransitions; ++t)
         {
+            auto name = transitionName(t);
             auto pre = preset(t);
 
             for(; pre.first != pre.second; ++pre.first)
             {
                 out << "<arc id=\"" << (id++) << "\" source=\""
-                    << *_placenames[pre.first->place] << "\" target=\""
-                    << *_transitionnames[t]
+                    << *placeName(pre.first->place) << "\" target=\""
+                    << *name
                     << "\" type=\""
                     << (pre.first->inhibitor ? "inhibitor" : "normal")
                     << "\">\n";
@@ -237,8 +417,8 @@ namespace PetriEngine {
             for(; post.first != post.second; ++post.first)
             {
                 out << "<arc id=\"" << (id++) << "\" source=\""
-                    << *_transitionnames[t] << "\" target=\""
-                    << *_placenames[post.first->place] << "\">\n";
+                    << *name << "\" target=\""
+                    << *placeName(post.first->place) << "\">\n";
 
                 if(post.first->tokens > 1)
                 {
@@ -476,54 +476,9 @@ namespace PetriEngine {
             }
         }
         net->sort();
-
-        for(size_t t = 0; t < net->numberOfTransitions(); ++t)
-        {
-            {
-                auto tiv = std::make_pair(&net->_invariants[net->_transitions[t].inputs], &net->_invariants[net->_transitions[t].outputs]);
-                for(; tiv.first != tiv.second; ++tiv.first)
-                {
-                    tiv.first->direction = tiv.first->inhibitor ? 0 : -1;
-                    bool found = false;
-                    auto tov = std::make_pair(&net->_invariants[net->_transitions[t].outputs], &net->_invariants[net->_transitions[t + 1].inputs]);
-                    for(; tov.first != tov.second; ++tov.first)
-                    {
-                        if(tov.first->place == tiv.first->place)
-                        {
-                            found = true;
-                            if(tiv.first->inhibitor)                        tiv.first->direction = tov.first->direction = 1;
-                            else if(tiv.first->tokens < tov.first->tokens)  tiv.first->direction = tov.first->direction = 1;
-                            else if(tiv.first->tokens == tov.first->tokens) tiv.first->direction = tov.first->direction = 0;
-                            else if(tiv.first->tokens > tov.first->tokens)  tiv.first->direction = tov.first->direction = -1;
-                            break;
-                        }
-                    }
-                    if(!found) assert(tiv.first->direction < 0 || tiv.first->inhibitor);
-                }
-            }
-            {
-                auto tiv = std::make_pair(&net->_invariants[net->_transitions[t].outputs], &net->_invariants[net->_transitions[t + 1].inputs]);
-                for(; tiv.first != tiv.second; ++tiv.first)
-                {
-                    tiv.first->direction = 1;
-                    bool found = false;
-                    auto tov = std::make_pair(&net->_invariants[net->_transitions[t].inputs], &net->_invariants[net->_transitions[t].outputs]);
-                    for(; tov.first != tov.second; ++tov.first)
-                    {
-                        if(tov.first->place == tiv.first->place)
-                        {
-                            found = true;
-                            if     (tov.first->inhibitor)                   tiv.first->direction = tov.first->direction = 1;
-                            else if(tiv.first->tokens > tov.first->tokens)  tiv.first->direction = tov.first->direction = 1;
-                            else if(tiv.first->tokens == tov.first->tokens) tiv.first->direction = tov.first->direction = 0;
-                            else if(tiv.first->tokens < tov.first->tokens)  tiv.first->direction = tov.first->direction = -1;
-                            break;
-                        }
-                    }
-                    if(!found) assert(tiv.first->direction > 0);
-                }
-            }
-        }
+        net->computeDirections();
+        net->computeDependents();
+        net->computeArcLayout();
         return net;
     }
 
@@ -0,0 +1,215 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PetriEngine/Portfolio.h"
+#include "PetriEngine/Reachability/ReachabilitySearch.h"
+#include "PetriEngine/TAR/TARReachability.h"
+#include "PetriEngine/STSolver.h"
+#include "PetriEngine/PQL/Expressions.h"
+#include "PetriEngine/PQL/PredicateCheckers.h"
+#include "PetriEngine/PQL/Simplifier.h"
+#include "PetriEngine/Simplification/LPCache.h"
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+namespace PetriEngine {
+    using namespace Reachability;
+
+    /** Passes the first definitive answer to each query on to the printer */
+    class Portfolio::handler_t : public AbstractHandler {
+    public:
+        handler_t(Portfolio& portfolio, PortfolioEngine engine)
+        : _portfolio(portfolio), _engine(engine) {}
+
+        std::pair<Result, bool> handle(
+            size_t index,
+            PQL::Condition* query,
+            Result result,
+            const std::vector<uint32_t>* maxPlaceBound = nullptr,
+            size_t expandedStates = 0,
+            size_t exploredStates = 0,
+            size_t discoveredStates = 0,
+            int maxTokens = 0,
+            Structures::StateSetInterface* stateset = nullptr, size_t lastmarking = 0, const MarkVal* initialMarking = nullptr, bool trace = true) override
+        {
+            if (result == Unknown)
+                return std::make_pair(Unknown, false);
+
+            std::lock_guard<std::mutex> guard(_portfolio._lock);
+            auto& results = *_portfolio._results;
+            if (results[index] == Unknown)
+            {
+                auto r = _portfolio._printer.handle(index, query, result, maxPlaceBound, expandedStates, exploredStates,
+                                                    discoveredStates, maxTokens, stateset, lastmarking, initialMarking, trace);
+                results[index] = r.first;
+                if (r.first != Unknown && _portfolio._options.printstatistics == StatisticsLevel::Full)
+                    std::cout << "Query solved by " << to_string(_engine) << " in the portfolio.\n" << std::endl;
+                if (std::find(results.begin(), results.end(), Unknown) == results.end())
+                    _portfolio._stop = true;
+            }
+            // an answer given by another engine is taken as this engine's own
+            return std::make_pair(results[index], _portfolio._stop.load());
+        }
+
+    private:
+        Portfolio& _portfolio;
+        PortfolioEngine _engine;
+    };
+
+    static bool isSearch(PortfolioEngine engine)
+    {
+        return engine != PortfolioEngine::TAR &&
+               engine != PortfolioEngine::SiphonTrap &&
+               engine != PortfolioEngine::LP;
+    }
+
+    static Strategy searchStrategy(PortfolioEngine engine)
+    {
+        switch (engine)
+        {
+            case PortfolioEngine::BFS:        return Strategy::BFS;
+            case PortfolioEngine::DFS:        return Strategy::DFS;
+            case PortfolioEngine::RDFS:       return Strategy::RDFS;
+            case PortfolioEngine::RPFS:       return Strategy::RPFS;
+            case PortfolioEngine::RandomWalk: return Strategy::RandomWalk;
+            default:                          return Strategy::HEUR;
+        }
+    }
+
+    bool Portfolio::solve(std::vector<PQL::Condition_ptr>& queries,
+                          std::vector<ResultPrinter::Result>& results,
+                          const std::vector<MarkVal>& initPotencies)
+    {
+        auto& engines = _options.portfolio;
+        _results = &results;
+        _stop = std::find(results.begin(), results.end(), ResultPrinter::Unknown) == results.end();
+
+        // the one engine that may annotate the query trees, see the class comment
+        bool tar = _net.numberOfPlaces() > 0 &&
+                   std::find(engines.begin(), engines.end(), PortfolioEngine::TAR) != engines.end();
+        size_t annotating = engines.size();
+        for (size_t i = 0; i < engines.size() && annotating == engines.size(); ++i)
+        {
+            if (tar ? engines[i] == PortfolioEngine::TAR
+                    : _options.stubbornreduction && isSearch(engines[i]))
+                annotating = i;
+        }
+
+        // every engine starts from the answers known now, and keeps its own copy
+        const auto open = results;
+        std::exception_ptr error = nullptr;
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < engines.size(); ++i)
+        {
+            threads.emplace_back([&, i, seed = _options.seed()] {
+                try {
+                    run(engines[i], i == annotating, seed, queries, open, initPotencies);
+                } catch (...) {
+                    std::lock_guard<std::mutex> guard(_lock);
+                    if (!error)
+                        error = std::current_exception();
+                }
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+        _results = nullptr;
+
+        bool done = std::find(results.begin(), results.end(), ResultPrinter::Unknown) == results.end();
+        // a failing engine only matters if no other engine made up for it
+        if (error && !done)
+            std::rethrow_exception(error);
+        return done;
+    }
+
+    void Portfolio::run(PortfolioEngine engine, bool annotate, size_t seed,
+                        std::vector<PQL::Condition_ptr>& queries,
+                        std::vector<ResultPrinter::Result> results,
+                        const std::vector<MarkVal>& initPotencies)
+    {
+        handler_t handler(*this, engine);
+        bool trace = _options.trace != TraceLevel::None;
+        switch (engine)
+        {
+            case PortfolioEngine::TAR:
+            {
+                if (!annotate)
+                    return;
+                TARReachabilitySearch search(handler, _net, _reducer, _options.kbound);
+                search.setStopFlag(&_stop);
+                search.reachable(queries, results, StatisticsLevel::None, trace);
+                break;
+            }
+            case PortfolioEngine::SiphonTrap:
+            {
+                for (size_t i = 0; i < queries.size() && !_stop; ++i)
+                {
+                    if (results[i] != ResultPrinter::Unknown ||
+                        std::dynamic_pointer_cast<PQL::DeadlockCondition>(queries[i]) == nullptr)
+                        continue;
+                    STSolver solver(handler, _net, queries[i].get(), _options.siphonDepth, i);
+                    solver.setStopFlag(&_stop);
+                    solver.solve(std::numeric_limits<uint32_t>::max());
+                    solver.printResult();
+                }
+                break;
+            }
+            case PortfolioEngine::LP:
+            {
+                // the state equation over-approximates the reachable markings, so it only proves unreachability.
+                // A running LP cannot be interrupted; the engine is bounded by the query reduction timeout instead.
+                std::unique_ptr<MarkVal[]> m0(_net.makeInitialMarking());
+                Simplification::LPCache cache;
+                for (size_t i = 0; i < queries.size() && !_stop; ++i)
+                {
+                    if (results[i] != ResultPrinter::Unknown || PQL::containsUpperBounds(queries[i]))
+                        continue;
+                    PQL::SimplificationContext context(m0.get(), &_net, _options.queryReductionTimeout,
+                                                       _options.lpsolveTimeout, &cache);
+                    if (context.markingOutOfBounds())
+                        break;
+                    auto simplified = PQL::simplify(std::make_shared<PQL::EFCondition>(queries[i]), context);
+                    if (simplified.formula->isTriviallyFalse())
+                        handler.handle(i, queries[i].get(), ResultPrinter::NotSatisfied);
+                }
+                break;
+            }
+            default:
+            {
+                auto strategy = searchStrategy(engine);
+                bool potencies = strategy == Strategy::RPFS || strategy == Strategy::RandomWalk;
+                ReachabilitySearch search(_net, handler, _options.kbound);
+                search.setStateStorage(_options.statestorage, _options.bitstateBits);
+                search.setDiskStorage(_options.diskDirectory, size_t{_options.diskBuffer} << 20);
+                search.setStopFlag(&_stop);
+                search.reachable(queries, results,
+                                 strategy,
+                                 annotate,
+                                 false,
+                                 StatisticsLevel::None,
+                                 trace,
+                                 seed,
+                                 _options.depthRandomWalk,
+                                 _options.incRandomWalk,
+                                 potencies ? initPotencies : std::vector<MarkVal>());
+                break;
+            }
+        }
+    }
+}
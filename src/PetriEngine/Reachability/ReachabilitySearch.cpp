@@ -21,6 +21,7 @@
 #include "PetriEngine/PQL/PQL.h"
 #include "PetriEngine/PQL/Contexts.h"
 #include "PetriEngine/PQL/Evaluation.h"
+#include "PetriEngine/PQL/PredicateCheckers.h"
 #include "PetriEngine/Structures/StateSet.h"
 #include "PetriEngine/SuccessorGenerator.h"
 
@@ -44,8 +45,7 @@ namespace PetriEngine {
             {
                 if(results[i] == ResultPrinter::Unknown)
                 {
-                    EvaluationContext ec(state.marking(), &_net);
-                    if(PetriEngine::PQL::evaluate(queries[i].get(), ec) == Condition::RTRUE)
+                    if(_compiled[i].evaluate(state.marking()) == Condition::RTRUE)
                     {
                         auto r = doCallback(queries[i], i, ResultPrinter::Satisfied, ss, states);
                         results[i] = r.first;
@@ -74,6 +74,112 @@ namespace PetriEngine {
             return alldone;
         }
 
+        bool ReachabilitySearch::checkQueriesParallel(std::vector<std::shared_ptr<PQL::Condition > >& queries,
+                                                      std::vector<ResultPrinter::Result>& results,
+                                                      std::vector<ResultPrinter::Result>& local,
+                                                      size_t& epoch, size_t& heurquery,
+                                                      State& state, size_t id, parallelstate_t& par,
+                                                      Structures::ConcurrentStateSet& states)
+        {
+            // refresh our view of the results if another worker solved something
+            if(par.epoch.load() != epoch)
+            {
+                std::lock_guard<std::mutex> guard(par.lock);
+                local = results;
+                epoch = par.epoch;
+            }
+
+            bool alldone = true;
+            for(size_t i = 0; i < queries.size(); ++i)
+            {
+                if(local[i] != ResultPrinter::Unknown)
+                    continue;
+                if(_compiled[i].evaluate(state.marking()) != Condition::RTRUE)
+                {
+                    alldone = false;
+                    continue;
+                }
+                std::lock_guard<std::mutex> guard(par.lock);
+                if(results[i] == ResultPrinter::Unknown)
+                {
+                    searchstate_t ss;
+                    ss.expandedStates = par.expandedStates;
+                    ss.exploredStates = par.exploredStates;
+                    _satisfyingMarking = id;
+                    states.collect();
+                    auto r = doCallback(queries[i], i, ResultPrinter::Satisfied, ss, &states);
+                    results[i] = r.first;
+                    ++par.epoch;
+                    if(r.second)
+                        return true;
+                }
+                local = results;
+                epoch = par.epoch;
+            }
+
+            if(local[heurquery] != ResultPrinter::Unknown)
+            {
+                for(size_t n = 1; n < queries.size(); ++n)
+                {
+                    auto next = (heurquery + n) % queries.size();
+                    if(local[next] == ResultPrinter::Unknown)
+                    {
+                        heurquery = next;
+                        break;
+                    }
+                }
+            }
+            return alldone;
+        }
+
+        bool ReachabilitySearch::tryReachCached(std::vector<std::shared_ptr<PQL::Condition> >& queries,
+                                                std::vector<ResultPrinter::Result>& results, bool usequeries,
+                                                StatisticsLevel statisticsLevel)
+        {
+            searchstate_t ss;
+            ss.enabledTransitionsCount.resize(_net.numberOfTransitions(), 0);
+            ss.expandedStates = 0;
+            ss.exploredStates = 0;
+            ss.usequeries = usequeries;
+
+            State working;
+            _initial.setMarking(_net.makeInitialMarking());
+            working.setMarking(_net.makeInitialMarking());
+            auto& states = _cache->states();
+
+            for(size_t id = 0; id < _cache->size(); ++id)
+            {
+                _cache->decode(working, id);
+                auto succs = _cache->successors(id);
+                auto fired = _cache->transitions(id);
+                for(auto it = succs.first; it != succs.second; ++it, ++fired)
+                    ss.enabledTransitionsCount[*fired]++;
+                ss.exploredStates++;
+                _satisfyingMarking = id;
+                if(checkQueries(queries, results, working, ss, &states))
+                {
+                    if(statisticsLevel != StatisticsLevel::None)
+                        printStats(ss, &states, statisticsLevel);
+                    _max_tokens = states.maxTokens();
+                    return true;
+                }
+                ss.expandedStates++;
+            }
+
+            for(size_t i= 0; i < queries.size(); ++i)
+            {
+                if(results[i] == ResultPrinter::Unknown)
+                {
+                    results[i] = doCallback(queries[i], i, ResultPrinter::NotSatisfied, ss, &states).first;
+                }
+            }
+
+            if(statisticsLevel != StatisticsLevel::None)
+                printStats(ss, &states, statisticsLevel);
+            _max_tokens = states.maxTokens();
+            return false;
+        }
+
         std::pair<ResultPrinter::Result,bool> ReachabilitySearch::doCallback(
             std::shared_ptr<PQL::Condition>& query, size_t i,
             ResultPrinter::Result r, searchstate_t& ss,
@@ -81,7 +187,7 @@ namespace PetriEngine {
         {
             return _callback.handle(i, query.get(), r, &states->maxPlaceBound(),
                         ss.expandedStates, ss.exploredStates, states->discovered(), states->maxTokens(),
-                        states, _satisfyingMarking, _initial.marking());
+                        states, _satisfyingMarking, _initial.marking(), _traceable);
         }
 
         void ReachabilitySearch::printStats(searchstate_t& ss,
@@ -129,6 +235,7 @@ namespace PetriEngine {
 
 #define TRYREACHPAR    (queries, results, usequeries, printstats, seed, initPotencies)
 #define TEMPPAR(X, Y)  if(keep_trace) return tryReach<X, Structures::TracableStateSet, Y> TRYREACHPAR ; \
+                       else if(lossy) return tryReach<X, Structures::LossyStateSet, Y> TRYREACHPAR ; \
                        else return tryReach<X, Structures::StateSet, Y> TRYREACHPAR ;
 #define TRYREACH(X)    if(stubbornreduction) TEMPPAR(X, ReducingSuccessorGenerator) \
                        else TEMPPAR(X, SuccessorGenerator)
@@ -137,6 +244,13 @@ namespace PetriEngine {
                        else return tryReachRandomWalk<Structures::RandomWalkStateSet, Y> TRYREACHPAR_RW ;
 #define TRYREACH_RW    if(stubbornreduction) TEMPPAR_RW(ReducingSuccessorGenerator) \
                        else TEMPPAR_RW(SuccessorGenerator)
+// stubborn sets annotate the (shared) query-tree during prepare, so the
+// parallel search is restricted to the plain successor generator and is only
+// used when partial order reduction is disabled.
+#define TRYREACH_PAR(X) if(parallel) return tryReachParallel<X, SuccessorGenerator> TRYREACHPAR ;
+#define TRYREACH_RW_PAR if(_threads > 1 && !stubbornreduction) { \
+                           if(keep_trace) return tryReachRandomWalkParallel<Structures::TracableRandomWalkStateSet, SuccessorGenerator> TRYREACHPAR_RW ; \
+                           else return tryReachRandomWalkParallel<Structures::RandomWalkStateSet, SuccessorGenerator> TRYREACHPAR_RW ; }
 
 
         size_t ReachabilitySearch::maxTokens() const {
@@ -155,30 +269,98 @@ namespace PetriEngine {
                     int64_t depthRandomWalk,
                     const int64_t incRandomWalk,
                     const std::vector<MarkVal>& initPotencies)
+        {
+            _outOfMemory = false;
+            auto found = _reachable(queries, results, strategy, stubbornreduction, statespacesearch, printstats,
+                                    keep_trace, seed, depthRandomWalk, incRandomWalk, initPotencies);
+            // the states of the search are released by now; retry with fingerprints only if that made room
+            bool exact = keep_trace || _storage == StateStorage::Exact;
+            if(_outOfMemory && exact && !stopped() && !MemoryBudget::refresh())
+            {
+                if(printstats != StatisticsLevel::None)
+                    std::cout << "Continuing the search with hash compaction and without trace" << std::endl;
+                auto storage = _storage;
+                _storage = StateStorage::HashCompaction;
+                _outOfMemory = false;
+                _traceable = !keep_trace;
+                found = _reachable(queries, results, strategy, stubbornreduction, statespacesearch, printstats,
+                                   false, seed, depthRandomWalk, incRandomWalk, initPotencies);
+                _storage = storage;
+                _traceable = true;
+            }
+            return found;
+        }
+
+        bool ReachabilitySearch::_reachable(
+                    std::vector<std::shared_ptr<PQL::Condition > >& queries,
+                    std::vector<ResultPrinter::Result>& results,
+                    Strategy strategy,
+                    bool stubbornreduction,
+                    bool statespacesearch,
+                    StatisticsLevel printstats,
+                    bool keep_trace,
+                    size_t seed,
+                    int64_t depthRandomWalk,
+                    const int64_t incRandomWalk,
+                    const std::vector<MarkVal>& initPotencies)
         {
             bool usequeries = !statespacesearch;
 
             // if we are searching for bounds
             if(!usequeries) strategy = Strategy::BFS;
 
+            // traces, upper-bounds and stubborn sets are only supported by the sequential search
+            bool parallel = _threads > 1 && !keep_trace && !stubbornreduction;
+            for(auto& q : queries)
+                parallel = parallel && !PQL::containsUpperBounds(q);
+
+            // lossy and disk storage cannot give traces, and are only implemented for the sequential search
+            bool lossy = (_storage == StateStorage::HashCompaction || _storage == StateStorage::Bitstate) && !keep_trace;
+            bool disk = _storage == StateStorage::Disk && !keep_trace;
+            parallel = parallel && !lossy && !disk;
+
+            _compiled.clear();
+            for(auto& q : queries)
+            {
+                _compiled.emplace_back(q, &_net);
+                // the guided searches update the distance of a successor from the atoms of its parent
+                if(strategy == Strategy::HEUR || strategy == Strategy::RPFS)
+                    _compiled.back().prepareIncremental();
+            }
+
+            if(_cache != nullptr && !keep_trace && _cache->covers(_net, _kbound) && _cache->build())
+                return tryReachCached(queries, results, usequeries, printstats);
+
+            if(disk && strategy != Strategy::RandomWalk)
+            {
+                if(stubbornreduction) return tryReachDisk<ReducingSuccessorGenerator>(queries, results, usequeries, printstats);
+                else return tryReachDisk<SuccessorGenerator>(queries, results, usequeries, printstats);
+            }
+
             switch(strategy)
             {
                 case Strategy::DFS:
+                    TRYREACH_PAR(DFSQueue)
                     TRYREACH(DFSQueue)
                     break;
                 case Strategy::BFS:
+                    TRYREACH_PAR(BFSQueue)
                     TRYREACH(BFSQueue)
                     break;
                 case Strategy::HEUR:
+                    TRYREACH_PAR(HeuristicQueue)
                     TRYREACH(HeuristicQueue)
                     break;
                 case Strategy::RDFS:
+                    TRYREACH_PAR(RDFSQueue)
                     TRYREACH(RDFSQueue)
                     break;
                 case Strategy::RPFS:
+                    TRYREACH_PAR(RandomPotencyQueue)
                     TRYREACH(RandomPotencyQueue)
                     break;
                 case Strategy::RandomWalk:
+                    TRYREACH_RW_PAR
                     TRYREACH_RW
                     break;
                 default:
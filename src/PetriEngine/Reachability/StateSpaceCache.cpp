@@ -0,0 +1,83 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "PetriEngine/Reachability/StateSpaceCache.h"
+#include "PetriEngine/SuccessorGenerator.h"
+
+#include <limits>
+
+namespace PetriEngine {
+    namespace Reachability {
+
+        bool StateSpaceCache::build(const std::atomic<bool>* stop)
+        {
+            if(_complete) return true;
+            std::lock_guard<std::mutex> build_guard(_build_lock);
+            if(_complete) return true;
+
+            std::lock_guard<std::mutex> guard(_lock);
+            Structures::State state;
+            Structures::State working;
+            state.setMarking(_net.makeInitialMarking());
+            working.setMarking(_net.makeInitialMarking());
+            SuccessorGenerator generator(_net);
+            generator.setIncremental(true);
+
+            // a stopped exploration is resumed by the next call, from the first unexpanded marking
+            if(_offsets.empty())
+            {
+                _offsets.push_back(0);
+                _states.add(state);
+            }
+
+            // ids are handed out in insertion order, so expanding them in order is a breadth-first search
+            for(size_t id = _offsets.size() - 1; id < _states.size(); ++id)
+            {
+                if(stop != nullptr && *stop)
+                    return false;
+                _states.decode(state, id);
+                generator.expanding(id);
+                generator.prepare(&state);
+                while(generator.next(working))
+                {
+                    auto res = _states.add(working);
+                    // the marking exceeds the k-bound
+                    if(!res.first && res.second == std::numeric_limits<size_t>::max())
+                        continue;
+                    if(res.first)
+                        generator.stored(res.second);
+                    _targets.push_back(res.second);
+                    _transitions.push_back(generator.fired());
+                }
+                _offsets.push_back(_targets.size());
+            }
+            _complete = true;
+            return true;
+        }
+
+        void StateSpaceCache::decode(Structures::State& state, size_t id)
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _states.decode(state, id);
+        }
+
+        std::pair<bool, size_t> StateSpaceCache::lookup(Structures::State& state)
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            return _states.lookup(state);
+        }
+    }
+}
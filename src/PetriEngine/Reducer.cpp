@@ -21,6 +21,24 @@
 
 namespace PetriEngine {
 
+    std::vector<uint32_t> ReductionWorklist::take(uint32_t n)
+    {
+        std::vector<uint32_t> ids;
+        if(_all)
+        {
+            ids.resize(n);
+            std::iota(ids.begin(), ids.end(), 0);
+            _all = false;
+            return ids;
+        }
+        ids.swap(_ids);
+        for(auto id : ids)
+            _queued[id] = false;
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::lower_bound(ids.begin(), ids.end(), n), ids.end());
+        return ids;
+    }
+
     Reducer::Reducer(PetriNetBuilder* p)
     : parent(p) {
     }
@@ -167,6 +185,7 @@ namespace PetriEngine {
     {
         Transition& trans = getTransition(t);
         assert(!trans.skip);
+        touchTransition(t);
         for(auto p : trans.post)
         {
             eraseTransition(parent->_places[p.place].producers, t);
@@ -187,6 +206,7 @@ namespace PetriEngine {
         ++_skippedPlaces;
         Place& pl = parent->_places[place];
         assert(!pl.skip);
+        touchPlace(place);
         pl.skip = true;
         for(auto& t : pl.consumers)
         {
@@ -213,6 +233,7 @@ namespace PetriEngine {
         Place& place = parent->_places[p];
         Transition& trans = parent->_transitions[t];
 
+        touchArc(p, t);
         eraseTransition(place.consumers, t);
 
         Arc a;
@@ -228,6 +249,7 @@ namespace PetriEngine {
         Place& place = parent->_places[p];
         Transition& trans = parent->_transitions[t];
 
+        touchArc(p, t);
         eraseTransition(place.producers, t);
 
         Arc a;
@@ -238,6 +260,77 @@ namespace PetriEngine {
         assert(consistent());
     }
 
+    void Reducer::queuePlace(uint32_t place)
+    {
+        _workB.push(place);
+        _workEP.push(place);
+        _workF.push(place);
+    }
+
+    void Reducer::queueTransition(uint32_t transition)
+    {
+        _workA.push(transition);
+        _workG.push(transition);
+    }
+
+    void Reducer::touchArc(uint32_t p, uint32_t t)
+    {
+        queuePlace(p);
+        queueTransition(t);
+        const Transition& trans = parent->_transitions[t];
+        for(auto& a : trans.pre)
+            queuePlace(a.place);
+        for(auto& a : trans.post)
+            queuePlace(a.place);
+        const Place& place = parent->_places[p];
+        for(auto u : place.consumers)
+            queueTransition(u);
+        for(auto u : place.producers)
+            queueTransition(u);
+    }
+
+    void Reducer::touchPlace(uint32_t p)
+    {
+        queuePlace(p);
+        const Place& place = parent->_places[p];
+        for(auto* ts : {&place.consumers, &place.producers})
+        {
+            for(auto u : *ts)
+            {
+                queueTransition(u);
+                const Transition& trans = parent->_transitions[u];
+                for(auto& a : trans.pre)
+                    queuePlace(a.place);
+                for(auto& a : trans.post)
+                    queuePlace(a.place);
+            }
+        }
+    }
+
+    void Reducer::touchTransition(uint32_t t)
+    {
+        queueTransition(t);
+        const Transition& trans = parent->_transitions[t];
+        for(auto* as : {&trans.pre, &trans.post})
+        {
+            for(auto& a : *as)
+            {
+                queuePlace(a.place);
+                const Place& place = parent->_places[a.place];
+                for(auto u : place.consumers)
+                    queueTransition(u);
+                for(auto u : place.producers)
+                    queueTransition(u);
+            }
+        }
+    }
+
+    void Reducer::touchAll()
+    {
+        for(auto* w : {&_workA, &_workB, &_workEP, &_workF, &_workG})
+            w->reset();
+    }
+
     bool Reducer::consistent()
     {
 #ifndef NDEBUG
@@ -303,9 +396,12 @@ namespace PetriEngine {
     bool Reducer::ReducebyRuleA(uint32_t* placeInQuery) {
         // Rule A  - find transition t that has exactly one place in pre and post and remove one of the places (and t)
         bool continueReductions = false;
-        const size_t numberoftransitions = parent->numberOfTransitions();
-        for (uint32_t t = 0; t < numberoftransitions; t++) {
-            if(hasTimedout()) return false;
+        for (uint32_t t : _workA.take(parent->numberOfTransitions())) {
+            if(hasTimedout())
+            {
+                _workA.reset();
+                return false;
+            }
             Transition& trans = getTransition(t);
 
             // we have already removed
@@ -374,6 +470,7 @@ namespace PetriEngine {
             {
                 // UA2. move the token for the initial marking, makes things simpler.
                 parent->initialMarking[pPost.place] += ((parent->initialMarking[pPre]/w) * pPost.weight);
+                queuePlace(pPost.place);
             }
             parent->initialMarking[pPre] = 0;
 
@@ -410,6 +507,7 @@ namespace PetriEngine {
                     }
                     assert(dest->weight > 0);
                 }
+                touchTransition(_t);
             }
             // UA1. remove place
             skipPlace(pPre);
@@ -421,9 +519,12 @@ namespace PetriEngine {
 
         // Rule B - find place p that has exactly one transition in pre and exactly one in post and remove the place
         bool continueReductions = false;
-        const size_t numberofplaces = parent->numberOfPlaces();
-        for (uint32_t p = 0; p < numberofplaces; p++) {
-            if(hasTimedout()) return false;
+        for (uint32_t p : _workB.take(parent->numberOfPlaces())) {
+            if(hasTimedout())
+            {
+                _workB.reset();
+                return false;
+            }
             Place& place = parent->_places[p];
 
             if(place.skip) continue;    // already removed
@@ -612,6 +713,9 @@ namespace PetriEngine {
                         break;
                     }
                 }
+                // the markings moved along the arcs of tOut, and p lost an arc
+                touchTransition(tOut);
+                touchPlace(p);
             }
             // UB1. remove transition
             if(place.producers.size() == 0)
@@ -946,10 +1050,13 @@ namespace PetriEngine {
     bool Reducer::ReducebyRuleEP(uint32_t* placeInQuery) {
         // Rule P is an extension on Rule E
         bool continueReductions = false;
-        const size_t numberofplaces = parent->numberOfPlaces();
-        for(uint32_t p = 0; p < numberofplaces; ++p)
+        for(uint32_t p : _workEP.take(parent->numberOfPlaces()))
         {
-            if(hasTimedout()) return false;
+            if(hasTimedout())
+            {
+                _workEP.reset();
+                return false;
+            }
             Place& place = parent->_places[p];
             if(place.skip) continue;
             // If more producers, we are guaranteed that one producer have a positive effect on the place, and as such E1 precondition is false
@@ -1051,9 +1158,13 @@ namespace PetriEngine {
     bool Reducer::ReducebyRuleF(uint32_t* placeInQuery) {
         bool continueReductions = false;
         const size_t numberofplaces = parent->numberOfPlaces();
-        for(uint32_t p = 0; p < numberofplaces; ++p)
+        for(uint32_t p : _workF.take(numberofplaces))
         {
-            if(hasTimedout()) return false;
+            if(hasTimedout())
+            {
+                _workF.reset();
+                return false;
+            }
             Place& place = parent->_places[p];
             if(place.skip) continue;
             if(place.inhib) continue;
@@ -1222,9 +1333,10 @@ namespace PetriEngine {
                 continueReductions = true;
                 _ruleF++;
             }
-            else if (inhibArcs == 0)
+            else if (inhibArcs == 0 && place.inhib)
             {
                 place.inhib = false;
+                touchPlace(p);
             }
         }
         assert(consistent());
@@ -1234,9 +1346,13 @@ namespace PetriEngine {
     bool Reducer::ReducebyRuleG(uint32_t* placeInQuery, bool remove_loops, bool remove_consumers) {
         if(!remove_loops) return false;
         bool continueReductions = false;
-        for(uint32_t t = 0; t < parent->numberOfTransitions(); ++t)
+        for(uint32_t t : _workG.take(parent->numberOfTransitions()))
         {
-            if(hasTimedout()) return false;
+            if(hasTimedout())
+            {
+                _workG.reset();
+                return false;
+            }
             Transition& trans = parent->_transitions[t];
             if(trans.skip) continue;
             if(trans.inhib) continue;
@@ -1464,6 +1580,7 @@ namespace PetriEngine {
                     }
                 }
                 parent->initialMarking[p1] += parent->initialMarking[p2];
+                touchPlace(p1);
                 skipPlace(p2);
                 assert(placeInQuery[p2] == 0);
             }
@@ -1602,6 +1719,7 @@ namespace PetriEngine {
                 arc->weight /= mod;
             }
             parent->initialMarking[p] /= mod;
+            touchPlace(p);
             any = true;
         }
         return any;
@@ -2182,6 +2300,7 @@ namespace PetriEngine {
                 }
                 else
                 {
+                    touchPlace(p);
                     for(auto t : place.consumers)
                     {
                         auto& trans = getTransition(t);
@@ -2221,6 +2340,7 @@ namespace PetriEngine {
                         else if((_pflags[p] & CAN_INC) == 0 && inArc->weight > parent->initialMarking[p])
                         {
                             // inhibitor is useless
+                            touchArc(p, t);
                             trans.pre.erase(inArc);
                             place.consumers.erase(place.consumers.begin() + i);
                             ++_ruleP;
@@ -2252,6 +2372,7 @@ namespace PetriEngine {
                         {
                             if(out->weight > inArc->weight)
                             {
+                                touchArc(p, t);
                                 out->weight -= inArc->weight;
                                 trans.pre.erase(inArc);
                                 place.consumers.erase(place.consumers.begin() + i);
@@ -2260,6 +2381,7 @@ namespace PetriEngine {
                             }
                             else if(out->weight == inArc->weight)
                             {
+                                touchArc(p, t);
                                 trans.pre.erase(inArc);
                                 place.consumers.erase(place.consumers.begin() + i);
                                 skipOutArc(t, p);
@@ -2362,10 +2484,12 @@ namespace PetriEngine {
             for (const Arc& prearc : tran.pre)
             {
                 parent->initialMarking[prearc.place] -= prearc.weight * k;
+                queuePlace(prearc.place);
             }
             for (const Arc& postarc : tran.post)
             {
                 parent->initialMarking[postarc.place] += postarc.weight * k;
+                queuePlace(postarc.place);
             }
             if(reconstructTrace)
             {
@@ -2532,6 +2656,8 @@ namespace PetriEngine {
                 --n_new_trans;
                 continueReductions = true;
                 _ruleR++;
+                // new transitions were added around pid
+                touchAll();
             }
 
             if (removedAllProducers && parent->initialMarking[pid] == 0)
@@ -2817,6 +2943,7 @@ namespace PetriEngine {
                 --n_added;
                 continueReductions = true;
                 _ruleS++;
+                touchAll();
             }
 
             if (place.consumers.empty()) {
@@ -2841,6 +2968,7 @@ namespace PetriEngine {
             bool all_reach, bool all_ltl, bool contains_next, std::vector<uint32_t>& reduction) {
         this->_timeout = timeout;
         _timer = std::chrono::high_resolution_clock::now();
+        touchAll();
         assert(consistent());
         constexpr uint32_t explosion_limiter = 6;
 
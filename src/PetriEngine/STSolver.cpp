@@ -4,7 +4,7 @@
 
 namespace PetriEngine {     
     
-    STSolver::STSolver(Reachability::ResultPrinter& printer, const PetriNet& net, PQL::Condition * query, uint32_t depth) : printer(printer), _query(query), _net(net){
+    STSolver::STSolver(Reachability::AbstractHandler& printer, const PetriNet& net, PQL::Condition * query, uint32_t depth, size_t index) : printer(printer), _query(query), _index(index), _net(net){
         if(depth == 0){
             _siphonDepth = _net._nplaces;
         } else {
@@ -55,7 +55,7 @@ namespace PetriEngine {
             extend(p, preset, postset);
             if(!siphonTrap(siphon, has_st, preset, postset))
             {
-                if(timeout())
+                if(timeout() && (_stop == nullptr || !*_stop))
                 {
                     std::cout << "TIMEOUT OF SIPHON" << std::endl;
                 }
@@ -205,13 +205,13 @@ namespace PetriEngine {
     
     Reachability::ResultPrinter::Result STSolver::printResult(){
         if(_siphonPropperty){
-            return printer.handle(0, _query, Reachability::ResultPrinter::NotSatisfied).first;
+            return printer.handle(_index, _query, Reachability::ResultPrinter::NotSatisfied).first;
         } else {
             return Reachability::ResultPrinter::Unknown;
         }
     }
     bool STSolver::timeout() const {
-        return (duration() >= _timelimit);
+        return (duration() >= _timelimit) || (_stop != nullptr && _stop->load(std::memory_order_relaxed));
     }
     uint32_t STSolver::duration() const {
         auto end = std::chrono::high_resolution_clock::now();
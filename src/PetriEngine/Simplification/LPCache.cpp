@@ -19,6 +19,94 @@ namespace PetriEngine {
 
         LPCache::~LPCache() {
         }
+
+        // true if every row of small is in large, equations of both sorted by row,
+        // and cmp(small bound, large bound) holds for each such row
+        template<typename S, typename L, typename C>
+        static bool contained(const S& small, const L& large, C&& cmp)
+        {
+            auto it = large.begin();
+            for (const auto& eq : small)
+            {
+                while (it != large.end() && it->row < eq.row)
+                    ++it;
+                if (it == large.end() || it->row != eq.row || !cmp(eq, *it))
+                    return false;
+                ++it;
+            }
+            return true;
+        }
+
+        void LPCache::bind(const void* net, const void* marking)
+        {
+            if (net == _net && marking == _marking)
+                return;
+            _net = net;
+            _marking = marking;
+            _infeasible.clear();
+            _feasible.clear();
+            _infeasible_by_first.clear();
+            _feasible_by_row.clear();
+        }
+
+        bool LPCache::knownInfeasible(const std::vector<equation_t>& equations) const
+        {
+            for (const auto& eq : equations)
+            {
+                auto it = _infeasible_by_first.find(eq.row);
+                if (it == _infeasible_by_first.end())
+                    continue;
+                for (auto id : it->second)
+                {
+                    // the stored bounds must admit everything the query admits
+                    if (contained(_infeasible[id], equations, [](const bound_t& known, const equation_t& query) {
+                        return known.lower <= query.lower && query.upper <= known.upper;
+                    }))
+                        return true;
+                }
+            }
+            return false;
+        }
+
+        bool LPCache::knownFeasible(const std::vector<equation_t>& equations) const
+        {
+            if (equations.empty())
+                return false;
+            auto it = _feasible_by_row.find(equations.front().row);
+            if (it == _feasible_by_row.end())
+                return false;
+            for (auto id : it->second)
+            {
+                // the query bounds must admit everything the stored bounds admit
+                if (contained(equations, _feasible[id], [](const equation_t& query, const bound_t& known) {
+                    return query.lower <= known.lower && known.upper <= query.upper;
+                }))
+                    return true;
+            }
+            return false;
+        }
+
+        void LPCache::addInfeasible(const std::vector<equation_t>& equations)
+        {
+            if (equations.empty())
+                return;
+            system_t system;
+            for (const auto& eq : equations)
+                system.push_back({eq.row, eq.lower, eq.upper});
+            _infeasible_by_first[system.front().row].push_back(_infeasible.size());
+            _infeasible.emplace_back(std::move(system));
+        }
+
+        void LPCache::addFeasible(const std::vector<equation_t>& equations)
+        {
+            system_t system;
+            for (const auto& eq : equations)
+            {
+                system.push_back({eq.row, eq.lower, eq.upper});
+                _feasible_by_row[eq.row].push_back(_feasible.size());
+            }
+            _feasible.emplace_back(std::move(system));
+        }
      
         
     }
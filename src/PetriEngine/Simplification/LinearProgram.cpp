@@ -46,8 +46,20 @@ namespace PetriEngine {
 
         constexpr auto infty = std::numeric_limits<REAL>::infinity();
 
+        // The problem is shared by all LPs of a context, so the simplex starts from the basis of the
+        // previous solve. Removing query rows may leave that basis invalid, then a fresh one is made.
+        static int warmSimplex(glp_prob* lp, const glp_smcp* settings)
+        {
+            auto result = glp_simplex(lp, settings);
+            if (result == GLP_EBADB || result == GLP_ESING || result == GLP_ECOND)
+            {
+                glp_adv_basis(lp, 0);
+                result = glp_simplex(lp, settings);
+            }
+            return result;
+        }
+
         bool LinearProgram::isImpossible(const PQL::SimplificationContext& context, uint32_t solvetime) {
-            bool use_ilp = true;
             auto net = context.net();
 
             if (_result != result_t::UKNOWN)
@@ -64,6 +76,22 @@ namespace PetriEngine {
                 return false;
             }
 
+            auto cache = context.cache();
+            if (cache != nullptr)
+            {
+                cache->bind(net, context.marking());
+                if (cache->knownInfeasible(_equations))
+                {
+                    _result = result_t::IMPOSSIBLE;
+                    return true;
+                }
+                if (cache->knownFeasible(_equations))
+                {
+                    _result = result_t::POSSIBLE;
+                    return false;
+                }
+            }
+
             const uint32_t nCol = net->numberOfTransitions();
             const uint32_t nRow = net->numberOfPlaces() + _equations.size();
 
@@ -72,12 +100,11 @@ namespace PetriEngine {
             for (size_t i = 0; i <= nCol; ++i)
                 indir[i] = i;
 
-            auto lp = context.makeBaseLP();
+            auto lp = context.acquireLP();
             if (lp == nullptr)
                 return false;
 
-            int rowno = 1 + net->numberOfPlaces();
-            glp_add_rows(lp, _equations.size());
+            int rowno = glp_add_rows(lp, _equations.size());
             for (const auto& eq : _equations) {
                 auto l = eq.row->write_indir(row, indir);
                 assert(!(std::isinf(eq.upper) && std::isinf(eq.lower)));
@@ -91,7 +118,7 @@ namespace PetriEngine {
                         if (eq.lower > eq.upper)
                         {
                             _result = result_t::IMPOSSIBLE;
-                            glp_delete_prob(lp);
+                            context.releaseLP(lp);
                             return true;
                         }
                         glp_set_row_bnds(lp, rowno, GLP_DB, eq.lower, eq.upper);
@@ -106,20 +133,12 @@ namespace PetriEngine {
                 if (context.timeout())
                 {
                     // std::cerr << "glpk: construction timeout" << std::endl;
-                    glp_delete_prob(lp);
+                    context.releaseLP(lp);
                     return false;
                 }
             }
 
-            // Set objective, kind and bounds
-            for (size_t i = 1; i <= nCol; i++) {
-                glp_set_obj_coef(lp, i, 1);
-                glp_set_col_kind(lp, i, use_ilp ? GLP_IV : GLP_CV);
-                glp_set_col_bnds(lp, i, GLP_LO, 0, infty);
-            }
-
-            // Minimize the objective
-            glp_set_obj_dir(lp, GLP_MIN);
+            // the objective, kinds and bounds of the columns are part of the base problem
             auto stime = glp_time();
             glp_smcp settings;
             glp_init_smcp(&settings);
@@ -127,7 +146,7 @@ namespace PetriEngine {
             settings.tm_lim = timeout;
             settings.presolve = GLP_OFF;
             settings.msg_lev = 0;
-            auto result = glp_simplex(lp, &settings);
+            auto result = warmSimplex(lp, &settings);
             if (result == GLP_ETMLIM)
             {
                 _result = result_t::UKNOWN;
@@ -174,14 +193,21 @@ namespace PetriEngine {
             {
                 _result = result_t::IMPOSSIBLE;
             }
-            glp_delete_prob(lp);
+            context.releaseLP(lp);
+
+            if (cache != nullptr)
+            {
+                if (_result == result_t::IMPOSSIBLE)
+                    cache->addInfeasible(_equations);
+                else if (_result == result_t::POSSIBLE)
+                    cache->addFeasible(_equations);
+            }
 
             return _result == result_t::IMPOSSIBLE;
         }
 
         void LinearProgram::solvePotency(const PQL::SimplificationContext& context, std::vector<uint32_t>& potencies)
         {
-            bool use_ilp = false; // No need to call the ILP solver
             auto net = context.net();
 
             if (_equations.size() == 0 || context.potencyTimeout())
@@ -196,12 +222,11 @@ namespace PetriEngine {
             for (size_t i = 0; i <= nCol; ++i)
                 indir[i] = i;
 
-            auto lp = context.makeBaseLP();
+            auto lp = context.acquireLP();
             if (lp == nullptr)
                 return;
 
-            int rowno = 1 + net->numberOfPlaces();
-            glp_add_rows(lp, _equations.size());
+            int rowno = glp_add_rows(lp, _equations.size());
             for (const auto& eq : _equations)
             {
                 auto l = eq.row->write_indir(row, indir);
@@ -215,7 +240,7 @@ namespace PetriEngine {
                     {
                         if (eq.lower > eq.upper)
                         {
-                            glp_delete_prob(lp);
+                            context.releaseLP(lp);
                             return;
                         }
                         glp_set_row_bnds(lp, rowno, GLP_DB, eq.lower, eq.upper);
@@ -229,28 +254,20 @@ namespace PetriEngine {
 
                 if (context.potencyTimeout())
                 {
-                    glp_delete_prob(lp);
+                    context.releaseLP(lp);
                     return;
                 }
             }
 
-            // Set objective, kind and bounds
-            for (size_t i = 1; i <= nCol; i++)
-            {
-                glp_set_obj_coef(lp, i, 1); // We want to minimize the sum of the number of transitions fired
-                glp_set_col_kind(lp, i, use_ilp ? GLP_IV : GLP_CV);
-                glp_set_col_bnds(lp, i, GLP_LO, 0, infty);
-            }
-
-            // Minimize the objective
-            glp_set_obj_dir(lp, GLP_MIN);
+            // The base problem minimizes the sum of the number of transitions fired.
+            // Only the LP relaxation is solved, so the integer kind of the columns is ignored.
             glp_smcp settings;
             glp_init_smcp(&settings);
             auto timeout = context.getPotencyTimeout() * 1000;
             settings.tm_lim = timeout;
             settings.presolve = GLP_OFF;
             settings.msg_lev = 0;
-            auto result = glp_simplex(lp, &settings);
+            auto result = warmSimplex(lp, &settings);
 
             // if (result == GLP_ETMLIM): do nothing
             if (result == 0)
@@ -269,7 +286,7 @@ namespace PetriEngine {
                 }
             }
 
-            glp_delete_prob(lp);
+            context.releaseLP(lp);
         }
 
         std::vector<std::pair<double,bool>> LinearProgram::bounds(const PQL::SimplificationContext& context, uint32_t solvetime, const std::vector<uint32_t>& places)
@@ -351,20 +368,17 @@ namespace PetriEngine {
 
                 // Set objective
 
-                auto tmp_lp = context.makeBaseLP();
+                auto tmp_lp = context.acquireLP();
                 if (tmp_lp == nullptr)
                     return result;
 
                 // Max the objective
                 glp_set_obj_dir(tmp_lp, GLP_MAX);
 
-                for (size_t i = 1; i <= nCol; i++) {
+                for (size_t i = 1; i <= nCol; i++)
                     glp_set_obj_coef(tmp_lp, i, row[i]);
-                    glp_set_col_kind(tmp_lp, i, GLP_IV);
-                    glp_set_col_bnds(tmp_lp, i, GLP_LO, 0, infty);
-                }
 
-                auto rs = glp_simplex(tmp_lp, &settings);
+                auto rs = warmSimplex(tmp_lp, &settings);
                 if (rs == GLP_ETMLIM)
                 {
                     //std::cerr << "glpk: timeout" << std::endl;
@@ -406,7 +420,11 @@ namespace PetriEngine {
                     result[pi].first = p0;
                     result[pi].second = all_zero;
                 }
-                glp_erase_prob(tmp_lp);
+                // restore the objective of the base problem
+                for (size_t i = 1; i <= nCol; i++)
+                    glp_set_obj_coef(tmp_lp, i, 1);
+                glp_set_obj_dir(tmp_lp, GLP_MIN);
+                context.releaseLP(tmp_lp);
                 if (pi == places.size() && result[places.size()].first >= p0)
                 {
                     return result;
@@ -1,6 +1,9 @@
 #include "PetriEngine/Simplification/LinearPrograms.h"
 
 #include <vector>
+#ifdef VERIFYPN_MC_Simplification
+#include <atomic>
+#endif
 
 namespace PetriEngine {
     namespace Simplification {
@@ -195,6 +198,13 @@ namespace PetriEngine {
 
         void MergeCollection::satisfiableImpl(const PQL::SimplificationContext& context, uint32_t solvetime)
         {
+#ifdef VERIFYPN_MC_Simplification
+            if (context.lpThreads() > 1)
+            {
+                satisfiableParallel(context, solvetime);
+                return;
+            }
+#endif
             // this is where the magic needs to happen
             bool hasmore = false;
             do {
@@ -227,6 +237,83 @@ namespace PetriEngine {
                 _result = IMPOSSIBLE;
         }
 
+#ifdef VERIFYPN_MC_Simplification
+        void MergeCollection::satisfiableParallel(const PQL::SimplificationContext& context, uint32_t solvetime)
+        {
+            const uint32_t threads = context.lpThreads();
+            auto cache = context.cache();
+            std::vector<LinearProgram> batch;
+            std::vector<bool> known;
+            bool hasmore = true;
+            while (hasmore)
+            {
+                if (context.timeout())
+                {
+                    _result = POSSIBLE;
+                    return;
+                }
+
+                // merge() is not re-entrant, so the programs are enumerated here and only solved by the workers
+                batch.clear();
+                known.clear();
+                size_t first = std::numeric_limits<size_t>::max();
+                while (hasmore && batch.size() < 4 * threads && first == std::numeric_limits<size_t>::max())
+                {
+                    LinearProgram prog;
+                    bool has_empty = false;
+                    hasmore = merge(has_empty, prog);
+                    if (has_empty)
+                    {
+                        _result = POSSIBLE;
+                        return;
+                    }
+                    bool infeasible = cache != nullptr && cache->knownInfeasible(prog.equations());
+                    if (!infeasible && cache != nullptr && cache->knownFeasible(prog.equations()))
+                        first = batch.size();
+                    batch.emplace_back();
+                    batch.back().swap(prog);
+                    known.push_back(infeasible);
+                }
+                first = std::min(first, batch.size());
+
+                // index of the first program that is not impossible; programs after it need not be solved
+                std::atomic<size_t> next(0), possible(first);
+                context.runWorkers(std::min<size_t>(threads, first), [&](const PQL::SimplificationContext& wcontext) {
+                    while (true)
+                    {
+                        auto i = next++;
+                        if (i >= possible)
+                            return;
+                        if (known[i])
+                            continue;
+                        if (context.timeout() || !batch[i].isImpossible(wcontext, solvetime))
+                        {
+                            auto p = possible.load();
+                            while (i < p && !possible.compare_exchange_weak(p, i));
+                        }
+                    }
+                });
+
+                first = possible;
+                if (cache != nullptr)
+                {
+                    for (size_t i = 0; i < first; ++i)
+                        if (!known[i])
+                            cache->addInfeasible(batch[i].equations());
+                    if (first < batch.size() && batch[first].knownPossible())
+                        cache->addFeasible(batch[first].equations());
+                }
+                nsat += first;
+                if (first < batch.size())
+                {
+                    _result = POSSIBLE;
+                    return;
+                }
+            }
+            _result = IMPOSSIBLE;
+        }
+#endif
+
         uint32_t MergeCollection::explorePotencyImpl(const PQL::SimplificationContext& context,
             std::vector<uint32_t> &potencies, uint32_t maxConfigurationsSolved)
         {
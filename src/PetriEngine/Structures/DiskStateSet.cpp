@@ -0,0 +1,347 @@
+/* VerifyPN - TAPAAL Petri Net Engine
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PetriEngine/Structures/DiskStateSet.h"
+#include "utils/errors.h"
+
+#include <algorithm>
+#include <cstring>
+#include <queue>
+#include <random>
+
+namespace PetriEngine {
+    namespace Structures {
+
+        // records are a 16 bit length followed by the encoding; ordered by length, then bytes
+        static int compare(const unsigned char* a, const unsigned char* b)
+        {
+            uint16_t la, lb;
+            std::memcpy(&la, a, sizeof(uint16_t));
+            std::memcpy(&lb, b, sizeof(uint16_t));
+            if (la != lb)
+                return la < lb ? -1 : 1;
+            return std::memcmp(a + sizeof(uint16_t), b + sizeof(uint16_t), la);
+        }
+
+        static size_t recordSize(const unsigned char* record)
+        {
+            uint16_t length;
+            std::memcpy(&length, record, sizeof(uint16_t));
+            return sizeof(uint16_t) + length;
+        }
+
+        static constexpr size_t IO_BUFFER = 1 << 20;
+        // runs merged at once; each open run holds an IO_BUFFER
+        static constexpr size_t FAN_IN = 64;
+
+        class DiskStateSet::writer_t {
+        public:
+            explicit writer_t(const std::filesystem::path& path)
+            : _buffer(IO_BUFFER) {
+                _file = std::fopen(path.string().c_str(), "wb");
+                if (_file == nullptr)
+                    throw base_error("Could not open ", path, " for writing");
+                std::setvbuf(_file, _buffer.data(), _IOFBF, _buffer.size());
+            }
+
+            ~writer_t() {
+                if (_file != nullptr)
+                    std::fclose(_file);
+            }
+
+            void write(const unsigned char* record)
+            {
+                auto size = recordSize(record);
+                if (std::fwrite(record, 1, size, _file) != size)
+                    throw base_error("Could not write state-space file, the disk may be full");
+            }
+
+            void close()
+            {
+                auto ok = std::fclose(_file) == 0;
+                _file = nullptr;
+                if (!ok)
+                    throw base_error("Could not write state-space file, the disk may be full");
+            }
+
+        private:
+            std::FILE* _file;
+            std::vector<char> _buffer;
+        };
+
+        class DiskStateSet::reader_t {
+        public:
+            explicit reader_t(const std::filesystem::path& path)
+            : _buffer(IO_BUFFER) {
+                _file = std::fopen(path.string().c_str(), "rb");
+                if (_file == nullptr)
+                    throw base_error("Could not open ", path, " for reading");
+                std::setvbuf(_file, _buffer.data(), _IOFBF, _buffer.size());
+                next();
+            }
+
+            ~reader_t() {
+                std::fclose(_file);
+            }
+
+            bool valid() const {
+                return _valid;
+            }
+
+            const unsigned char* record() const {
+                return _record.data();
+            }
+
+            bool next()
+            {
+                uint16_t length;
+                _valid = std::fread(&length, sizeof(uint16_t), 1, _file) == 1;
+                if (!_valid)
+                    return false;
+                _record.resize(sizeof(uint16_t) + length);
+                std::memcpy(_record.data(), &length, sizeof(uint16_t));
+                if (std::fread(_record.data() + sizeof(uint16_t), 1, length, _file) != length)
+                    throw base_error("State-space file is truncated");
+                return true;
+            }
+
+        private:
+            std::FILE* _file;
+            std::vector<char> _buffer;
+            std::vector<unsigned char> _record;
+            bool _valid = false;
+        };
+
+        DiskStateSet::DiskStateSet(const PetriNet& net, uint32_t kbound, const std::string& directory,
+                                   size_t buffer, int nplaces)
+        : StateSetInterface(net, kbound, nplaces), _encoder(_nplaces, kbound), _buffer_size(buffer)
+        {
+            std::error_code ec;
+            auto base = directory.empty() ? std::filesystem::temp_directory_path(ec)
+                                          : std::filesystem::path(directory);
+            if (ec)
+                throw base_error("Could not find a temporary directory: ", ec.message());
+            std::random_device rd;
+            do {
+                _directory = base / ("verifypn-" + std::to_string(rd()));
+            } while (!std::filesystem::create_directories(_directory, ec) && !ec);
+            if (ec)
+                throw base_error("Could not create ", _directory, ": ", ec.message());
+            _buffer.reserve(std::min<size_t>(_buffer_size, IO_BUFFER) + (1 << 16));
+        }
+
+        DiskStateSet::~DiskStateSet()
+        {
+            _reader.reset();
+            std::error_code ec;
+            std::filesystem::remove_all(_directory, ec);
+        }
+
+        std::filesystem::path DiskStateSet::_file(const char* kind)
+        {
+            return _directory / (kind + std::to_string(_files++));
+        }
+
+        bool DiskStateSet::add(const State& state)
+        {
+            ++_discovered;
+            MarkVal sum = 0;
+            bool allsame = true;
+            uint32_t val = 0;
+            uint32_t active = 0;
+            for (uint32_t i = 0; i < _nplaces; ++i)
+            {
+                auto m = state.marking()[i];
+                if (m == 0) continue;
+                if (val != 0 && m != val) allsame = false;
+                val = std::max(m, val);
+                ++active;
+                sum += m;
+            }
+
+            if (_maxTokens < sum)
+                _maxTokens = sum;
+            if (_kbound != 0 && sum > _kbound)
+                return false;
+
+            auto length = _encoder.encode(state.marking(), _encoder.getType(sum, active, allsame, val));
+            if (length >= std::numeric_limits<uint16_t>::max())
+                throw base_error("Marking could not be encoded into less than 2^16 bytes");
+            uint16_t l = length;
+            _offsets.push_back(_buffer.size());
+            auto* raw = reinterpret_cast<const unsigned char*>(&l);
+            _buffer.insert(_buffer.end(), raw, raw + sizeof(uint16_t));
+            _buffer.insert(_buffer.end(), _encoder.scratchpad().const_raw(), _encoder.scratchpad().const_raw() + length);
+
+            if (_buffer.size() >= _buffer_size)
+                _flush();
+            return true;
+        }
+
+        void DiskStateSet::_flush()
+        {
+            if (_offsets.empty())
+                return;
+            auto* data = _buffer.data();
+            std::sort(_offsets.begin(), _offsets.end(), [data](size_t a, size_t b) {
+                return compare(data + a, data + b) < 0;
+            });
+            _runs.push_back(_file("run"));
+            writer_t out(_runs.back());
+            const unsigned char* last = nullptr;
+            for (auto o : _offsets)
+            {
+                if (last != nullptr && compare(last, data + o) == 0)
+                    continue;
+                last = data + o;
+                out.write(last);
+            }
+            out.close();
+            _offsets.clear();
+            _buffer.clear();
+        }
+
+        void DiskStateSet::_merge(const std::vector<std::filesystem::path>& paths,
+                                  const std::function<void(const unsigned char*)>& emit)
+        {
+            std::vector<std::unique_ptr<reader_t>> runs;
+            for (auto& r : paths)
+                runs.emplace_back(std::make_unique<reader_t>(r));
+
+            auto later = [&runs](size_t a, size_t b) {
+                return compare(runs[a]->record(), runs[b]->record()) > 0;
+            };
+            std::priority_queue<size_t, std::vector<size_t>, decltype(later)> heap(later);
+            for (size_t i = 0; i < runs.size(); ++i)
+                if (runs[i]->valid())
+                    heap.push(i);
+
+            std::vector<unsigned char> last;
+            while (!heap.empty())
+            {
+                auto i = heap.top();
+                heap.pop();
+                auto* rec = runs[i]->record();
+                if (last.empty() || compare(last.data(), rec) != 0)
+                {
+                    last.assign(rec, rec + recordSize(rec));
+                    emit(rec);
+                }
+                if (runs[i]->next())
+                    heap.push(i);
+            }
+        }
+
+        void DiskStateSet::_compact()
+        {
+            std::error_code ec;
+            while (_runs.size() > FAN_IN)
+            {
+                std::vector<std::filesystem::path> merged;
+                for (size_t i = 0; i < _runs.size(); i += FAN_IN)
+                {
+                    std::vector<std::filesystem::path> group(_runs.begin() + i,
+                                                             _runs.begin() + std::min(i + FAN_IN, _runs.size()));
+                    if (group.size() == 1)
+                    {
+                        merged.push_back(group.front());
+                        continue;
+                    }
+                    merged.push_back(_file("run"));
+                    writer_t out(merged.back());
+                    _merge(group, [&out](const unsigned char* rec) { out.write(rec); });
+                    out.close();
+                    for (auto& r : group)
+                        std::filesystem::remove(r, ec);
+                }
+                _runs.swap(merged);
+            }
+        }
+
+        size_t DiskStateSet::nextLayer()
+        {
+            _flush();
+            _compact();
+            _reader.reset();
+            std::error_code ec;
+            if (!_layer.empty())
+                std::filesystem::remove(_layer, ec);
+
+            std::unique_ptr<reader_t> visited;
+            if (!_visited.empty())
+                visited = std::make_unique<reader_t>(_visited);
+
+            auto nvisited = _file("visited");
+            auto nlayer = _file("layer");
+            writer_t vout(nvisited);
+            writer_t lout(nlayer);
+
+            // merge of the runs, checking each distinct marking against the visited ones
+            size_t fresh = 0;
+            _merge(_runs, [&](const unsigned char* rec) {
+                while (visited && visited->valid() && compare(visited->record(), rec) < 0)
+                {
+                    vout.write(visited->record());
+                    visited->next();
+                }
+                if (!visited || !visited->valid() || compare(visited->record(), rec) != 0)
+                {
+                    vout.write(rec);
+                    lout.write(rec);
+                    ++fresh;
+                }
+            });
+            while (visited && visited->valid())
+            {
+                vout.write(visited->record());
+                visited->next();
+            }
+            vout.close();
+            lout.close();
+
+            visited.reset();
+            for (auto& r : _runs)
+                std::filesystem::remove(r, ec);
+            _runs.clear();
+            if (!_visited.empty())
+                std::filesystem::remove(_visited, ec);
+
+            _visited = nvisited;
+            _layer = nlayer;
+            _stored += fresh;
+            _reader = std::make_unique<reader_t>(_layer);
+            return fresh;
+        }
+
+        bool DiskStateSet::next(State& state)
+        {
+            if (!_reader || !_reader->valid())
+                return false;
+            auto* rec = _reader->record();
+            std::memcpy(_encoder.scratchpad().raw(), rec + sizeof(uint16_t), recordSize(rec) - sizeof(uint16_t));
+            _encoder.decode(state.marking(), _encoder.scratchpad().raw());
+            _reader->next();
+
+            // update the max token bound for each place in the net (only for newly discovered markings)
+            for (uint32_t i = 0; i < _net.numberOfPlaces(); i++)
+            {
+                _maxPlaceBound[i] = std::max<MarkVal>(state.marking()[i], _maxPlaceBound[i]);
+            }
+            return true;
+        }
+    }
+}
@@ -32,7 +32,7 @@ namespace PetriEngine {
             if (_potencies.empty())
                 this->_initializePotencies(context->net()->numberOfTransitions(), 100);
 
-            uint32_t dist = query->distance(*context);
+            uint32_t dist = context->distance(query);
             _queues[_best].emplace(dist, id);
             _size++;
         }
@@ -73,7 +73,7 @@ namespace PetriEngine {
 
         void
         RandomPotencyQueue::push(size_t id, PQL::DistanceContext *context, const PQL::Condition *query, uint32_t t) {
-            uint32_t dist = query->distance(*context);
+            uint32_t dist = context->distance(query);
 
             if (dist < _currentParentDist) {
                 _potencies[t] += _currentParentDist - dist;
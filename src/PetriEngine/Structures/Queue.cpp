@@ -150,17 +150,14 @@ namespace PetriEngine {
         size_t HeuristicQueue::pop()
         {
             if(_queue.empty()) return EMPTY;
-            uint32_t n = _queue.top().item;
-            _queue.pop();
-            return n;
+            return _queue.pop().second;
         }
 
         void HeuristicQueue::push(size_t id, PQL::DistanceContext* context,
             const PQL::Condition* query)
         {
-            // invert result, highest numbers are on top!
-            uint32_t dist = query->distance(*context);
-            _queue.emplace(dist, (uint32_t)id);
+            uint32_t dist = context->distance(query);
+            _queue.push(dist, id);
         }
 
         bool HeuristicQueue::empty() const {
@@ -28,7 +28,7 @@ namespace PetriEngine {
         constructEnabled();
         if (_ordering.size() == 0) return false;
         if (_ordering.size() == 1) {
-            _stubborn[_ordering.front()] = true;
+            markStubborn(_ordering.front());
             return true;
         }
         assert(!_queries.empty());
@@ -64,7 +64,7 @@ namespace PetriEngine {
 
     void StubbornSet::presetOf(uint32_t place, bool make_closure) {
         if ((_places_seen[place] & PresetSeen) != 0) return;
-        _places_seen[place] = _places_seen[place] | PresetSeen;
+        markPlace(place, PresetSeen);
         for (uint32_t t = _places[place].pre; t < _places[place].post; t++) {
             const auto &tr = _arcs[t];
             addToStub(tr.index);
@@ -74,7 +74,7 @@ namespace PetriEngine {
 
     void StubbornSet::postsetOf(uint32_t place, bool make_closure) {
         if ((_places_seen[place] & PostsetSeen) != 0) return;
-        _places_seen[place] = _places_seen[place] | PostsetSeen;
+        markPlace(place, PostsetSeen);
         for (uint32_t t = _places[place].post; t < _places[place + 1].pre; t++) {
             const auto& tr = _arcs[t];
             if (tr.direction < 0)
@@ -85,7 +85,7 @@ namespace PetriEngine {
 
     void StubbornSet::inhibitorPostsetOf(uint32_t place) {
         if ((_places_seen[place] & InhibPostsetSeen) != 0) return;
-        _places_seen[place] = _places_seen[place] | InhibPostsetSeen;
+        markPlace(place, InhibPostsetSeen);
         for (uint32_t &newstub : _inhibpost[place])
             addToStub(newstub);
     }
@@ -198,6 +198,7 @@ namespace PetriEngine {
     void StubbornSet::addToStub(uint32_t t) {
         if (!_stubborn[t]) {
             _stubborn[t] = true;
+            _touched_stubborn.push_back(t);
             _unprocessed.push_back(t);
         }
     }
@@ -220,10 +221,33 @@ namespace PetriEngine {
         return tLeast;
     }
 
+    void StubbornSet::clearTransitions() {
+        if (_sparse_reset) {
+            for (auto t : _touched_enabled)
+                _enabled[t] = false;
+        } else {
+            std::fill(_enabled.get(), _enabled.get() + _net.numberOfTransitions(), false);
+        }
+        if (_sparse_reset && !_all_stubborn) {
+            for (auto t : _touched_stubborn)
+                _stubborn[t] = false;
+        } else {
+            std::fill(_stubborn.get(), _stubborn.get() + _net.numberOfTransitions(), false);
+        }
+        _touched_enabled.clear();
+        _touched_stubborn.clear();
+        _all_stubborn = false;
+    }
+
     void StubbornSet::reset() {
-        std::fill(_enabled.get(), _enabled.get() + _net.numberOfTransitions(), false);
-        std::fill(_stubborn.get(), _stubborn.get() + _net.numberOfTransitions(), false);
-        std::fill(_places_seen.get(), _places_seen.get() + _net.numberOfPlaces(), 0);
+        clearTransitions();
+        if (_sparse_reset) {
+            for (auto p : _touched_places)
+                _places_seen[p] = 0;
+        } else {
+            std::fill(_places_seen.get(), _places_seen.get() + _net.numberOfPlaces(), 0);
+        }
+        _touched_places.clear();
         _ordering.clear();
         _nenabled = 0;
         //_tid = 0;
@@ -12,6 +12,7 @@
  */
 
 #include "PetriEngine/SuccessorGenerator.h"
+#include "PetriEngine/ArcKernels.h"
 #include "PetriEngine/Structures/State.h"
 #include "utils/errors.h"
 
@@ -36,59 +37,119 @@ namespace PetriEngine {
         _parent = state;
         _suc_pcounter = pcounter;
         _suc_tcounter = tcounter;
+        if (_incremental) {
+            _updateEnabled();
+        }
         return true;
     }
 
+    void SuccessorGenerator::setIncremental(bool incremental) {
+        _incremental = incremental;
+        _expanding = _slot = NONE;
+        _carried.clear();
+        _free.clear();
+        _carriedSize = 0;
+        _children.clear();
+    }
+
+    void SuccessorGenerator::stored(size_t id) {
+        if (!_incremental || !_net.affectedIndex()) return;
+        if (_slot == NONE) {
+            if (_carriedSize + _enabled.size() > CARRY_LIMIT || _children.size() >= CHILD_LIMIT)
+                return;
+            if (_free.empty()) {
+                _slot = _carried.size();
+                _carried.emplace_back();
+            } else {
+                _slot = _free.back();
+                _free.pop_back();
+            }
+            _carried[_slot].enabled = _enabled;
+            _carriedSize += _enabled.size();
+        }
+        ++_carried[_slot].children;
+        _children.emplace(id, std::make_pair(_slot, fired()));
+    }
+
+    void SuccessorGenerator::_updateEnabled() {
+        _cursor = 0;
+        _slot = NONE;
+        auto it = _expanding == NONE ? _children.end() : _children.find(_expanding);
+        _expanding = NONE;
+        _enabled.clear();
+        if (it == _children.end()) {
+            const MarkVal* marking = _parent->marking();
+            for (uint32_t p = 0; p < _net._nplaces; ++p) {
+                // orphans are under "place 0"
+                if (p != 0 && marking[p] == 0) continue;
+                for (uint32_t t = _net._placeToPtrs[p]; t < _net._placeToPtrs[p + 1]; ++t) {
+                    if (checkPreset(t)) _enabled.push_back(t);
+                }
+            }
+            return;
+        }
+
+        auto [slot, transition] = it->second;
+        _children.erase(it);
+        auto& parent = _carried[slot];
+        // only the transitions affected by transition may have changed, both lists are ascending
+        const uint32_t* a = _net._affected.data() + _net._affectedPtrs[transition];
+        const uint32_t* last = _net._affected.data() + _net._affectedPtrs[transition + 1];
+        for (uint32_t t : parent.enabled) {
+            for (; a != last && *a < t; ++a) {
+                if (checkPreset(*a)) _enabled.push_back(*a);
+            }
+            if (a != last && *a == t) {
+                ++a;
+                if (!checkPreset(t)) continue;
+            }
+            _enabled.push_back(t);
+        }
+        for (; a != last; ++a) {
+            if (checkPreset(*a)) _enabled.push_back(*a);
+        }
+        if (--parent.children == 0) {
+            _carriedSize -= parent.enabled.size();
+            parent.enabled.clear();
+            _free.push_back(slot);
+        }
+    }
+
     void SuccessorGenerator::reset() {
         _suc_pcounter = 0;
         _suc_tcounter = std::numeric_limits<uint32_t>::max();
     }
 
     void SuccessorGenerator::consumePreset(Structures::State& write, uint32_t t) {
-
-        const TransPtr& ptr = _net._transitions[t];
-        uint32_t finv = ptr.inputs;
-        uint32_t linv = ptr.outputs;
-        for (; finv < linv; ++finv) {
-            if(!_net._invariants[finv].inhibitor) {
-                assert(write.marking()[_net._invariants[finv].place] >= _net._invariants[finv].tokens);
-                write.marking()[_net._invariants[finv].place] -= _net._invariants[finv].tokens;
-            }
+        auto* marking = write.marking();
+        for (uint32_t i = _net._prePtrs[t]; i < _net._prePtrs[t + 1]; ++i) {
+            assert(marking[_net._prePlaces[i]] >= _net._preTokens[i]);
+            marking[_net._prePlaces[i]] -= _net._preTokens[i];
         }
     }
 
     bool SuccessorGenerator::checkPreset(uint32_t t) {
-        const TransPtr& ptr = _net._transitions[t];
-        uint32_t finv = ptr.inputs;
-        uint32_t linv = ptr.outputs;
-
-        for (; finv < linv; ++finv) {
-            const Invariant& inv = _net._invariants[finv];
-            if ((*_parent).marking()[inv.place] < inv.tokens) {
-                if (!inv.inhibitor) {
-                    return false;
-                }
-            } else {
-                if (inv.inhibitor) {
-                    return false;
-                }
-            }
+        const MarkVal* marking = (*_parent).marking();
+        const uint32_t first = _net._prePtrs[t];
+        if (!ArcKernels::covers(marking, _net._prePlaces.data() + first, _net._preTokens.data() + first,
+                                _net._prePtrs[t + 1] - first))
+            return false;
+        for (uint32_t i = _net._inhibPtrs[t]; i < _net._inhibPtrs[t + 1]; ++i) {
+            if (marking[_net._inhibPlaces[i]] >= _net._inhibTokens[i])
+                return false;
         }
         return true;
     }
 
     void SuccessorGenerator::producePostset(Structures::State& write, uint32_t t) {
-        const TransPtr& ptr = _net._transitions[t];
-        uint32_t finv = ptr.outputs;
-        uint32_t linv = _net._transitions[t + 1].inputs;
-
-        for (; finv < linv; ++finv) {
-            size_t n = write.marking()[_net._invariants[finv].place];
-            n += _net._invariants[finv].tokens;
+        auto* marking = write.marking();
+        for (uint32_t i = _net._postPtrs[t]; i < _net._postPtrs[t + 1]; ++i) {
+            size_t n = marking[_net._postPlaces[i]];
+            n += _net._postTokens[i];
             if (n >= std::numeric_limits<uint32_t>::max()) {
                 throw base_error("Exceeded 2**32 limit of tokens in a single place (", n, ")");
             }
-            write.marking()[_net._invariants[finv].place] = n;
+            marking[_net._postPlaces[i]] = n;
         }
     }
 
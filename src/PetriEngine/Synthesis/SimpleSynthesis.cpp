@@ -46,15 +46,11 @@ namespace PetriEngine {
         _stateset(_net, 0), _query(query), _result(&query) {
 
         }
-#ifndef NDEBUG
-        std::vector<MarkVal*> markings;
-#endif
-
         SimpleSynthesis::~SimpleSynthesis() {
 #ifndef NDEBUG
-            for(auto& mark : markings)
+            for(auto& mark : _markings)
                 delete[] mark;
-            markings.clear();
+            _markings.clear();
 #endif
         }
 
@@ -218,8 +214,8 @@ namespace PetriEngine {
                 ++_result.numberOfConfigurations;
                 ++_result.numberOfMarkings;
 #ifndef NDEBUG
-                markings.push_back(new MarkVal[_net.numberOfPlaces()]);
-                memcpy(markings.back(), state.marking(), sizeof (MarkVal) * _net.numberOfPlaces());
+                _markings.push_back(new MarkVal[_net.numberOfPlaces()]);
+                memcpy(_markings.back(), state.marking(), sizeof (MarkVal) * _net.numberOfPlaces());
 #endif
                 meta = {SynthConfig::UNKNOWN, false, 0, 0, SynthConfig::depends_t(), res.second};
                 if (!check_bound(state.marking())) {
@@ -243,7 +239,7 @@ namespace PetriEngine {
 
         void SimpleSynthesis::print_id(size_t id) {
             std::cerr << "[" << id << "] : ";
-            Structures::State s(markings[id]);
+            Structures::State s(_markings[id]);
             s.print(_net, std::cerr);
             s.release();
         }
@@ -255,7 +251,7 @@ namespace PetriEngine {
 
         void SimpleSynthesis::validate(PQL::Condition* query, Structures::AnnotatedStateSet<SynthConfig>& stateset, bool is_safety) {
             Structures::State working(new MarkVal[_net.numberOfPlaces()]);
-            size_t old = markings.size();
+            size_t old = _markings.size();
             for (size_t id = 0; id < old; ++id) {
                 std::cerr << "VALIDATION " << id << std::endl;
                 auto& conf = stateset.get_data(id);
@@ -264,7 +260,7 @@ namespace PetriEngine {
                     conf._state != SynthConfig::MAYBE &&
                     conf._state != SynthConfig::PROCESSED)
                     continue;
-                PQL::EvaluationContext ctx(markings[id], &_net);
+                PQL::EvaluationContext ctx(_markings[id], &_net);
                 auto res = PetriEngine::PQL::evaluate(query, ctx);
                 if (conf._state != SynthConfig::WINNING)
                     assert((res != PQL::Condition::RTRUE) == is_safety);
@@ -273,7 +269,7 @@ namespace PetriEngine {
                     continue;
                 }
                 GameSuccessorGenerator generator(_net);
-                Structures::State s(markings[id]);
+                Structures::State s(_markings[id]);
                 generator.prepare(&s);
                 bool ok = false;
                 std::vector<size_t> env_maybe;
@@ -603,6 +599,8 @@ namespace PetriEngine {
             queue->push(cid, nullptr, nullptr);
 
             while (!meta.determined() || permissive) {
+                if (_stop != nullptr && *_stop)
+                    break;
                 while (!back.empty()) {
                     SynthConfig* next = back.top();
                     back.pop();
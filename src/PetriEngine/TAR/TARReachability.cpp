@@ -120,6 +120,8 @@ namespace PetriEngine {
             }
             while (!waiting.empty())
             {
+                if(stopped())
+                    return std::make_pair(true, false);
                 if(popDone(waiting, _stepno))
                     continue;  // we have reached the end of the edge-iterator for this part of the trace
 
@@ -253,6 +255,7 @@ namespace PetriEngine {
                 {
                     if(!satisfied)
                     {
+                        if(stopped()) return false;
                         if(update_use(false)) continue;
 #ifdef VERBOSETAR
                         for(size_t t = 0; t < _net.numberOfTransitions(); ++t)
@@ -483,6 +486,8 @@ namespace PetriEngine {
                     }
                     Solver solver(_net, state.marking(), queries[i].get(), used);
                     bool res = tryReach(printtrace, solver);
+                    if(stopped())
+                        break;
                     if(res)
                         results[i] = ResultPrinter::Satisfied;
                     else
@@ -20,6 +20,20 @@ std::vector<std::string> explode(std::string const & s) {
     return result;
 }
 
+const char* to_string(PortfolioEngine engine) {
+    switch (engine) {
+        case PortfolioEngine::HEUR:       return "BestFS";
+        case PortfolioEngine::BFS:        return "BFS";
+        case PortfolioEngine::DFS:        return "DFS";
+        case PortfolioEngine::RDFS:       return "RDFS";
+        case PortfolioEngine::RPFS:       return "RPFS";
+        case PortfolioEngine::RandomWalk: return "RandomWalk";
+        case PortfolioEngine::TAR:        return "TAR";
+        case PortfolioEngine::SiphonTrap: return "SiphonTrap";
+        case PortfolioEngine::LP:         return "LP";
+    }
+    return "";
+}
 
 void options_t::print(std::ostream& optionsOut) {
     if (printstatistics != StatisticsLevel::Full) {
@@ -64,6 +78,28 @@ void options_t::print(std::ostream& optionsOut) {
         optionsOut << ",State_Space_Exploration=DISABLED";
     }
 
+    if (statespacecache) {
+        optionsOut << ",State_Space_Cache=ENABLED";
+    }
+
+    if (statestorage == StateStorage::HashCompaction) {
+        optionsOut << ",State_Storage=HASH_COMPACTION";
+    } else if (statestorage == StateStorage::Bitstate) {
+        optionsOut << ",State_Storage=BITSTATE(" << bitstateBits << ")";
+    } else if (statestorage == StateStorage::Disk) {
+        optionsOut << ",State_Storage=DISK";
+    }
+
+    if (maxMemory > 0) {
+        optionsOut << ",Max_Memory=" << maxMemory;
+    }
+
+    if (!portfolio.empty()) {
+        optionsOut << ",Portfolio=";
+        for (size_t i = 0; i < portfolio.size(); ++i)
+            optionsOut << (i == 0 ? "" : "+") << to_string(portfolio[i]);
+    }
+
     if (enablecolreduction == 0) {
         optionsOut << ",Colored_Structural_Reduction=DISABLED";
     } else if (enablecolreduction == 1) {
@@ -110,6 +146,10 @@ void options_t::print(std::ostream& optionsOut) {
 
     optionsOut << ",LPSolve_Timeout=" << lpsolveTimeout;
 
+    if (queryTimeout > 0) {
+        optionsOut << ",Query_Timeout=" << queryTimeout;
+    }
+
 
     if (usedctl) {
         if (ctlalgorithm == CTL::CZero) {
@@ -166,7 +206,29 @@ void printHelp() {
         "                                       Only relevant for RPFS and RandomWalk strategies\n"
         "                                       write --init-potency-timeout 0 to disable the initialization\n"
         "  --seed-offset <number>               Extra noise to add to the seed of the random number generation\n"
+        "  --portfolio <engines>                Race a comma-separated list of engines on the reachability queries,\n"
+        "                                       one thread each, and report the first answer to each query.\n"
+        "                                       Engines are the strategies of --search-strategy (except OverApprox),\n"
+        "                                       TAR, SiphonTrap (deadlock queries only) and LP (the state equation,\n"
+        "                                       which can only prove queries unreachable), eg BestFS,RDFS,TAR,LP\n"
         "  -e, --state-space-exploration        State-space exploration only (query-file is irrelevant)\n"
+        "  --state-space-cache                  Explore the full state space once and answer all reachability queries\n"
+        "                                       and CTL subformulas from it, instead of searching anew for each.\n"
+        "                                       Stops on-the-fly searches from terminating early.\n"
+        "  --state-storage <storage>            How the reachability search stores visited markings:\n"
+        "                                       - exact            Store every marking (default)\n"
+        "                                       - hash-compaction  Store a 64-bit fingerprint of every marking\n"
+        "                                       - bitstate         Set a few bits of a fixed table per marking\n"
+        "                                       - disk             Keep visited markings and the frontier in files,\n"
+        "                                                          always searching breadth first\n"
+        "                                       hash-compaction and bitstate may skip states, so properties that are\n"
+        "                                       not found to be reachable are reported as unknown.\n"
+        "  --bitstate-size <bits>               Log2 of the number of bits in the bitstate table (default 30)\n"
+        "  --disk-directory <dir>               Directory for the files of disk storage (default system temporary)\n"
+        "  --disk-buffer <MB>                   Memory for successors before they are sorted to disk (default 1024)\n"
+        "  --max-memory <MB>                    Memory budget of the engines (default no limit). When it is reached,\n"
+        "                                       the reachability search drops its trace and continues with hash\n"
+        "                                       compaction; searches that cannot degrade further answer unknown.\n"
         "  -x, --xml-queries <query index>      Parse XML query file and verify queries of a given comma-seperated list\n"
         "  -r, --reduction <type>               Change structural net reduction:\n"
         "                                       - 0  disabled\n"
@@ -228,9 +290,18 @@ void printHelp() {
         "  --disable-cfp                        Disable the computation of possible colors in the Petri Net (CPN only)\n"
         "  --disable-partitioning               Disable the partitioning of colors in the Petri Net (CPN only)\n"
         "  --disable-symmetry-vars              Disable search for symmetric variables (CPN only)\n"
-#ifdef VERIFYPN_MC_Simplification
-        "  -z, --cores <number of cores>        Number of cores to use (currently only query simplification)\n"
-#endif
+        "  -z, --cores <number of cores>        Number of cores to use for query simplification, reachability search,\n"
+        "                                       LTL and CTL model checking.\n"
+        "                                       The parallel reachability search does not produce traces, and is only\n"
+        "                                       used together with -p as it does not support stubborn sets.\n"
+        "                                       RandomWalk runs one walker per core with -p, sharing the learned potencies.\n"
+        "                                       LTL runs a swarm of randomised searches, only the first uses stubborn sets.\n"
+        "                                       Independent CTL, LTL and synthesis queries are solved concurrently.\n"
+        "                                       The parallel CTL engine (czero) is likewise only used together with -p.\n"
+        "                                       Colored nets are unfolded in parallel.\n"
+        "                                       Cores not needed for other queries check the LPs of a query in parallel.\n"
+        "                                       Query simplification is only parallel in builds with VERIFYPN_MC_Simplification.\n"
+        "  --query-timeout <timeout>            Time budget in seconds for each CTL or LTL query (default 0, no limit)\n"
         "  -tar, --trace-abstraction            Enables Trace Abstraction Refinement for reachability properties\n"
         "  --max-intervals <interval count>     The max amount of intervals kept when computing the color fixpoint\n"
         "                  <interval count>     Default is 250 and then after <interval-timeout> second(s) to 5\n"
@@ -376,6 +447,79 @@ bool options_t::parse(int argc, const char** argv) {
         } else if (std::strcmp(argv[i], "-e") == 0 || std::strcmp(argv[i], "--state-space-exploration") == 0) {
             statespaceexploration = true;
             computePartition = false;
+        } else if (std::strcmp(argv[i], "--state-space-cache") == 0) {
+            statespacecache = true;
+        } else if (std::strcmp(argv[i], "--state-storage") == 0) {
+            if (i == argc - 1) {
+                throw base_error("Missing state storage after ", std::quoted(argv[i]));
+            }
+            const char* s = argv[++i];
+            if (std::strcmp(s, "exact") == 0)
+                statestorage = StateStorage::Exact;
+            else if (std::strcmp(s, "hash-compaction") == 0)
+                statestorage = StateStorage::HashCompaction;
+            else if (std::strcmp(s, "bitstate") == 0)
+                statestorage = StateStorage::Bitstate;
+            else if (std::strcmp(s, "disk") == 0)
+                statestorage = StateStorage::Disk;
+            else
+                throw base_error("Argument Error: Unrecognized state storage ", std::quoted(s));
+        } else if (std::strcmp(argv[i], "--bitstate-size") == 0) {
+            if (i == argc - 1) {
+                throw base_error("Missing number after ", std::quoted(argv[i]));
+            }
+            if (sscanf(argv[++i], "%u", &bitstateBits) != 1 || bitstateBits < 6 || bitstateBits > 40) {
+                throw base_error("Argument Error: Invalid bitstate size ", std::quoted(argv[i]), ", expected 6 to 40");
+            }
+        } else if (std::strcmp(argv[i], "--disk-directory") == 0) {
+            if (i == argc - 1) {
+                throw base_error("Missing directory after ", std::quoted(argv[i]));
+            }
+            diskDirectory = argv[++i];
+        } else if (std::strcmp(argv[i], "--disk-buffer") == 0) {
+            if (i == argc - 1) {
+                throw base_error("Missing number after ", std::quoted(argv[i]));
+            }
+            if (sscanf(argv[++i], "%u", &diskBuffer) != 1 || diskBuffer == 0) {
+                throw base_error("Argument Error: Invalid disk buffer size ", std::quoted(argv[i]));
+            }
+        } else if (std::strcmp(argv[i], "--max-memory") == 0) {
+            if (i == argc - 1) {
+                throw base_error("Missing number after ", std::quoted(argv[i]));
+            }
+            if (sscanf(argv[++i], "%u", &maxMemory) != 1) {
+                throw base_error("Argument Error: Invalid memory budget ", std::quoted(argv[i]));
+            }
+        } else if (std::strcmp(argv[i], "--portfolio") == 0) {
+            if (i == argc - 1) {
+                throw base_error("Missing engines after ", std::quoted(argv[i]));
+            }
+            portfolio.clear();
+            for (auto& name : explode(argv[++i])) {
+                if (name == "BestFS")
+                    portfolio.push_back(PortfolioEngine::HEUR);
+                else if (name == "BFS")
+                    portfolio.push_back(PortfolioEngine::BFS);
+                else if (name == "DFS")
+                    portfolio.push_back(PortfolioEngine::DFS);
+                else if (name == "RDFS")
+                    portfolio.push_back(PortfolioEngine::RDFS);
+                else if (name == "RPFS")
+                    portfolio.push_back(PortfolioEngine::RPFS);
+                else if (name == "RandomWalk")
+                    portfolio.push_back(PortfolioEngine::RandomWalk);
+                else if (name == "TAR")
+                    portfolio.push_back(PortfolioEngine::TAR);
+                else if (name == "SiphonTrap")
+                    portfolio.push_back(PortfolioEngine::SiphonTrap);
+                else if (name == "LP")
+                    portfolio.push_back(PortfolioEngine::LP);
+                else
+                    throw base_error("Argument Error: Unrecognized portfolio engine ", std::quoted(name));
+            }
+            if (portfolio.empty()) {
+                throw base_error("Argument Error: No engines given to ", std::quoted(argv[i - 1]));
+            }
         } else if (std::strcmp(argv[i], "-n") == 0 || std::strcmp(argv[i], "--no-statistics") == 0) {
             if (argc > i + 1) {
                 if (strcmp("1", argv[i+1]) == 0) {
@@ -573,16 +717,22 @@ bool options_t::parse(int argc, const char** argv) {
             }
             ++i;
         }
-#ifdef VERIFYPN_MC_Simplification
-        else if (std::strcmp(argv[i], "-z") == 0) {
+        else if (std::strcmp(argv[i], "-z") == 0 || std::strcmp(argv[i], "--cores") == 0) {
             if (i == argc - 1) {
                 throw base_error("Missing number after ", std::quoted(argv[i]));
             }
-            if (sscanf(argv[++i], "%u", &cores) != 1) {
+            if (sscanf(argv[++i], "%u", &cores) != 1 || cores == 0) {
                 throw base_error("Argument Error: Invalid cores count ", std::quoted(argv[i]));
             }
         }
-#endif
+        else if (std::strcmp(argv[i], "--query-timeout") == 0) {
+            if (i == argc - 1) {
+                throw base_error("Missing number after ", std::quoted(argv[i]));
+            }
+            if (sscanf(argv[++i], "%u", &queryTimeout) != 1) {
+                throw base_error("Argument Error: Invalid query timeout ", std::quoted(argv[i]));
+            }
+        }
         else if (std::strcmp(argv[i], "--keep-solved") == 0)
         {
             keep_solved = true;
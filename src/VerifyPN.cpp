@@ -128,13 +128,11 @@ bool reduceColored(ColoredPetriNetBuilder &cpnBuilder, std::vector<std::shared_p
     return anyReduction;
 }
 
-std::tuple<PetriNetBuilder, shared_name_name_map, shared_place_color_map>
-unfold(ColoredPetriNetBuilder& cpnBuilder, bool compute_partiton, bool compute_symmetry, bool computed_fixed_point,
-    std::ostream& out, int32_t partitionTimeout, int32_t max_intervals, int32_t intervals_reduced, int32_t interval_timeout, bool over_approx, bool print_bindings) {
+// computes what the unfolder relies on, and calls f with the unfolder, the partition and the fixed point
+template<typename F>
+static auto withUnfolder(ColoredPetriNetBuilder& cpnBuilder, bool compute_partiton, bool compute_symmetry, bool computed_fixed_point,
+    int32_t partitionTimeout, int32_t max_intervals, int32_t intervals_reduced, int32_t interval_timeout, bool over_approx, bool print_bindings, F&& f) {
     Colored::PartitionBuilder partition(cpnBuilder.transitions(), cpnBuilder.places());
-
-    if(!cpnBuilder.isColored())
-        return {cpnBuilder.pt_builder(), {}, {}};
     if (compute_partiton && !over_approx) {
         partition.compute(partitionTimeout);
     }
@@ -150,42 +148,81 @@ unfold(ColoredPetriNetBuilder& cpnBuilder, bool compute_partiton, bool compute_s
     } else fixed_point.set_default();
 
     Colored::Unfolder unfolder(cpnBuilder, partition, symmetry, fixed_point, print_bindings);
-    if(over_approx)
-    {
-        auto r = unfolder.strip_colors();
-        return std::make_tuple<PetriNetBuilder, shared_name_name_map, shared_place_color_map>
-            (std::move(r),
-            shared_name_name_map{unfolder.transition_names()},
-            shared_place_color_map{unfolder.place_names()});
+    return f(unfolder, partition, fixed_point);
+}
+
+static void printUnfolding(std::ostream& out, const ColoredPetriNetBuilder& cpnBuilder, const Colored::Unfolder& unfolder,
+    const Colored::PartitionBuilder& partition, const Colored::ForwardFixedPoint& fixed_point,
+    bool compute_partiton, bool computed_fixed_point, size_t places, size_t transitions) {
+    if (computed_fixed_point) {
+        out << "\nColor fixpoint computed in " << fixed_point.time() << " seconds" << std::endl;
+        out << "Max intervals used: " << fixed_point.max_intervals() << std::endl;
     }
-    else
-    {
-        auto r = unfolder.unfold();
-        if (computed_fixed_point) {
-            out << "\nColor fixpoint computed in " << fixed_point.time() << " seconds" << std::endl;
-            out << "Max intervals used: " << fixed_point.max_intervals() << std::endl;
+
+    out << "Size of colored net: " <<
+        cpnBuilder.unskippedPlacesCount() << " places, " <<
+        cpnBuilder.unskippedTransitionsCount() << " transitions, and " <<
+        cpnBuilder.getArcCount() << " arcs" << std::endl;
+    out << "Size of unfolded net: " <<
+        places << " places, " <<
+        transitions << " transitions, and " <<
+        unfolder.number_of_arcs() << " arcs" << std::endl;
+    if (compute_partiton) {
+        out << "Partitioned in " << partition.time() << " seconds" << std::endl;
+    }
+    out << "Unfolded in " << unfolder.time() << " seconds\n" << std::endl;
+}
+
+std::tuple<PetriNetBuilder, shared_name_name_map, shared_place_color_map>
+unfold(ColoredPetriNetBuilder& cpnBuilder, bool compute_partiton, bool compute_symmetry, bool computed_fixed_point,
+    std::ostream& out, int32_t partitionTimeout, int32_t max_intervals, int32_t intervals_reduced, int32_t interval_timeout, bool over_approx, bool print_bindings, uint32_t threads) {
+    if(!cpnBuilder.isColored())
+        return {cpnBuilder.pt_builder(), {}, {}};
+
+    return withUnfolder(cpnBuilder, compute_partiton, compute_symmetry, computed_fixed_point, partitionTimeout,
+        max_intervals, intervals_reduced, interval_timeout, over_approx, print_bindings,
+        [&](Colored::Unfolder& unfolder, const Colored::PartitionBuilder& partition, const Colored::ForwardFixedPoint& fixed_point) {
+        if(over_approx)
+        {
+            auto r = unfolder.strip_colors();
+            return std::make_tuple<PetriNetBuilder, shared_name_name_map, shared_place_color_map>
+                (std::move(r),
+                shared_name_name_map{unfolder.transition_names()},
+                shared_place_color_map{unfolder.place_names()});
         }
+        else
+        {
+            auto r = unfolder.unfold(threads);
+            printUnfolding(out, cpnBuilder, unfolder, partition, fixed_point, compute_partiton, computed_fixed_point,
+                r.numberOfPlaces(), r.numberOfTransitions());
+
+            unfolder.printBinding();
 
-        out << "Size of colored net: " <<
-            cpnBuilder.unskippedPlacesCount() << " places, " <<
-            cpnBuilder.unskippedTransitionsCount() << " transitions, and " <<
-            cpnBuilder.getArcCount() << " arcs" << std::endl;
-        out << "Size of unfolded net: " <<
-            r.numberOfPlaces() << " places, " <<
-            r.numberOfTransitions() << " transitions, and " <<
-            unfolder.number_of_arcs() << " arcs" << std::endl;
-        if (compute_partiton) {
-            out << "Partitioned in " << partition.time() << " seconds" << std::endl;
+            return std::make_tuple<PetriNetBuilder, shared_name_name_map, shared_place_color_map>
+                (std::move(r),
+                shared_name_name_map{unfolder.transition_names()},
+                shared_place_color_map{unfolder.place_names()});
         }
-        out << "Unfolded in " << unfolder.time() << " seconds\n" << std::endl;
-        
+    });
+}
+
+void outputUnfoldedNet(ColoredPetriNetBuilder& cpnBuilder, bool compute_partiton, bool compute_symmetry, bool computed_fixed_point,
+    std::ostream& out, int32_t partitionTimeout, int32_t max_intervals, int32_t intervals_reduced, int32_t interval_timeout, bool print_bindings, uint32_t threads,
+    const std::string& out_file) {
+    assert(cpnBuilder.isColored());
+    withUnfolder(cpnBuilder, compute_partiton, compute_symmetry, computed_fixed_point, partitionTimeout,
+        max_intervals, intervals_reduced, interval_timeout, false, print_bindings,
+        [&](Colored::Unfolder& unfolder, const Colored::PartitionBuilder& partition, const Colored::ForwardFixedPoint& fixed_point) {
+        auto net = unfolder.unfoldNet(threads);
+        printUnfolding(out, cpnBuilder, unfolder, partition, fixed_point, compute_partiton, computed_fixed_point,
+            net->numberOfPlaces(), net->numberOfTransitions());
+
         unfolder.printBinding();
-        
-        return std::make_tuple<PetriNetBuilder, shared_name_name_map, shared_place_color_map>
-            (std::move(r),
-            shared_name_name_map{unfolder.transition_names()},
-            shared_place_color_map{unfolder.place_names()});
-    }
+
+        std::fstream file;
+        file.open(out_file, std::ios::out);
+        net->toXML(file);
+    });
 }
 
 ReturnValue contextAnalysis(bool colored, const shared_name_name_map& transition_names, const shared_place_color_map& place_names,
@@ -614,6 +651,8 @@ void simplify_queries(const MarkVal* marking,
                             std::cout << "WARNING: Initial marking contains a place or places with too many tokens. Query simplifaction is skipped.\n";
                             break;
                         } 
+                        // cores not busy with other queries solve the LPs of this one
+                        simplificationContext.setLPThreads(options.cores / std::min<uint32_t>(options.cores, old));
                         try {
                             negstat_t stats;
                             auto simp_cond = PetriEngine::PQL::simplify(queries[i], simplificationContext);
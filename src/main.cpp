@@ -48,8 +48,11 @@
 #include <PetriEngine/Colored/PnmlWriter.h>
 #include <PetriEngine/ExplicitColored/ExplicitErrors.h>
 #include <utils/NullStream.h>
+#include <utils/QueryScheduler.h>
+#include <utils/MemoryBudget.h>
 #include "VerifyPN.h"
 #include "PetriEngine/Synthesis/SimpleSynthesis.h"
+#include "PetriEngine/Portfolio.h"
 #include "LTL/LTLSearch.h"
 #include "PetriEngine/PQL/PQL.h"
 #include "PetriEngine/ExplicitColored/ExplicitColoredPetriNetBuilder.h"
@@ -76,6 +79,7 @@ int main(int argc, const char** argv) {
             std::cout << std::endl;
         }
         options.print();
+        MemoryBudget::set(size_t{options.maxMemory} << 20);
 
         //----------------------- Parse Query -----------------------//
         std::vector<std::string> querynames;
@@ -164,11 +168,21 @@ int main(int argc, const char** argv) {
             return 0;
         }
 
+        if (!options.doVerification && queries.empty() && !options.unfolded_out_file.empty() &&
+            cpnBuilder.isColored() && !options.cpnOverApprox) {
+            // only the unfolded net is asked for, it is written without building the PT builder
+            outputUnfoldedNet(cpnBuilder, options.computePartition, options.symmetricVariables,
+                options.computeCFP, out,
+                options.partitionTimeout, options.max_intervals, options.max_intervals_reduced,
+                options.intervalTimeout, options.print_bindings, options.cores, options.unfolded_out_file);
+            return to_underlying(ReturnValue::SuccessCode);
+        }
+
         auto [builder, transition_names, place_names] = unfold(cpnBuilder,
             options.computePartition, options.symmetricVariables,
             options.computeCFP, out,
             options.partitionTimeout, options.max_intervals, options.max_intervals_reduced,
-            options.intervalTimeout, options.cpnOverApprox, options.print_bindings);
+            options.intervalTimeout, options.cpnOverApprox, options.print_bindings, options.cores);
 
         builder.sort();
         std::vector<ResultPrinter::Result> results(queries.size(), ResultPrinter::Result::Unknown);
@@ -317,6 +331,13 @@ int main(int argc, const char** argv) {
 
         auto net = std::unique_ptr<PetriNet>(builder.makePetriNet());
 
+        // explored by the first query needing it, then shared by the rest
+        std::unique_ptr<StateSpaceCache> statespace_cache;
+        if (options.statespacecache) {
+            statespace_cache = std::make_unique<StateSpaceCache>(*net, options.kbound);
+            options.statespace_cache = statespace_cache.get();
+        }
+
         if (options.model_out_file.size() > 0) {
             std::fstream file;
             file.open(options.model_out_file, std::ios::out);
@@ -414,34 +435,59 @@ int main(int argc, const char** argv) {
             if (!ltl_ids.empty() && options.ltlalgorithm != LTL::Algorithm::None) {
                 options.usedltl = true;
 
+                // split the cores between the queries and the swarm of each query
+                const uint32_t swarm = std::max<uint32_t>(1, options.cores / ltl_ids.size());
+                QueryScheduler scheduler(options.cores, options.queryTimeout, std::cout, std::cerr);
                 for (auto qid : ltl_ids) {
-                    LTL::LTLSearch search(*net, queries[qid], options.buchiOptimization, options.ltl_compress_aps);
-                    auto res = search.solve(options.trace != TraceLevel::None, options.kbound,
-                        options.ltlalgorithm, options.stubbornreduction ? options.ltl_por : LTL::LTLPartialOrder::None,
-                        options.strategy, options.ltlHeuristic, options.ltluseweak, options.seed_offset);
-
-                    if(options.printstatistics != StatisticsLevel::None)
-                        search.print_stats(std::cout);
-
-                    std::cout << "FORMULA " << querynames[qid]
-                        << (res ? " TRUE" : " FALSE") << " TECHNIQUES EXPLICIT "
-                        << LTL::to_string(options.ltlalgorithm)
-                        << (search.is_weak() ? " WEAK_SKIP" : "")
-                        << (search.used_partial_order() != LTL::LTLPartialOrder::None ? " STUBBORN" : "")
-                        << (search.used_partial_order() == LTL::LTLPartialOrder::Visible ? " CLASSIC_STUB" : "")
-                        << (search.used_partial_order() == LTL::LTLPartialOrder::Automaton ? " AUT_STUB" : "")
-                        << (search.used_partial_order() == LTL::LTLPartialOrder::Liebke ? " LIEBKE_STUB" : "");
-                    auto heur = search.heuristic_type();
-                    if (!heur.empty())
-                        std::cout << " HEURISTIC " << heur;
-                    std::cout << " OPTIM-" << to_underlying(options.buchiOptimization) << std::endl;
-
-                    std::cout << "\nQuery index " << qid << " was solved\n";
-                    std::cout << "Query is " << (res ? "" : "NOT ") << "satisfied." << std::endl;
-
-                    if(options.trace != TraceLevel::None)
-                        search.print_trace(std::cerr, *builder.getReducer());
+                    scheduler.add([&, qid](std::ostream& out, std::ostream& err, const std::atomic<bool>& cancel) {
+                        LTL::LTLSearch search(*net, queries[qid], options.buchiOptimization, options.ltl_compress_aps);
+                        // building the automaton waits for the spot lock held by the other queries
+                        QueryScheduler::restart_budget();
+                        search.set_stop_flag(&cancel);
+                        auto res = search.solve(options.trace != TraceLevel::None, options.kbound,
+                            options.ltlalgorithm, options.stubbornreduction ? options.ltl_por : LTL::LTLPartialOrder::None,
+                            options.strategy, options.ltlHeuristic, options.ltluseweak, options.seed_offset, swarm);
+
+                        if (cancel) {
+                            out << "\nFORMULA " << querynames[qid] << " CANNOT_COMPUTE\n"
+                                << "Query index " << qid << " exceeded the time budget of " << options.queryTimeout << " seconds\n" << std::endl;
+                            return;
+                        }
+                        if (search.out_of_memory()) {
+                            out << "\nFORMULA " << querynames[qid] << " CANNOT_COMPUTE\n"
+                                << "Query index " << qid << " exceeded the memory budget of " << options.maxMemory << " MB\n";
+                            if(options.printstatistics != StatisticsLevel::None)
+                                search.print_stats(out);
+                            out << std::endl;
+                            // let the next queries run if the memory of this one made room
+                            MemoryBudget::refresh();
+                            return;
+                        }
+
+                        if(options.printstatistics != StatisticsLevel::None)
+                            search.print_stats(out);
+
+                        out << "FORMULA " << querynames[qid]
+                            << (res ? " TRUE" : " FALSE") << " TECHNIQUES EXPLICIT "
+                            << LTL::to_string(options.ltlalgorithm)
+                            << (search.is_weak() ? " WEAK_SKIP" : "")
+                            << (search.used_partial_order() != LTL::LTLPartialOrder::None ? " STUBBORN" : "")
+                            << (search.used_partial_order() == LTL::LTLPartialOrder::Visible ? " CLASSIC_STUB" : "")
+                            << (search.used_partial_order() == LTL::LTLPartialOrder::Automaton ? " AUT_STUB" : "")
+                            << (search.used_partial_order() == LTL::LTLPartialOrder::Liebke ? " LIEBKE_STUB" : "");
+                        auto heur = search.heuristic_type();
+                        if (!heur.empty())
+                            out << " HEURISTIC " << heur;
+                        out << " OPTIM-" << to_underlying(options.buchiOptimization) << std::endl;
+
+                        out << "\nQuery index " << qid << " was solved\n";
+                        out << "Query is " << (res ? "" : "NOT ") << "satisfied." << std::endl;
+
+                        if(options.trace != TraceLevel::None)
+                            search.print_trace(err, *builder.getReducer());
+                    });
                 }
+                scheduler.run();
 
                 if (std::find(results.begin(), results.end(), ResultPrinter::Unknown) == results.end()) {
                     return to_underlying(ReturnValue::SuccessCode);
@@ -449,29 +495,44 @@ int main(int argc, const char** argv) {
             }
 
 
-            for (auto i : synth_ids) {
-                if(options.tar) {
-                    throw base_error("TAR not supported for synthesis.");
-                }
-                Synthesis::SimpleSynthesis strategy(*net, *queries[i], options.kbound);
-
-                std::ostream *strategy_out = nullptr;
-
-                results[i] = strategy.synthesize(options.strategy, options.stubbornreduction, false);
+            if (!synth_ids.empty() && options.tar) {
+                throw base_error("TAR not supported for synthesis.");
+            }
+            {
+                // strategies are written to a single file, so only solve concurrently without one
+                QueryScheduler scheduler(options.strategy_output.empty() ? options.cores : 1,
+                                         options.queryTimeout, std::cout, std::cerr);
+                for (auto i : synth_ids) {
+                    scheduler.add([&, i](std::ostream& out, std::ostream&, const std::atomic<bool>& cancel) {
+                        Synthesis::SimpleSynthesis strategy(*net, *queries[i], options.kbound);
+                        strategy.set_stop_flag(&cancel);
+
+                        std::ostream *strategy_out = nullptr;
+
+                        auto res = strategy.synthesize(options.strategy, options.stubbornreduction, false);
+                        if (cancel) {
+                            out << "\nFORMULA " << querynames[i] << " CANNOT_COMPUTE\n"
+                                << "Query index " << i << " exceeded the time budget of " << options.queryTimeout << " seconds\n" << std::endl;
+                            return;
+                        }
+                        results[i] = res;
 
-                strategy.result().print(querynames[i], options.printstatistics, i, options, std::cout);
+                        strategy.result().print(querynames[i], options.printstatistics, i, options, out);
 
-                if (options.strategy_output == "-")
-                    strategy_out = &std::cout;
-                else if (options.strategy_output.size() > 0)
-                    strategy_out = new std::ofstream(options.strategy_output);
+                        if (options.strategy_output == "-")
+                            strategy_out = &out;
+                        else if (options.strategy_output.size() > 0)
+                            strategy_out = new std::ofstream(options.strategy_output);
 
-                if (strategy_out != nullptr)
-                    strategy.print_strategy(*strategy_out);
+                        if (strategy_out != nullptr)
+                            strategy.print_strategy(*strategy_out);
 
-                if (strategy_out != nullptr && strategy_out != &std::cout)
-                    delete strategy_out;
-                if (std::find(results.begin(), results.end(), ResultPrinter::Unknown) == results.end()) {
+                        if (strategy_out != nullptr && strategy_out != &out)
+                            delete strategy_out;
+                    });
+                }
+                scheduler.run();
+                if (!synth_ids.empty() && std::find(results.begin(), results.end(), ResultPrinter::Unknown) == results.end()) {
                     return to_underlying(ReturnValue::SuccessCode);
                 }
             }
@@ -484,7 +545,7 @@ int main(int argc, const char** argv) {
                     bool isDeadlockQuery = std::dynamic_pointer_cast<DeadlockCondition>(queries[i]) != nullptr;
 
                     if (results[i] == ResultPrinter::Unknown && isDeadlockQuery) {
-                        STSolver stSolver(printer, *net, queries[i].get(), options.siphonDepth);
+                        STSolver stSolver(printer, *net, queries[i].get(), options.siphonDepth, i);
                         stSolver.solve(options.siphontrapTimeout);
                         results[i] = stSolver.printResult();
                         if (results[i] != Reachability::ResultPrinter::Unknown && options.printstatistics == StatisticsLevel::Full) {
@@ -507,7 +568,20 @@ int main(int argc, const char** argv) {
                 if(results[i] == ResultPrinter::Unknown)
                     queries[i] = prepareForReachability(queries[i]);
             }
-            if (options.tar && net->numberOfPlaces() > 0) {
+            if (!options.portfolio.empty() && !options.statespaceexploration) {
+                std::vector<MarkVal> initialPotencies;
+                bool potencies = std::any_of(options.portfolio.begin(), options.portfolio.end(), [](auto engine) {
+                    return engine == PortfolioEngine::RPFS || engine == PortfolioEngine::RandomWalk;
+                });
+                if (options.initPotencyTimeout > 0 && potencies) {
+                    initialPotencies.resize(net->numberOfTransitions(), 0);
+                    std::unique_ptr<MarkVal[]> qm0(net->makeInitialMarking());
+                    initialize_potency(qm0.get(), net.get(), queries, options, std::cout, initialPotencies);
+                }
+
+                Portfolio portfolio(*net, printer, options, builder.getReducer());
+                portfolio.solve(queries, results, initialPotencies);
+            } else if (options.tar && net->numberOfPlaces() > 0) {
                 //Create reachability search strategy
                 TarResultPrinter tar_printer(printer);
                 TARReachabilitySearch strategy(tar_printer, *net, builder.getReducer(), options.kbound);
@@ -521,7 +595,10 @@ int main(int argc, const char** argv) {
                                    options.printstatistics,
                                    options.trace != TraceLevel::None);
             } else {
-                ReachabilitySearch strategy(*net, printer, options.kbound);
+                ReachabilitySearch strategy(*net, printer, options.kbound, false, options.cores);
+                strategy.setStateSpaceCache(options.statespace_cache);
+                strategy.setStateStorage(options.statestorage, options.bitstateBits);
+                strategy.setDiskStorage(options.diskDirectory, size_t{options.diskBuffer} << 20);
 
                 // Change default place-holder to default strategy
                 if (options.strategy == Strategy::DEFAULT) options.strategy = Strategy::HEUR;
@@ -570,7 +647,18 @@ int main(int argc, const char** argv) {
 int explicitColored(shared_string_set& stringSet, options_t& options, std::vector<Condition_ptr>& queries, const std::vector<std::string>& queryNames) {
     using namespace ExplicitColored;
 
-    if (!options.isCPN || queries.empty() || !isReachability(queries[0])) {
+    if (!options.isCPN || queries.empty()) {
+        std::cerr << "Explicit state-space search is supported only for colored nets and reachability queries.";
+        return to_underlying(ReturnValue::UnknownCode);
+    }
+
+    std::vector<Condition_ptr> reachability;
+    for (auto& query : queries) {
+        if (isReachability(query)) {
+            reachability.push_back(query);
+        }
+    }
+    if (reachability.empty()) {
         std::cerr << "Explicit state-space search is supported only for colored nets and reachability queries.";
         return to_underlying(ReturnValue::UnknownCode);
     }
@@ -581,16 +669,33 @@ int explicitColored(shared_string_set& stringSet, options_t& options, std::vecto
                 ? std::cout
                 : nullStream;
 
+        // the model is parsed and reduced once, the resulting nets are shared by all the queries
         ExplicitColoredModelChecker ecpnChecker(stringSet, fullStatisticsOut);
+        ecpnChecker.loadModel(options.modelfile, reachability, options);
+
+        std::vector<ExplicitColoredModelChecker::Result> results;
+        for (size_t i = 0; i < queries.size(); ++i) {
+            if (!isReachability(queries[i])) {
+                std::cerr << "Explicit state-space search is supported only for reachability queries, skipping "
+                          << queryNames[i] << std::endl;
+                results.push_back(ExplicitColoredModelChecker::Result::UNKNOWN);
+                continue;
+            }
+            ColoredResultPrinter resultPrinter(i, std::cout, queryNames[i], options.seed(), std::cerr);
+            results.push_back(ecpnChecker.checkQuery(queries[i], options, &resultPrinter));
+        }
 
-        ColoredResultPrinter resultPrinter(0, std::cout, queryNames[0], options.seed(), std::cerr);
-        auto result = ecpnChecker.checkQuery(options.modelfile, queries[0], options, &resultPrinter);
+        if (results.size() > 1) {
+            return std::find(results.begin(), results.end(), ExplicitColoredModelChecker::Result::UNKNOWN) == results.end()
+                ? to_underlying(ReturnValue::SuccessCode)
+                : to_underlying(ReturnValue::UnknownCode);
+        }
 
-        if (result == ExplicitColoredModelChecker::Result::SATISFIED) {
+        if (results[0] == ExplicitColoredModelChecker::Result::SATISFIED) {
             return to_underlying(ReturnValue::SuccessCode);
         }
 
-        if (result == ExplicitColoredModelChecker::Result::UNSATISFIED) {
+        if (results[0] == ExplicitColoredModelChecker::Result::UNSATISFIED) {
             return to_underlying(ReturnValue::FailedCode);
         }
 